@@ -0,0 +1,81 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <iostream>
+#include <map>
+
+// project includes
+#include "maze.hpp"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    const map<string, maze::grid::MazeKind> maze_kinds = {
+        {"backtracker", maze::grid::MazeKind::BACKTRACKER},
+        {"kruskal", maze::grid::MazeKind::KRUSKAL},
+        {"room", maze::grid::MazeKind::ROOM},
+        {"obstacles", maze::grid::MazeKind::OBSTACLES},
+        {"winding", maze::grid::MazeKind::WINDING}
+    };
+
+    if(argc < 3)
+    {
+        cerr << "Usage: " << argv[0] << " -o <map_file_path> <optional: -k> <optional: backtracker|kruskal|room|obstacles|winding> <optional: -r> <optional: rows> <optional: -c> <optional: cols> <optional: -s> <optional: seed>" << endl;
+        return 1;
+    }
+
+    string map_file = "";
+    string maze_kind = "backtracker";
+    int number_rows = 64;
+    int number_cols = 64;
+    uint64_t seed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag.compare(string("-o")) == 0 && i + 1 < argc) {
+            map_file = argv[i + 1];
+        } else if (flag.compare(string("-k")) == 0 && i + 1 < argc) {
+            maze_kind = argv[i + 1];
+        } else if (flag.compare(string("-r")) == 0 && i + 1 < argc) {
+            number_rows = stoi(argv[i + 1]);
+        } else if (flag.compare(string("-c")) == 0 && i + 1 < argc) {
+            number_cols = stoi(argv[i + 1]);
+        } else if (flag.compare(string("-s")) == 0 && i + 1 < argc) {
+            seed = stoull(argv[i + 1]);
+        }
+    }
+
+    if(maze_kinds.count(maze_kind) == 0)
+    {
+        cerr << "Unknown maze kind : " << maze_kind << endl;
+        return 1;
+    }
+
+    try
+    {
+        maze::grid::writeMap(map_file, maze::grid::generateMaze(maze_kinds.at(maze_kind), number_rows, number_cols, seed));
+        cout << "Maze written to " << map_file << endl;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -17,27 +17,68 @@
 // stl includes
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <csignal>
 
 // project includes
 #include "maze.hpp"
 
 using namespace std;
 
-void printPath(vector<pair<int, int>> const& path)
+// printPath function that writes a path in the given format
+void printPath(vector<pair<int, int>> const& path, const maze::grid::PathFormat& path_format)
 {
-    cout << "Path Start -> ";
-    for(auto const& p : path)
+    try
     {
-        cout << "(" << p.first << ", " << p.second << ")" << " -> ";
+        maze::grid::writePath(cout, path, path_format);
+    }
+    catch(const invalid_argument& e)
+    {
+        cerr << e.what() << endl;
+    }
+}
+
+// printPath function that writes a packed path in the given format
+void printPath(maze::grid::PackedPath const& path, const maze::grid::PathFormat& path_format)
+{
+    maze::grid::writePath(cout, path, path_format);
+}
+
+// printUsage function that writes the command line options to stderr
+void printUsage(const char* program_name)
+{
+    cerr << "Usage: " << program_name << " -m <map_file_path> <optional: -u> <optional: user story number> <optional: -z> <optional: -c> <optional: binary map output path> <optional: -s> <optional: -a> <optional: astar|jps|bibfs|biastar|hpa|dijkstra|corridor|parallel> <optional: -n> <optional: 4|8|8c> <optional: --heuristic> <optional: octile|manhattan|zero> <optional: -j> <optional: threads> <optional: -o> <optional: text|rle|json|binary> <optional: --stats>" << endl;
+    cerr << "       -s streams user stories 1, 2 and 4 through a window of 1024 rows; the winding path of user story 4 must start on the first row or column or within the last 1024 rows" << endl;
+    cerr << "       " << program_name << " -m <map_file_path> -i <optional: -z> <optional: -s>" << endl;
+    cerr << "       " << program_name << " -m <map_file_path> -r <optional: -z> <optional: -s>" << endl;
+    cerr << "       " << program_name << " -m <map_file_path> -q <query_file_path> <optional: -j> <optional: threads> <optional: -z> <optional: -s> <optional: -a> <optional: astar|jps|bibfs|biastar|hpa|dijkstra|corridor|parallel> <optional: -n> <optional: 4|8|8c> <optional: --heuristic> <optional: octile|manhattan|zero> <optional: -o> <optional: text|rle|json|binary>" << endl;
+    cerr << "       " << program_name << " --serve <socket_path> <optional: --cache> <optional: number of maps> <optional: -j> <optional: threads> <optional: -z> <optional: -a> <optional: astar|jps|bibfs|biastar|hpa|dijkstra|corridor|parallel> <optional: -n> <optional: 4|8|8c> <optional: --heuristic> <optional: octile|manhattan|zero> <optional: -o> <optional: text|rle|json|binary>" << endl;
+    cerr << "       " << program_name << " -b <map_directory|glob|manifest_file> <optional: -u> <optional: user story number> <optional: -j> <optional: threads> <optional: -f> <optional: jsonl|csv> <optional: -z> <optional: -a> <optional: astar|jps|bibfs|biastar|hpa|dijkstra|corridor|parallel> <optional: -n> <optional: 4|8|8c> <optional: --heuristic> <optional: octile|manhattan|zero>" << endl;
+}
+
+// parseNumber function that reads a whole argument as a number, returns
+// false if the argument is not a number
+bool parseNumber(const char* argument, int& number)
+{
+    try
+    {
+        size_t number_size = 0;
+        number = stoi(argument, &number_size);
+        return argument[number_size] == '\0';
+    }
+    catch(const exception&)
+    {
+        return false;
     }
-    cout << "End" << endl;
 }
 
 int main(int argc, char** argv) 
 {
     if(argc < 2)
     {
-        cerr << "Usage: " << argv[0] << " -m <map_file_path> <optional: -u> <optional: user story number>" << endl;
+        printUsage(argv[0]);
         return 1;
     }
     else
@@ -45,28 +86,395 @@ int main(int argc, char** argv)
         int user_story_id = 5;
         int col_index = -1;
         string map_file = "";
+        string binary_map_file = "";
+        bool is_streaming = false;
+        bool print_components = false;
+        bool print_regions = false;
+        bool print_stats = false;
+        maze::grid::SearchAlgorithm search_algorithm = maze::grid::SearchAlgorithm::ASTAR;
+        maze::grid::Connectivity connectivity = maze::grid::Connectivity::FOUR;
+        maze::grid::SearchHeuristic heuristic = maze::grid::SearchHeuristic::OCTILE;
+        string batch_source = "";
+        string query_file = "";
+        string socket_path = "";
+        int cache_capacity = 64;
+        int number_threads = 0;
+        maze::grid::BatchFormat batch_format = maze::grid::BatchFormat::JSONL;
+        maze::grid::PathFormat path_format = maze::grid::PathFormat::TEXT;
+        maze::grid::MapLoadMode load_mode = maze::grid::MapLoadMode::COPY;
 
         for (int i = 1; i < argc; i++) {
             string flag = argv[i];
             if (flag.compare(string("-m")) == 0 && i + 1 < argc) {
                 map_file = argv[i+1];
             } else if (flag.compare(string("-u")) == 0 && i + 1 < argc) {
-                int value_provided = stoi(argv[i + 1]);
-                if(value_provided >= 1 && value_provided <= 5)
+                int value_provided = 0;
+                if(!parseNumber(argv[i + 1], value_provided))
+                {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                else if(value_provided >= 1 && value_provided <= 5)
                 {
                     user_story_id = value_provided;
                 }
-            } 
+            } else if (flag.compare(string("-c")) == 0 && i + 1 < argc) {
+                binary_map_file = argv[i + 1];
+            } else if (flag.compare(string("-z")) == 0) {
+                load_mode = maze::grid::MapLoadMode::ZERO_COPY;
+            } else if (flag.compare(string("-s")) == 0) {
+                is_streaming = true;
+            } else if (flag.compare(string("-i")) == 0) {
+                print_components = true;
+            } else if (flag.compare(string("-r")) == 0) {
+                print_regions = true;
+            } else if (flag.compare(string("--stats")) == 0) {
+                print_stats = true;
+            } else if (flag.compare(string("-a")) == 0 && i + 1 < argc) {
+                string algorithm_name = argv[i + 1];
+                if(algorithm_name.compare(string("jps")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::JPS;
+                }
+                else if(algorithm_name.compare(string("bibfs")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::BIDIRECTIONAL_BFS;
+                }
+                else if(algorithm_name.compare(string("biastar")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::BIDIRECTIONAL_ASTAR;
+                }
+                else if(algorithm_name.compare(string("hpa")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::HIERARCHICAL;
+                }
+                else if(algorithm_name.compare(string("dijkstra")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::DIJKSTRA;
+                }
+                else if(algorithm_name.compare(string("corridor")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::CORRIDOR_GRAPH;
+                }
+                else if(algorithm_name.compare(string("parallel")) == 0)
+                {
+                    search_algorithm = maze::grid::SearchAlgorithm::PARALLEL_BFS;
+                }
+                else if(algorithm_name.compare(string("astar")) != 0)
+                {
+                    cerr << "Unknown search algorithm : " << algorithm_name << endl;
+                    return 1;
+                }
+            } else if (flag.compare(string("-n")) == 0 && i + 1 < argc) {
+                string connectivity_name = argv[i + 1];
+                if(connectivity_name.compare(string("8")) == 0)
+                {
+                    connectivity = maze::grid::Connectivity::EIGHT;
+                }
+                else if(connectivity_name.compare(string("8c")) == 0)
+                {
+                    connectivity = maze::grid::Connectivity::EIGHT_CUTTING_CORNERS;
+                }
+                else if(connectivity_name.compare(string("4")) != 0)
+                {
+                    cerr << "Unknown connectivity : " << connectivity_name << endl;
+                    return 1;
+                }
+            } else if (flag.compare(string("--heuristic")) == 0 && i + 1 < argc) {
+                string heuristic_name = argv[i + 1];
+                if(heuristic_name.compare(string("manhattan")) == 0)
+                {
+                    heuristic = maze::grid::SearchHeuristic::MANHATTAN;
+                }
+                else if(heuristic_name.compare(string("zero")) == 0)
+                {
+                    heuristic = maze::grid::SearchHeuristic::ZERO;
+                }
+                else if(heuristic_name.compare(string("octile")) != 0)
+                {
+                    cerr << "Unknown heuristic : " << heuristic_name << endl;
+                    return 1;
+                }
+            } else if (flag.compare(string("-b")) == 0 && i + 1 < argc) {
+                batch_source = argv[i + 1];
+            } else if (flag.compare(string("-q")) == 0 && i + 1 < argc) {
+                query_file = argv[i + 1];
+            } else if (flag.compare(string("--serve")) == 0 && i + 1 < argc) {
+                socket_path = argv[i + 1];
+            } else if (flag.compare(string("--cache")) == 0 && i + 1 < argc) {
+                if(!parseNumber(argv[i + 1], cache_capacity))
+                {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                cache_capacity = max(1, cache_capacity);
+            } else if (flag.compare(string("-j")) == 0 && i + 1 < argc) {
+                if(!parseNumber(argv[i + 1], number_threads))
+                {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                number_threads = max(0, number_threads);
+            } else if (flag.compare(string("-f")) == 0 && i + 1 < argc) {
+                string format_name = argv[i + 1];
+                if(format_name.compare(string("csv")) == 0)
+                {
+                    batch_format = maze::grid::BatchFormat::CSV;
+                }
+                else if(format_name.compare(string("jsonl")) != 0)
+                {
+                    cerr << "Unknown batch format : " << format_name << endl;
+                    return 1;
+                }
+            } else if (flag.compare(string("-o")) == 0 && i + 1 < argc) {
+                string format_name = argv[i + 1];
+                if(format_name.compare(string("rle")) == 0)
+                {
+                    path_format = maze::grid::PathFormat::RLE;
+                }
+                else if(format_name.compare(string("json")) == 0)
+                {
+                    path_format = maze::grid::PathFormat::JSON;
+                }
+                else if(format_name.compare(string("binary")) == 0)
+                {
+                    path_format = maze::grid::PathFormat::BINARY;
+                }
+                else if(format_name.compare(string("text")) != 0)
+                {
+                    cerr << "Unknown path format : " << format_name << endl;
+                    return 1;
+                }
+            }
         }
 
-        filesystem::path map_file_path(map_file);
-        maze::grid::Grid grid(map_file_path);
+        // in batch mode every map of the source is solved on a thread pool
+        // and one result line per map is written to stdout
+        if(!batch_source.empty())
+        {
+            try
+            {
+                maze::grid::BatchOptions options;
+                options.user_story_id = user_story_id;
+                options.number_threads = number_threads;
+                options.load_mode = load_mode;
+                options.solve_options.search_algorithm = search_algorithm;
+                options.solve_options.connectivity = connectivity;
+                options.solve_options.heuristic = heuristic;
+
+                auto map_files = maze::grid::collectMapFiles(batch_source);
+                if(map_files.empty())
+                {
+                    cerr << "No map files found in " << batch_source << endl;
+                    return 1;
+                }
+
+                maze::grid::writeBatchResults(cout, maze::grid::solveMaps(map_files, options), batch_format);
+                return 0;
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+                return 1;
+            }
+        }
+
+        // in server mode the solver answers requests on a Unix domain socket
+        // until it receives SIGINT or SIGTERM. The signals are blocked in all
+        // threads and taken by one thread that stops the server.
+        if(!socket_path.empty())
+        {
+            maze::grid::ServerOptions options;
+            options.socket_path = socket_path;
+            options.number_threads = number_threads;
+            options.cache_capacity = cache_capacity;
+            options.load_mode = load_mode;
+            options.solve_options.search_algorithm = search_algorithm;
+            options.solve_options.connectivity = connectivity;
+            options.solve_options.heuristic = heuristic;
+            options.path_format = path_format;
+
+            sigset_t stop_signals;
+            sigemptyset(&stop_signals);
+            sigaddset(&stop_signals, SIGINT);
+            sigaddset(&stop_signals, SIGTERM);
+            pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+            maze::grid::SolverServer server(options);
+            thread signal_thread([&]()
+            {
+                int signal_number = 0;
+                sigwait(&stop_signals, &signal_number);
+                server.stop();
+            });
+
+            int exit_code = 0;
+            try
+            {
+                server.run();
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+                exit_code = 1;
+            }
+
+            // the signal thread is woken up if the server stopped on its own
+            if(exit_code != 0)
+            {
+                pthread_kill(signal_thread.native_handle(), SIGTERM);
+            }
+            signal_thread.join();
+            return exit_code;
+        }
+
+        // in streaming mode the map is read from a stream, "-" is stdin.
+        // User stories 1, 2 and 4 keep a window of rows in memory, the
+        // others store the grid map in a scratch file on disk.
+        ifstream map_file_handler;
+        istream* map_stream = &cin;
+        if(is_streaming && map_file.compare(string("-")) != 0)
+        {
+            map_file_handler.open(map_file);
+            if(!map_file_handler.is_open())
+            {
+                cerr << "Could not open file : " << map_file << endl;
+                return 1;
+            }
+            map_stream = &map_file_handler;
+        }
+
+        unique_ptr<maze::grid::MapRowStream> row_stream;
+        unique_ptr<maze::grid::Grid> grid_ptr;
+        if(is_streaming && binary_map_file.empty() && query_file.empty() && !print_components && !print_regions && (user_story_id == 1 || user_story_id == 2 || user_story_id == 4))
+        {
+            row_stream = make_unique<maze::grid::MapRowStream>(*map_stream);
+        }
+        else if(is_streaming)
+        {
+            grid_ptr = make_unique<maze::grid::Grid>(*map_stream);
+        }
+        else
+        {
+            grid_ptr = make_unique<maze::grid::Grid>(filesystem::path(map_file), load_mode);
+        }
+
+        // convert the map into the binary format instead of solving it
+        if(!binary_map_file.empty())
+        {
+            try
+            {
+                grid_ptr->saveBinaryMap(binary_map_file);
+                cout << "Binary map written to " << binary_map_file << endl;
+                return 0;
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+                return 1;
+            }
+        }
+
+        // print the statistics of the connected components instead of solving
+        if(print_components)
+        {
+            if(!grid_ptr->isInitialized())
+            {
+                return 1;
+            }
+
+            auto const& component_sizes = grid_ptr->getComponentIndex().getComponentSizes();
+            int64_t number_free_cells = 0;
+            int64_t largest_component_size = 0;
+            for(auto const& component_size : component_sizes)
+            {
+                number_free_cells += component_size;
+                largest_component_size = max(largest_component_size, component_size);
+            }
+
+            cout << "Free cells : " << number_free_cells << endl;
+            cout << "Components : " << component_sizes.size() << endl;
+            cout << "Largest component : " << largest_component_size << " cells" << endl;
+            cout << "Cells outside the largest component : " << number_free_cells - largest_component_size << endl;
+            return 0;
+        }
+
+        // print the statistics of the rooms and corridors instead of solving
+        if(print_regions)
+        {
+            if(!grid_ptr->isInitialized())
+            {
+                return 1;
+            }
+
+            auto const& region_index = grid_ptr->getRegionIndex();
+            int number_rooms = 0;
+            int64_t largest_room_size = 0;
+            for(auto const& region : region_index.getRegions())
+            {
+                if(region.kind == maze::grid::RegionKind::ROOM)
+                {
+                    number_rooms++;
+                    largest_room_size = max(largest_room_size, region.number_cells);
+                }
+            }
+
+            cout << "Rooms : " << number_rooms << endl;
+            cout << "Corridors : " << region_index.getNumberRegions() - number_rooms << endl;
+            cout << "Doors : " << region_index.getDoors().size() << endl;
+            cout << "Largest room : " << largest_room_size << " cells" << endl;
+            return 0;
+        }
+
+        // in query mode the loaded map answers every query of the query
+        // file, one path or message per line in the order of the queries
+        if(!query_file.empty())
+        {
+            ifstream query_file_handler(query_file);
+            if(!query_file_handler.is_open())
+            {
+                cerr << "Could not open file : " << query_file << endl;
+                return 1;
+            }
+
+            try
+            {
+                maze::grid::SolveOptions options;
+                options.search_algorithm = search_algorithm;
+                options.number_threads = number_threads;
+                options.connectivity = connectivity;
+                options.heuristic = heuristic;
+
+                // paths of side steps are found and written as packed moves
+                auto queries = maze::grid::readPathQueries(query_file_handler);
+                if(connectivity == maze::grid::Connectivity::FOUR)
+                {
+                    for(auto const& path : grid_ptr->findPathsPacked(queries, options))
+                    {
+                        printPath(path, path_format);
+                    }
+                }
+                else
+                {
+                    for(auto const& path : grid_ptr->findPaths(queries, options))
+                    {
+                        printPath(path, path_format);
+                    }
+                }
+                return 0;
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+                return 1;
+            }
+        }
 
         switch (user_story_id)
         {
             case 1:
                 {
-                    if(int col_index = grid.searchARowForEmptySpace(0); col_index != maze::grid::Constants::INDEX_NOT_FOUND)
+                    if(int col_index = row_stream ? maze::grid::streamSearchARowForEmptySpace(*row_stream, 0) : grid_ptr->searchARowForEmptySpace(0); col_index != maze::grid::Constants::INDEX_NOT_FOUND)
                     {
                         cout << "First empty space in row " << 1 << " is at column " << col_index + 1 << endl;
                     }
@@ -78,53 +486,54 @@ int main(int argc, char** argv)
                 }
             case 2:
                 {
-                    auto path = grid.walkThrouhHallway();
-                    if(path.size() > 0)
+                    if(row_stream)
                     {
-                        printPath(path);
+                        printPath(maze::grid::streamWalkThroughHallway(*row_stream), path_format);
                     }
                     else
                     {
-                        cout << "No path found or an error occured." << endl;
+                        printPath(grid_ptr->walkThroughHallwayPacked(), path_format);
                     }
                     break;
                 }
             case 3:
                 {
-                    auto path = grid.findPathToAndOutOfRoom();
-                    if(path.size() > 0)
-                    {
-                        printPath(path);
-                    }
-                    else
-                    {
-                        cout << "No path found or an error occured." << endl;
-                    }
+                    printPath(grid_ptr->findPathToAndOutOfRoomPacked(), path_format);
                     break;
                 }
             case 4:
                 {
-                    auto path = grid.findWindingPath();
-                    if(path.size() > 0)
+                    if(row_stream)
                     {
-                        printPath(path);
+                        printPath(maze::grid::streamFindWindingPath(*row_stream), path_format);
                     }
                     else
                     {
-                        cout << "No path found or an error occured." << endl;
+                        printPath(grid_ptr->findWindingPathPacked(), path_format);
                     }
                     break;
                 }
             case 5:
                 {
-                    auto path = grid.solveMaze();
-                    if(path.size() > 0)
+                    maze::grid::SolveOptions options;
+                    options.search_algorithm = search_algorithm;
+                    options.connectivity = connectivity;
+                    options.heuristic = heuristic;
+                    options.number_threads = number_threads;
+
+                    maze::grid::SolveStats stats;
+                    if(connectivity == maze::grid::Connectivity::FOUR)
                     {
-                        printPath(path);
+                        printPath(grid_ptr->solveMazePacked(options, print_stats ? &stats : nullptr), path_format);
                     }
                     else
                     {
-                        cout << "No path found or an error occured." << endl;
+                        printPath(grid_ptr->solveMaze(options, print_stats ? &stats : nullptr), path_format);
+                    }
+
+                    if(print_stats)
+                    {
+                        maze::grid::writeSolveStats(cout, stats);
                     }
                     break;
                 }
@@ -0,0 +1,458 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+// system includes
+#include <sys/resource.h>
+
+// benchmark includes
+#include <benchmark/benchmark.h>
+
+// project includes
+#include "maze.hpp"
+
+using namespace std;
+using maze::grid::MazeKind;
+
+namespace
+{
+    // side lengths of the square mazes, sizes above MAZE_BENCH_MAX_SIZE
+    // (4096 unless set in the environment) are skipped
+    const int MAZE_SIZES[] = {64, 256, 1024, 4096, 16384};
+    constexpr uint64_t MAZE_SEED = 2023;
+
+    const char* getMazeKindName(const MazeKind& maze_kind)
+    {
+        switch(maze_kind)
+        {
+            case MazeKind::BACKTRACKER: return "backtracker";
+            case MazeKind::KRUSKAL: return "kruskal";
+            case MazeKind::ROOM: return "room";
+            case MazeKind::OBSTACLES: return "obstacles";
+            case MazeKind::WINDING: return "winding";
+        }
+
+        return "unknown";
+    }
+
+    // getMazeFile function that generates a maze once and writes it as a
+    // text map into the temporary directory
+    filesystem::path const& getMazeFile(const MazeKind& maze_kind, const int& size)
+    {
+        static map<pair<MazeKind, int>, filesystem::path> maze_files;
+
+        auto& maze_file_path = maze_files[make_pair(maze_kind, size)];
+        if(maze_file_path.empty())
+        {
+            maze_file_path = filesystem::temp_directory_path() / ("maze_bench_" + string(getMazeKindName(maze_kind)) + "_" + to_string(size) + ".txt");
+            maze::grid::writeMap(maze_file_path, maze::grid::generateMaze(maze_kind, size, size, MAZE_SEED));
+        }
+
+        return maze_file_path;
+    }
+
+    // getGrid function that loads a generated maze into a grid once
+    maze::grid::Grid const& getGrid(const MazeKind& maze_kind, const int& size)
+    {
+        static map<pair<MazeKind, int>, unique_ptr<maze::grid::Grid>> grids;
+
+        auto& grid = grids[make_pair(maze_kind, size)];
+        if(!grid)
+        {
+            grid = make_unique<maze::grid::Grid>(getMazeFile(maze_kind, size).string());
+        }
+
+        return *grid;
+    }
+
+    // removeMazeFiles function that removes the generated text maps
+    void removeMazeFiles()
+    {
+        for(auto const& size : MAZE_SIZES)
+        {
+            for(auto const& maze_kind : {MazeKind::BACKTRACKER, MazeKind::KRUSKAL, MazeKind::ROOM, MazeKind::OBSTACLES, MazeKind::WINDING})
+            {
+                filesystem::remove(filesystem::temp_directory_path() / ("maze_bench_" + string(getMazeKindName(maze_kind)) + "_" + to_string(size) + ".txt"));
+            }
+        }
+    }
+
+    // setPeakMemoryCounter function that reports the peak resident memory
+    // of the process so far
+    void setPeakMemoryCounter(benchmark::State& state)
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        state.counters["peak_rss_mb"] = usage.ru_maxrss / 1024.0;
+    }
+
+    // setSearchCounters function that also reports the nodes expanded per search
+    void setSearchCounters(benchmark::State& state, const maze::graph::SearchStats& stats)
+    {
+        state.counters["nodes_expanded"] = benchmark::Counter(stats.nodes_expanded, benchmark::Counter::kAvgIterations);
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkReadMap(benchmark::State& state, MazeKind maze_kind, int size, maze::grid::MapLoadMode load_mode)
+    {
+        auto const& maze_file_path = getMazeFile(maze_kind, size);
+        for(auto _ : state)
+        {
+            auto grid_map = maze::grid::readMap(maze_file_path, load_mode);
+            benchmark::DoNotOptimize(grid_map.getRow(0));
+        }
+
+        state.SetBytesProcessed(state.iterations() * filesystem::file_size(maze_file_path));
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkSearchARowForEmptySpace(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        // the last row only holds the exit, so the whole row is scanned
+        auto const& grid = getGrid(maze_kind, size);
+        for(auto _ : state)
+        {
+            benchmark::DoNotOptimize(grid.searchARowForEmptySpace(size - 1));
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkWalkThroughHallway(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid = getGrid(maze_kind, size);
+        for(auto _ : state)
+        {
+            benchmark::DoNotOptimize(grid.walkThrouhHallway());
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkFindPathToAndOutOfRoom(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid = getGrid(maze_kind, size);
+        for(auto _ : state)
+        {
+            benchmark::DoNotOptimize(grid.findPathToAndOutOfRoom());
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkFindWindingPath(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid = getGrid(maze_kind, size);
+        for(auto _ : state)
+        {
+            benchmark::DoNotOptimize(grid.findWindingPath());
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkPerformSimpleDFS(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        // the winding path starts at the entrance on the first column
+        auto const& grid_map = getGrid(maze_kind, size).getFlatGridMap();
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            maze::graph::performSimpleDFS(grid_map, 1, 0, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    void benchmarkFollowCorridor(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid_map = getGrid(maze_kind, size).getFlatGridMap();
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            maze::graph::followCorridor(grid_map, 1, 0, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    using SearchFunction = void (*)(maze::grid::GridMap const&, const int&, const int&, const int&, const int&, vector<pair<int, int>>&, maze::graph::SearchStats*);
+
+    void benchmarkShortestPath(benchmark::State& state, SearchFunction search_function, MazeKind maze_kind, int size)
+    {
+        // every generated maze has its exit on the last row and all but
+        // the room have the entrance at (0, 1)
+        auto const& grid = getGrid(maze_kind, size);
+        auto const& grid_map = grid.getFlatGridMap();
+        int start_row_index = maze_kind == MazeKind::ROOM ? 1 : 0;
+        int start_col_index = maze_kind == MazeKind::ROOM ? 0 : 1;
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            search_function(grid_map, start_row_index, start_col_index, size - 1, end_col_index, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    void benchmarkAStarWithNeighborMask(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid = getGrid(maze_kind, size);
+        int start_row_index = maze_kind == MazeKind::ROOM ? 1 : 0;
+        int start_col_index = maze_kind == MazeKind::ROOM ? 0 : 1;
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            maze::graph::performAStar(grid.getFlatGridMap(), grid.getNeighborMask(), start_row_index, start_col_index, size - 1, end_col_index, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    void benchmarkBuildHierarchicalMap(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        auto const& grid_map = getGrid(maze_kind, size).getFlatGridMap();
+        for(auto _ : state)
+        {
+            maze::graph::HierarchicalMap hierarchical_map(grid_map);
+            benchmark::DoNotOptimize(hierarchical_map.getNumberNodes());
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkHierarchicalQuery(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        // the map is built once, only the queries are timed
+        auto const& grid = getGrid(maze_kind, size);
+        auto const& grid_map = grid.getFlatGridMap();
+        maze::graph::HierarchicalMap hierarchical_map(grid_map);
+        int start_row_index = maze_kind == MazeKind::ROOM ? 1 : 0;
+        int start_col_index = maze_kind == MazeKind::ROOM ? 0 : 1;
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            hierarchical_map.findPath(start_row_index, start_col_index, size - 1, end_col_index, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    void benchmarkCorridorGraphQuery(benchmark::State& state, MazeKind maze_kind, int size)
+    {
+        // the graph is built once, only the queries are timed
+        auto const& grid = getGrid(maze_kind, size);
+        maze::graph::CorridorGraph corridor_graph(grid.getFlatGridMap(), grid.getNeighborMask());
+        int start_row_index = maze_kind == MazeKind::ROOM ? 1 : 0;
+        int start_col_index = maze_kind == MazeKind::ROOM ? 0 : 1;
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            vector<pair<int, int>> path;
+            corridor_graph.findPath(start_row_index, start_col_index, size - 1, end_col_index, path, &stats);
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    void benchmarkDistanceField(benchmark::State& state, MazeKind maze_kind, int size, int number_threads)
+    {
+        auto const& grid = getGrid(maze_kind, size);
+        auto const& grid_map = grid.getFlatGridMap();
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        for(auto _ : state)
+        {
+            maze::graph::DistanceField distance_field(grid_map, size - 1, end_col_index, number_threads);
+            benchmark::DoNotOptimize(distance_field.getNumberLevels());
+        }
+
+        setPeakMemoryCounter(state);
+    }
+
+    void benchmarkReplan(benchmark::State& state, MazeKind maze_kind, int size, bool use_dstar_lite)
+    {
+        // every iteration closes a cell in the middle of the path, finds a
+        // path, opens the cell again and finds a path again
+        auto const& grid = getGrid(maze_kind, size);
+        maze::grid::GridMap grid_map = grid.getFlatGridMap();
+        int start_row_index = maze_kind == MazeKind::ROOM ? 1 : 0;
+        int start_col_index = maze_kind == MazeKind::ROOM ? 0 : 1;
+        int end_col_index = grid.searchARowForEmptySpace(size - 1);
+
+        maze::graph::DStarLite planner(grid_map, start_row_index, start_col_index, size - 1, end_col_index);
+        vector<pair<int, int>> path;
+        planner.findPath(path);
+        if(path.size() < 3)
+        {
+            state.SkipWithError("No path to replan.");
+            return;
+        }
+        auto changed_cell = path[path.size() / 2];
+
+        maze::graph::SearchStats stats;
+        for(auto _ : state)
+        {
+            for(auto const& is_wall : {true, false})
+            {
+                grid_map.setCell(changed_cell.first, changed_cell.second, is_wall ? maze::grid::Constants::WALL_CELL : maze::grid::Constants::FREE_CELL);
+                path.clear();
+                if(use_dstar_lite)
+                {
+                    planner.updateCells({{changed_cell.first, changed_cell.second, is_wall}});
+                    planner.findPath(path, &stats);
+                }
+                else
+                {
+                    maze::graph::performAStar(grid_map, start_row_index, start_col_index, size - 1, end_col_index, path, &stats);
+                }
+                benchmark::DoNotOptimize(path.data());
+            }
+        }
+
+        setSearchCounters(state, stats);
+    }
+
+    // performDijkstra function that runs the search core without a heuristic
+    void performDijkstra(maze::grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, maze::graph::SearchStats* stats)
+    {
+        maze::graph::performGridSearch(grid_map, maze::graph::FourConnected(), maze::graph::ZeroHeuristic(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+    }
+
+    // performOctileAStar function that runs the search core with diagonal
+    // steps and the octile heuristic
+    void performOctileAStar(maze::grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, maze::graph::SearchStats* stats)
+    {
+        maze::graph::performGridSearch(grid_map, maze::graph::EightConnected<false>(), maze::graph::OctileHeuristic<maze::graph::EightConnected<false>>(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+    }
+
+    // performParallelBFSOnAllThreads function that runs the parallel breadth
+    // first search with one thread per hardware thread
+    void performParallelBFSOnAllThreads(maze::grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, maze::graph::SearchStats* stats)
+    {
+        maze::graph::performParallelBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, 0);
+    }
+
+    // performBidirectionalBFSOnOneThread function that runs the bidirectional
+    // BFS with both frontiers on the calling thread
+    void performBidirectionalBFSOnOneThread(maze::grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, maze::graph::SearchStats* stats)
+    {
+        maze::graph::performBidirectionalBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, false);
+    }
+
+    // performBidirectionalBFSOnTwoThreads function that runs the bidirectional
+    // BFS with one thread per frontier, whatever the size of the maze
+    void performBidirectionalBFSOnTwoThreads(maze::grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, maze::graph::SearchStats* stats)
+    {
+        maze::graph::performBidirectionalBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, true);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int max_size = 4096;
+    if(const char* max_size_value = getenv("MAZE_BENCH_MAX_SIZE"); max_size_value != nullptr)
+    {
+        max_size = atoi(max_size_value);
+    }
+
+    for(auto const& size : MAZE_SIZES)
+    {
+        if(size > max_size)
+        {
+            continue;
+        }
+
+        string suffix = "/" + to_string(size);
+        for(auto const& maze_kind : {MazeKind::BACKTRACKER, MazeKind::ROOM, MazeKind::OBSTACLES})
+        {
+            benchmark::RegisterBenchmark(("readMap/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkReadMap, maze_kind, size, maze::grid::MapLoadMode::COPY);
+            benchmark::RegisterBenchmark(("readMap/zero_copy/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkReadMap, maze_kind, size, maze::grid::MapLoadMode::ZERO_COPY);
+            benchmark::RegisterBenchmark(("searchARowForEmptySpace/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkSearchARowForEmptySpace, maze_kind, size);
+        }
+
+        benchmark::RegisterBenchmark(("walkThrouhHallway/winding" + suffix).c_str(), benchmarkWalkThroughHallway, MazeKind::WINDING, size);
+        benchmark::RegisterBenchmark(("findPathToAndOutOfRoom/room" + suffix).c_str(), benchmarkFindPathToAndOutOfRoom, MazeKind::ROOM, size);
+        benchmark::RegisterBenchmark(("findWindingPath/winding" + suffix).c_str(), benchmarkFindWindingPath, MazeKind::WINDING, size);
+        benchmark::RegisterBenchmark(("performSimpleDFS/winding" + suffix).c_str(), benchmarkPerformSimpleDFS, MazeKind::WINDING, size);
+        benchmark::RegisterBenchmark(("followCorridor/winding" + suffix).c_str(), benchmarkFollowCorridor, MazeKind::WINDING, size);
+
+        for(auto const& maze_kind : {MazeKind::BACKTRACKER, MazeKind::KRUSKAL, MazeKind::ROOM, MazeKind::OBSTACLES})
+        {
+            SearchFunction perform_astar = maze::graph::performAStar;
+            SearchFunction perform_jump_point_search = maze::graph::performJumpPointSearch;
+            SearchFunction perform_dijkstra = performDijkstra;
+            SearchFunction perform_octile_astar = performOctileAStar;
+            SearchFunction perform_bidirectional_bfs = performBidirectionalBFSOnOneThread;
+            SearchFunction perform_bidirectional_bfs_on_two_threads = performBidirectionalBFSOnTwoThreads;
+            SearchFunction perform_bidirectional_astar = maze::graph::performBidirectionalAStar;
+            SearchFunction perform_parallel_bfs = performParallelBFSOnAllThreads;
+            benchmark::RegisterBenchmark(("performAStar/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_astar, maze_kind, size);
+            benchmark::RegisterBenchmark(("performAStar/neighbor_mask/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkAStarWithNeighborMask, maze_kind, size);
+            benchmark::RegisterBenchmark(("performGridSearch/dijkstra/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_dijkstra, maze_kind, size);
+            benchmark::RegisterBenchmark(("performGridSearch/octile/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_octile_astar, maze_kind, size);
+            benchmark::RegisterBenchmark(("performJumpPointSearch/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_jump_point_search, maze_kind, size);
+            benchmark::RegisterBenchmark(("performBidirectionalBFS/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_bidirectional_bfs, maze_kind, size);
+            benchmark::RegisterBenchmark(("performBidirectionalBFS/two_threads/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_bidirectional_bfs_on_two_threads, maze_kind, size);
+            benchmark::RegisterBenchmark(("performBidirectionalAStar/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_bidirectional_astar, maze_kind, size);
+            benchmark::RegisterBenchmark(("performParallelBFS/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkShortestPath, perform_parallel_bfs, maze_kind, size);
+            benchmark::RegisterBenchmark(("HierarchicalMap/build/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkBuildHierarchicalMap, maze_kind, size);
+            benchmark::RegisterBenchmark(("HierarchicalMap/findPath/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkHierarchicalQuery, maze_kind, size);
+            benchmark::RegisterBenchmark(("CorridorGraph/findPath/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkCorridorGraphQuery, maze_kind, size);
+            benchmark::RegisterBenchmark(("DistanceField/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkDistanceField, maze_kind, size, 1);
+            benchmark::RegisterBenchmark(("DistanceField/all_threads/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkDistanceField, maze_kind, size, 0);
+            benchmark::RegisterBenchmark(("replan/performAStar/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkReplan, maze_kind, size, false);
+            benchmark::RegisterBenchmark(("replan/DStarLite/" + string(getMazeKindName(maze_kind)) + suffix).c_str(), benchmarkReplan, maze_kind, size, true);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    removeMazeFiles();
+
+    return 0;
+}
@@ -18,40 +18,859 @@
 #define MAZE_H
 
 // stl includes
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <filesystem>
 
 namespace maze
 {
+    namespace graph
+    {
+        class HierarchicalMap;
+        class CorridorGraph;
+        class DistanceField;
+
+        // SearchStats struct that collects counters while a search runs.
+        // Searches take an optional pointer to it and add to the counters.
+        // The peak frontier size is the largest open list, stack or BFS
+        // level of one search, the bytes are those of the per-cell state
+        // the search had to allocate.
+        struct SearchStats
+        {
+            std::int64_t nodes_expanded = 0;
+            std::int64_t nodes_pushed = 0;
+            std::int64_t decrease_keys = 0;
+            std::int64_t peak_frontier_size = 0;
+            std::int64_t bytes_allocated = 0;
+        };
+
+        // StatsRecorder class that adds the events of a search to a
+        // SearchStats struct
+        class StatsRecorder
+        {
+            public:
+                StatsRecorder(SearchStats& stats) : stats(stats) {}
+
+                void expand() { stats.nodes_expanded++; }
+                void push(const std::size_t& frontier_size) { stats.nodes_pushed++; stats.peak_frontier_size = std::max(stats.peak_frontier_size, static_cast<std::int64_t>(frontier_size)); }
+                void decreaseKey() { stats.decrease_keys++; }
+                void allocate(const std::size_t& number_bytes) { stats.bytes_allocated += number_bytes; }
+
+            private:
+                SearchStats& stats;
+        };
+
+        // NoStatsRecorder class that has the interface of StatsRecorder and
+        // ignores every event, so the counting compiles away
+        class NoStatsRecorder
+        {
+            public:
+                void expand() {}
+                void push(const std::size_t&) {}
+                void decreaseKey() {}
+                void allocate(const std::size_t&) {}
+        };
+
+        // recordSearch function that runs a search, written as a generic
+        // lambda taking a recorder, with a StatsRecorder if stats is given
+        // and with a NoStatsRecorder otherwise. Each search is compiled once
+        // for each recorder, so searches without stats do not pay for them.
+        template<typename Search>
+        void recordSearch(SearchStats* stats, Search const& search)
+        {
+            if(stats != nullptr)
+            {
+                StatsRecorder recorder(*stats);
+                search(recorder);
+            }
+            else
+            {
+                NoStatsRecorder recorder;
+                search(recorder);
+            }
+        }
+    }
+
     namespace grid
     {   
-        // readMap function that reads the map file and returns
-        // a 2D vector of integers
-        std::vector<std::vector<int>> readMap(std::filesystem::path const& filepath);
-
         // Constants class that holds all the constants
         // These constants are used across the project
         class Constants
         {
             public:
                 static constexpr int INDEX_NOT_FOUND = -1;
+                static constexpr std::uint8_t FREE_CELL = 0;
+                static constexpr std::uint8_t WALL_CELL = 1;
+        };
+
+        // MappedRegion class that maps a file into memory. A map file is
+        // mapped privately and can be surrounded by leading and trailing
+        // bytes of zeroed anonymous memory, which lets a view over the file
+        // extend past its first and last byte. Writes never reach the map
+        // file. A scratch file is mapped shared, so the kernel can write its
+        // pages back to disk instead of keeping them in memory.
+        class MappedRegion
+        {
+            public:
+                MappedRegion(std::filesystem::path const& file_path, const std::size_t& leading_bytes = 0, const std::size_t& trailing_bytes = 0);
+                MappedRegion(const int& scratch_file_descriptor, const std::size_t& size);
+                ~MappedRegion();
+
+                MappedRegion(const MappedRegion&) = delete;
+                MappedRegion& operator=(const MappedRegion&) = delete;
+
+                // getData function that returns a pointer to the first byte of the file
+                const std::uint8_t* getData() const { return data; }
+                std::uint8_t* getData() { return data; }
+                const std::size_t& getSize() const { return size; }
+
+            private:
+                void* region;
+                std::size_t region_size;
+                std::uint8_t* data;
+                std::size_t size;
         };
 
+        // createScratchFile function that creates an unlinked temporary file
+        // in the system temporary directory and returns its descriptor
+        int createScratchFile();
+
+        // createScratchRegion function that maps a new scratch file of the
+        // given size, the pages start zeroed
+        std::shared_ptr<MappedRegion> createScratchRegion(const std::size_t& size);
+
+        // ScratchArray class that holds a fixed number of trivially copyable
+        // elements either on the heap or in a scratch file on disk. Search
+        // engines keep their per-cell state in scratch arrays, so the state
+        // of a maze that is larger than memory spills to disk with the maze.
+        template <typename T>
+        class ScratchArray
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Scratch arrays only hold trivially copyable elements.");
+
+            public:
+                ScratchArray() : elements(nullptr), number_elements(0) {}
+                ScratchArray(const ScratchArray&) = delete;
+                ScratchArray& operator=(const ScratchArray&) = delete;
+                ScratchArray(ScratchArray&& scratch_array) noexcept { *this = std::move(scratch_array); }
+                ScratchArray& operator=(ScratchArray&& scratch_array) noexcept
+                {
+                    memory = std::move(scratch_array.memory);
+                    disk = std::move(scratch_array.disk);
+                    elements = disk ? scratch_array.elements : memory.data();
+                    number_elements = scratch_array.number_elements;
+                    scratch_array.elements = nullptr;
+                    scratch_array.number_elements = 0;
+                    return *this;
+                }
+
+                // assign function that resizes the array and sets every element
+                void assign(const std::size_t& number_elements, const T& value, const bool& use_disk = false)
+                {
+                    if(use_disk)
+                    {
+                        memory = std::vector<T>();
+                        disk = createScratchRegion(std::max<std::size_t>(number_elements * sizeof(T), 1));
+                        elements = reinterpret_cast<T*>(disk->getData());
+                        std::fill(elements, elements + number_elements, value);
+                    }
+                    else
+                    {
+                        disk.reset();
+                        memory.assign(number_elements, value);
+                        elements = memory.data();
+                    }
+
+                    this->number_elements = number_elements;
+                }
+
+                T& operator[](const std::size_t& index) { return elements[index]; }
+                const T& operator[](const std::size_t& index) const { return elements[index]; }
+                T* data() { return elements; }
+                const T* data() const { return elements; }
+                const std::size_t& size() const { return number_elements; }
+                bool isOnDisk() const { return disk != nullptr; }
+
+            private:
+                std::vector<T> memory;
+                std::shared_ptr<MappedRegion> disk;
+                T* elements;
+                std::size_t number_elements;
+        };
+
+        // GridMap class that stores the cells of a maze in one contiguous,
+        // row major block of bytes. The cells are surrounded by a border of
+        // walls, so the four neighbors of any cell can be read without
+        // bounds checks. Rows can optionally be padded to a multiple of
+        // row_alignment bytes. Cells are addressed either by row and column
+        // index or by their cell index in the padded storage.
+        //
+        // A grid map either owns its cells, encoded as Constants::FREE_CELL
+        // and Constants::WALL_CELL, or is a view over a mapped ASCII map
+        // file, where cells keep their '0' and '1' characters and the line
+        // breaks act as the left and right border. Copies of a view share
+        // the mapping.
+        class GridMap
+        {
+            public:
+                GridMap();
+                GridMap(const int& number_rows, const int& number_cols, const int& row_alignment = 1);
+                GridMap(std::vector<std::vector<int>> const& grid_map, const int& row_alignment = 1);
+                GridMap(const GridMap& grid_map);
+                GridMap(GridMap&& grid_map) noexcept;
+                GridMap& operator=(const GridMap& grid_map);
+                GridMap& operator=(GridMap&& grid_map) noexcept;
+                ~GridMap();
+
+                // fromMappedAscii function that returns a view over a mapped
+                // map file with number_rows lines of number_cols characters. The
+                // mapping must have at least number_cols + 2 leading and trailing
+                // bytes, and the file content must have been validated.
+                static GridMap fromMappedAscii(std::shared_ptr<MappedRegion> const& mapping, const int& number_rows, const int& number_cols);
+
+                // fromMappedCells function that returns a grid map stored in a
+                // mapped scratch file, which holds number_rows + 2 rows of
+                // number_cols + 2 cells including the wall border
+                static GridMap fromMappedCells(std::shared_ptr<MappedRegion> const& mapping, const int& number_rows, const int& number_cols);
+
+                const int& getNumberRows() const { return number_rows; }
+                const int& getNumberCols() const { return number_cols; }
+                const int& getRowStride() const { return row_stride; }
+
+                // getNumberCellIndices function that returns the size of the
+                // padded storage, i.e. one past the largest cell index
+                int getNumberCellIndices() const { return number_cell_indices; }
+
+                // empty function that returns true if the map has no rows
+                bool empty() const { return number_rows == 0; }
+
+                // isMappedAscii function that returns true for views over a map file
+                bool isMappedAscii() const { return mapping != nullptr && free_value != Constants::FREE_CELL; }
+
+                // isDiskBacked function that returns true for grid maps stored in
+                // a scratch file, search engines then keep their state on disk too
+                bool isDiskBacked() const { return mapping != nullptr && free_value == Constants::FREE_CELL; }
+
+                // getCellIndex, getRowIndex and getColIndex functions that
+                // convert between row and column indices and cell indices
+                int getCellIndex(const int& row_index, const int& col_index) const { return (row_index + 1) * row_stride + col_index + 1; }
+                int getRowIndex(const int& cell_index) const { return cell_index / row_stride - 1; }
+                int getColIndex(const int& cell_index) const { return cell_index % row_stride - 1; }
+
+                // getCell function that returns Constants::FREE_CELL or Constants::WALL_CELL.
+                // Rows -1 and number_rows and columns -1 and number_cols are the wall border.
+                std::uint8_t getCell(const int& row_index, const int& col_index) const { return isFree(row_index, col_index) ? Constants::FREE_CELL : Constants::WALL_CELL; }
+                bool isFree(const int& row_index, const int& col_index) const { return isFreeCell(getCellIndex(row_index, col_index)); }
+                bool isFreeCell(const int& cell_index) const { return cell_data[cell_index] == free_value; }
+
+                // setCell function that sets the value of a cell inside the border
+                void setCell(const int& row_index, const int& col_index, const std::uint8_t& value);
+
+                // getRow function that returns a pointer to the first cell of a row.
+                // The cells are stored raw, getFreeValue returns the free cell value.
+                const std::uint8_t* getRow(const int& row_index) const { return cell_data + getCellIndex(row_index, 0); }
+                std::uint8_t* getRow(const int& row_index) { return cell_data + getCellIndex(row_index, 0); }
+                const std::uint8_t& getFreeValue() const { return free_value; }
+
+                // toVectorOfVectors function that returns a copy of the map
+                // as a 2D vector of integers
+                std::vector<std::vector<int>> toVectorOfVectors() const;
+
+            private:
+                int number_rows;
+                int number_cols;
+                int row_stride;
+                int number_cell_indices;
+                std::uint8_t free_value;
+                std::uint8_t wall_value;
+                std::uint8_t* cell_data;
+                std::vector<std::uint8_t> cells;
+                std::shared_ptr<MappedRegion> mapping;
+        };
+
+        // isValidAsciiRow and convertAsciiRow functions that check that a row
+        // only contains '0' and '1' characters, eight characters at a time.
+        // convertAsciiRow also writes the converted cells.
+        bool isValidAsciiRow(const char* ascii_row, const int& number_cols);
+        bool convertAsciiRow(const char* ascii_row, std::uint8_t* row, const int& number_cols);
+
+        // findFirstZeroBit and findFirstSetBit functions that return the index
+        // of the first clear or set bit at or after from_bit in a block of
+        // 64-bit words, or Constants::INDEX_NOT_FOUND. Words are scanned four
+        // at a time with AVX2 when the CPU supports it.
+        int findFirstZeroBit(const std::uint64_t* words, const int& number_words, const int& from_bit = 0);
+        int findFirstSetBit(const std::uint64_t* words, const int& number_words, const int& from_bit = 0);
+
+        // WallBitmap class that stores one bit per cell, set for walls, packed
+        // into 64-bit words. The bitmap is kept twice: row major, and column
+        // major (transposed) so that column scans are contiguous as well.
+        // Bits past the last row or column are set, i.e. treated as walls.
+        class WallBitmap
+        {
+            public:
+                WallBitmap();
+                WallBitmap(GridMap const& grid_map);
+
+                // WallBitmap constructor that copies rows of words, in the
+                // layout of getRowWords, and derives the columns from them
+                WallBitmap(const int& number_rows, const int& number_cols, const std::uint64_t* row_words);
+                ~WallBitmap();
+
+                const int& getNumberRows() const { return number_rows; }
+                const int& getNumberCols() const { return number_cols; }
+                const int& getWordsPerRow() const { return words_per_row; }
+                const int& getWordsPerCol() const { return words_per_col; }
+
+                const std::uint64_t* getRowWords(const int& row_index) const { return row_words.data() + static_cast<std::size_t>(row_index) * words_per_row; }
+                const std::uint64_t* getColWords(const int& col_index) const { return col_words.data() + static_cast<std::size_t>(col_index) * words_per_col; }
+
+                bool isWall(const int& row_index, const int& col_index) const { return (getRowWords(row_index)[col_index >> 6] >> (col_index & 63)) & 1; }
+
+                // setWall function that updates a cell in both layouts
+                void setWall(const int& row_index, const int& col_index, const bool& is_wall);
+
+                // findFirstFreeInRow and findFirstFreeInCol functions that return
+                // the first free cell at or after the given index, or
+                // Constants::INDEX_NOT_FOUND
+                int findFirstFreeInRow(const int& row_index, const int& from_col_index = 0) const;
+                int findFirstFreeInCol(const int& col_index, const int& from_row_index = 0) const;
+
+                // findFirstWallInRow and findFirstWallInCol functions that return
+                // the first wall at or after the given index, or the number of
+                // columns or rows if the walk reaches the edge of the map
+                int findFirstWallInRow(const int& row_index, const int& from_col_index = 0) const;
+                int findFirstWallInCol(const int& col_index, const int& from_row_index = 0) const;
+
+            private:
+                int number_rows;
+                int number_cols;
+                int words_per_row;
+                int words_per_col;
+                std::vector<std::uint64_t> row_words;
+                std::vector<std::uint64_t> col_words;
+        };
+
+        // ComponentIndex class that labels the connected components of the
+        // free cells of a grid map. The labels are found with a union-find
+        // over the runs of free cells of every row and stored per cell
+        // index, so two cells can be checked for a path between them in
+        // O(1). Walls have the label Constants::INDEX_NOT_FOUND.
+        class ComponentIndex
+        {
+            public:
+                ComponentIndex();
+                ComponentIndex(GridMap const& grid_map);
+                ComponentIndex(ComponentIndex&& component_index) noexcept = default;
+                ComponentIndex& operator=(ComponentIndex&& component_index) noexcept = default;
+                ~ComponentIndex();
+
+                // getComponent function that returns the component of a cell index
+                const int& getComponent(const int& cell_index) const { return labels[cell_index]; }
+
+                // isConnected function that returns true if both cell indices
+                // are free and in the same component
+                bool isConnected(const int& cell_index_a, const int& cell_index_b) const
+                {
+                    return labels[cell_index_a] != Constants::INDEX_NOT_FOUND && labels[cell_index_a] == labels[cell_index_b];
+                }
+
+                int getNumberComponents() const { return static_cast<int>(component_sizes.size()); }
+
+                // getComponentSizes function that returns the number of cells
+                // of every component
+                const std::vector<std::int64_t>& getComponentSizes() const { return component_sizes; }
+
+            private:
+                ScratchArray<int> labels;
+                std::vector<std::int64_t> component_sizes;
+        };
+
+        // NeighborMask class that holds one byte per cell index of a grid
+        // map with a bit for every free neighbor of the cell, in the order
+        // left, right, top and bottom. The masks are computed one row at a
+        // time with a branch free loop the compiler can vectorize, and give
+        // the successors of a cell with a single load.
+        class NeighborMask
+        {
+            public:
+                static constexpr std::uint8_t LEFT = 1;
+                static constexpr std::uint8_t RIGHT = 2;
+                static constexpr std::uint8_t TOP = 4;
+                static constexpr std::uint8_t BOTTOM = 8;
+
+                NeighborMask();
+                NeighborMask(GridMap const& grid_map);
+                NeighborMask(NeighborMask&& neighbor_mask) noexcept = default;
+                NeighborMask& operator=(NeighborMask&& neighbor_mask) noexcept = default;
+                ~NeighborMask();
+
+                // getMask function that returns the free neighbors of a cell index
+                const std::uint8_t& getMask(const int& cell_index) const { return masks[cell_index]; }
+
+                // getDegree function that returns the number of free neighbors
+                // of a cell index
+                int getDegree(const int& cell_index) const { return __builtin_popcount(masks[cell_index]); }
+
+                // updateCell function that computes the masks of a changed
+                // cell and of its neighbors again
+                void updateCell(GridMap const& grid_map, const int& row_index, const int& col_index);
+
+            private:
+                ScratchArray<std::uint8_t> masks;
+        };
+
+        // RegionKind enum that tells a room from a corridor. A free cell is
+        // part of a room if it is a corner of a square of 2x2 free cells,
+        // all other free cells are part of corridors.
+        enum class RegionKind
+        {
+            ROOM,
+            CORRIDOR
+        };
+
+        // Region struct that holds the kind, the bounding rectangle and the
+        // number of cells of a region
+        struct Region
+        {
+            RegionKind kind;
+            int top_row_index;
+            int left_col_index;
+            int bottom_row_index;
+            int right_col_index;
+            std::int64_t number_cells;
+
+            // isRectangle function that returns true if the region fills its
+            // bounding rectangle
+            bool isRectangle() const { return number_cells == static_cast<std::int64_t>(bottom_row_index - top_row_index + 1) * (right_col_index - left_col_index + 1); }
+        };
+
+        // Door struct that holds two neighboring cells of different regions,
+        // as row and column indices
+        struct Door
+        {
+            int region_a;
+            int region_b;
+            std::pair<int, int> cell_a;
+            std::pair<int, int> cell_b;
+        };
+
+        // RegionIndex class that splits the free cells of a grid map into
+        // rooms and corridors with one flood fill per region, and keeps the
+        // doors between them as a compact graph. The regions a path has to
+        // cross are found by a breadth first search over the regions instead
+        // of over the cells. Walls have the region Constants::INDEX_NOT_FOUND.
+        class RegionIndex
+        {
+            public:
+                RegionIndex();
+                RegionIndex(GridMap const& grid_map);
+                RegionIndex(RegionIndex&& region_index) noexcept = default;
+                RegionIndex& operator=(RegionIndex&& region_index) noexcept = default;
+                ~RegionIndex();
+
+                // getRegion function that returns the region of a cell index
+                const int& getRegion(const int& cell_index) const { return labels[cell_index]; }
+
+                int getNumberRegions() const { return static_cast<int>(regions.size()); }
+                const Region& getRegionInfo(const int& region) const { return regions[region]; }
+                const std::vector<Region>& getRegions() const { return regions; }
+                const std::vector<Door>& getDoors() const { return doors; }
+
+                // getRegionDoors function that returns the doors of a region,
+                // which are its entrances and exits
+                std::vector<Door> getRegionDoors(const int& region) const;
+
+                // findRoute function that writes the doors of a route from one
+                // region to another that crosses the fewest regions. Returns
+                // false if there is no route.
+                bool findRoute(const int& from_region, const int& to_region, std::vector<Door>& route) const;
+
+            private:
+                ScratchArray<int> labels;
+                std::vector<Region> regions;
+                std::vector<Door> doors;
+
+                // the doors of region r are door_indices[door_offsets[r]]
+                // up to door_indices[door_offsets[r + 1]]
+                std::vector<int> door_offsets;
+                std::vector<int> door_indices;
+        };
+
+        // MapLoadMode enum that selects how a map file is loaded. COPY
+        // converts the cells into an owned grid map, ZERO_COPY keeps the
+        // mapped file and reads the ASCII cells in place.
+        enum class MapLoadMode
+        {
+            COPY,
+            ZERO_COPY
+        };
+
+        // SearchAlgorithm enum that selects the search used to solve a maze.
+        // All but HIERARCHICAL return a shortest path. JPS expands far fewer
+        // cells on open maps, the bidirectional searches grow a second
+        // frontier from the end cell and explore less of long corridor
+        // mazes. HIERARCHICAL searches the precomputed sector graph of the
+        // grid, which is built by the first query that uses it. DIJKSTRA is
+        // A* without a heuristic. CORRIDOR_GRAPH runs A* over the junctions
+        // and dead ends of the grid, with every corridor contracted into one
+        // edge, and is also built by its first query. PARALLEL_BFS expands
+        // the breadth first levels from the end cell on several threads.
+        enum class SearchAlgorithm
+        {
+            ASTAR,
+            JPS,
+            BIDIRECTIONAL_BFS,
+            BIDIRECTIONAL_ASTAR,
+            HIERARCHICAL,
+            DIJKSTRA,
+            CORRIDOR_GRAPH,
+            PARALLEL_BFS
+        };
+
+        // Connectivity enum that selects the moves of a search. EIGHT adds
+        // diagonal steps between cells whose two common neighbors are free,
+        // EIGHT_CUTTING_CORNERS needs only one of them to be free. Only
+        // ASTAR and DIJKSTRA support diagonal steps.
+        enum class Connectivity
+        {
+            FOUR,
+            EIGHT,
+            EIGHT_CUTTING_CORNERS
+        };
+
+        // SearchHeuristic enum that selects the heuristic of ASTAR. OCTILE is
+        // the Manhattan distance without diagonal steps and keeps the paths
+        // shortest. MANHATTAN overestimates diagonal steps, so with them it
+        // expands fewer cells but may return longer paths. ZERO expands like
+        // DIJKSTRA, which always searches without a heuristic.
+        enum class SearchHeuristic
+        {
+            OCTILE,
+            MANHATTAN,
+            ZERO
+        };
+
+        // SolveOptions struct that selects how a path query is answered.
+        // findPaths answers the queries on number_threads threads, and a
+        // single PARALLEL_BFS query is searched on them; 0 uses one thread
+        // per hardware thread.
+        struct SolveOptions
+        {
+            SearchAlgorithm search_algorithm = SearchAlgorithm::ASTAR;
+            Connectivity connectivity = Connectivity::FOUR;
+            SearchHeuristic heuristic = SearchHeuristic::OCTILE;
+            int number_threads = 1;
+        };
+
+        // SolveStats struct that holds where the time of a solve went, in
+        // milliseconds, and the counters of its search. Loading reads and
+        // checks the map file, indexing builds the wall bitmap and the
+        // connected components, validating checks the cells of a query.
+        struct SolveStats
+        {
+            double load_milliseconds = 0.0;
+            double index_milliseconds = 0.0;
+            double endpoint_milliseconds = 0.0;
+            double validate_milliseconds = 0.0;
+            double search_milliseconds = 0.0;
+            maze::graph::SearchStats search_stats;
+        };
+
+        // writeSolveStats function that writes the stats of a solve, one
+        // counter per line
+        void writeSolveStats(std::ostream& output_stream, SolveStats const& stats);
+
+        // PackedPath class that holds a path of steps between side neighbors
+        // as its start cell and a 2-bit move per step, 32 moves to a 64-bit
+        // word, instead of 8 bytes per cell. The moves are left, right, up
+        // and down, in the order of the neighbor mask bits.
+        class PackedPath
+        {
+            public:
+                static constexpr std::uint8_t LEFT = 0;
+                static constexpr std::uint8_t RIGHT = 1;
+                static constexpr std::uint8_t UP = 2;
+                static constexpr std::uint8_t DOWN = 3;
+                static constexpr int MOVES_PER_WORD = 32;
+
+                PackedPath();
+                PackedPath(const int& start_row_index, const int& start_col_index);
+
+                // PackedPath constructor that packs a path of cells, throws
+                // invalid_argument if two cells of it are not side neighbors
+                explicit PackedPath(std::vector<std::pair<int, int>> const& path);
+
+                // PackedPath constructor that makes a path of number_moves
+                // moves between two cells, whose moves are then set with
+                // setMove, so that a path can be written from its end, such
+                // as from a chain of parent cells
+                PackedPath(std::pair<int, int> const& start_cell, std::pair<int, int> const& end_cell, const std::int64_t& number_moves);
+
+                // getMoveBetween function that returns the move from a cell to
+                // a side neighbor, throws invalid_argument for other cells
+                static std::uint8_t getMoveBetween(std::pair<int, int> const& cell, std::pair<int, int> const& next_cell);
+
+                // reserve function that makes room for number_moves moves in
+                // all, so that adding them does not reallocate
+                void reserve(const std::int64_t& number_moves);
+
+                // addMove function that appends a step to the end of the path
+                void addMove(const std::uint8_t& move);
+
+                // setMove function that sets the move of a step
+                void setMove(const std::int64_t& step_index, const std::uint8_t& move);
+
+                // append function that appends a path starting at the end cell
+                void append(PackedPath const& path);
+
+                // reverse function that turns the path around, so that it runs
+                // from the end cell back to the start cell
+                void reverse();
+
+                // getMove function that returns the move of a step
+                std::uint8_t getMove(const std::int64_t& step_index) const { return (words[step_index / MOVES_PER_WORD] >> (2 * (step_index % MOVES_PER_WORD))) & 3; }
+
+                // unpack function that returns the cells of the path
+                std::vector<std::pair<int, int>> unpack() const;
+
+                bool empty() const { return start_cell.first == Constants::INDEX_NOT_FOUND; }
+                std::int64_t getNumberCells() const { return empty() ? 0 : number_moves + 1; }
+                const std::int64_t& getNumberMoves() const { return number_moves; }
+                const std::pair<int, int>& getStartCell() const { return start_cell; }
+                const std::pair<int, int>& getEndCell() const { return end_cell; }
+                const std::vector<std::uint64_t>& getWords() const { return words; }
+
+            private:
+                std::pair<int, int> start_cell;
+                std::pair<int, int> end_cell;
+                std::int64_t number_moves;
+                std::vector<std::uint64_t> words;
+        };
+
+        // PathFormat enum that selects how a path is written. TEXT is the
+        // list of cells printed by the solver, RLE the start cell and the
+        // moves with their run lengths, such as R3D12L, JSON the same as one
+        // object and BINARY the start cell and the packed moves.
+        enum class PathFormat
+        {
+            TEXT,
+            RLE,
+            JSON,
+            BINARY
+        };
+
+        // writePath function that formats a path into one buffer and writes
+        // it to the stream at once. An empty path is written as a message,
+        // as null or as a binary path without cells.
+        void writePath(std::ostream& output_stream, PackedPath const& path, const PathFormat& format);
+
+        // writePath function that writes a path of cells. Paths with diagonal
+        // steps can not be packed, they are written in the TEXT format and
+        // throw invalid_argument in the others.
+        void writePath(std::ostream& output_stream, std::vector<std::pair<int, int>> const& path, const PathFormat& format);
+
+        // readPath function that reads a path written with the BINARY format,
+        // throws invalid_argument if the data is not a binary path
+        PackedPath readPath(std::istream& input_stream);
+
+        // PathQuery struct that holds the start and end cell of a query as
+        // row and column indices
+        struct PathQuery
+        {
+            std::pair<int, int> start_cell;
+            std::pair<int, int> end_cell;
+        };
+
+        // CellUpdate struct that holds the new state of one cell, given by
+        // its row and column index
+        struct CellUpdate
+        {
+            int row_index;
+            int col_index;
+            bool is_wall;
+        };
+
+        // readPathQueries function that reads one query per line, given as
+        // the start row, start column, end row and end column separated by
+        // white space. Empty lines and lines starting with '#' are skipped.
+        std::vector<PathQuery> readPathQueries(std::istream& query_stream);
+
+        // readMap function that maps the map file, validates it and returns
+        // the flat grid map. Binary map files are detected and always copied.
+        GridMap readMap(std::filesystem::path const& filepath, const MapLoadMode& load_mode = MapLoadMode::COPY);
+
+        // writeMap function that writes a grid map as a text map file
+        void writeMap(std::filesystem::path const& filepath, GridMap const& grid_map);
+
+        // readMapToDisk function that reads a text map row by row from a
+        // stream, for example stdin, and writes the converted rows into a
+        // scratch file. Only one row is held in memory while reading, the
+        // returned grid map is disk backed.
+        GridMap readMapToDisk(std::istream& map_stream);
+
+        // MapRowStream class that reads the rows of a text map one at a time
+        // from a stream and keeps only the last window_size rows in memory.
+        // Rows are validated as they are read. Reading a row that has already
+        // left the window throws std::out_of_range.
+        class MapRowStream
+        {
+            public:
+                MapRowStream(std::istream& map_stream, const int& window_size = 1024);
+                ~MapRowStream();
+
+                // readRow function that reads the next row into the window,
+                // returns false at the end of the stream
+                bool readRow();
+
+                // ensureRow function that reads rows until the given row is in
+                // the window, returns false if the stream ends before it
+                bool ensureRow(const int& row_index);
+
+                // isFree function that returns true if a cell is free, reading
+                // rows as needed. Cells outside the map are walls.
+                bool isFree(const int& row_index, const int& col_index);
+
+                // getRow function that returns a row that is in the window
+                const std::uint8_t* getRow(const int& row_index) const;
+
+                const int& getNumberCols() const { return number_cols; }
+                const int& getNumberRowsRead() const { return number_rows_read; }
+                const int& getWindowSize() const { return window_size; }
+                const bool& isExhausted() const { return is_exhausted; }
+
+            private:
+                std::istream& map_stream;
+                int window_size;
+                int number_cols;
+                int number_rows_read;
+                bool is_exhausted;
+                std::vector<std::uint8_t> window;
+                std::string map_row;
+        };
+
+        // streamSearchARowForEmptySpace, streamWalkThroughHallway and
+        // streamFindWindingPath functions that solve user stories 1, 2 and 4
+        // while reading the map through a MapRowStream. The winding path
+        // starts at the same cell as Grid::findWindingPath. Unless that cell
+        // is on the first row or column, the whole map is read to find it,
+        // and it must still be in the window afterwards.
+        int streamSearchARowForEmptySpace(MapRowStream& map_stream, const int& row_index);
+        std::vector<std::pair<int, int>> streamWalkThroughHallway(MapRowStream& map_stream);
+        std::vector<std::pair<int, int>> streamFindWindingPath(MapRowStream& map_stream);
+
+        // MazeKind enum that selects the layout of a generated maze
+        enum class MazeKind
+        {
+            BACKTRACKER,    // perfect maze carved by a recursive backtracker
+            KRUSKAL,        // perfect maze built by Kruskal's algorithm
+            ROOM,           // open room with an entrance and an exit
+            OBSTACLES,      // open field with randomly placed walls
+            WINDING         // single serpentine path without forks
+        };
+
+        // generateMaze function that generates a maze of the given kind and
+        // size. The maze only depends on the seed, so the same arguments give
+        // the same maze on every platform. The entrance is on the first row
+        // or column and the exit on the last row or column, so every kind
+        // can be solved by Grid::solveMaze. Rows and columns must be at least 4.
+        GridMap generateMaze(const MazeKind& maze_kind, const int& number_rows, const int& number_cols, const std::uint64_t& seed);
+
+        // BinaryMapHeader struct that is stored at the start of a binary map
+        // file. The header is followed by number_rows rows of words_per_row
+        // little endian 64-bit words with one bit per cell, set for walls,
+        // the same layout as the rows of a WallBitmap. The checksum is a
+        // 64-bit FNV-1a hash over the header, with the checksum field set to
+        // zero, and the payload words. Endpoints that are not stored are
+        // Constants::INDEX_NOT_FOUND.
+        struct BinaryMapHeader
+        {
+            static constexpr char MAGIC[4] = {'M', 'A', 'Z', 'B'};
+            static constexpr std::uint32_t VERSION = 2;
+
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t number_rows;
+            std::int32_t number_cols;
+            std::int32_t start_row_index;
+            std::int32_t start_col_index;
+            std::int32_t end_row_index;
+            std::int32_t end_col_index;
+            std::int32_t words_per_row;
+            std::uint32_t reserved;
+            std::uint64_t checksum;
+        };
+
+        // computeChecksum function that returns the FNV-1a hash of a block of
+        // words, continuing from a previous hash if one is given
+        std::uint64_t computeChecksum(const std::uint64_t* words, const std::size_t& number_words, const std::uint64_t& checksum = 14695981039346656037ULL);
+
+        // isBinaryMap function that returns true if the file starts with
+        // the binary map magic
+        bool isBinaryMap(std::filesystem::path const& filepath);
+
+        // readBinaryMap function that maps a binary map file, verifies the
+        // header and the checksum and expands the bitmap into a grid map. The
+        // stored rows are also copied into wall_bitmap if it is not nullptr.
+        GridMap readBinaryMap(std::filesystem::path const& filepath, BinaryMapHeader& header, WallBitmap* wall_bitmap = nullptr);
+
+        // writeBinaryMap function that writes the rows of a wall bitmap and
+        // the given endpoints as a binary map file
+        void writeBinaryMap(std::filesystem::path const& filepath, WallBitmap const& wall_bitmap, const std::pair<int, int>& start_cell, const std::pair<int, int>& end_cell);
+
         // Grid class that holds the grid map and provides
         // methods to access the grid map. Additionally, it
         // provides methods to search the grid map.
         class Grid
         {
             public:
-                Grid(std::string const& map_file_path);
+                Grid(std::string const& map_file_path, const MapLoadMode& load_mode = MapLoadMode::COPY);
+                Grid(std::istream& map_stream);
                 ~Grid();
 
-                const std::vector<std::vector<int>>& getGridMap() const;
+                // getGridMap function that returns a copy of the grid map
+                // as a 2D vector of integers, kept for compatibility
+                std::vector<std::vector<int>> getGridMap() const;
+
+                // getFlatGridMap function that returns the flat grid map
+                const GridMap& getFlatGridMap() const;
+
+                // getComponentIndex function that returns the connected
+                // components of the grid map, built when it is loaded
+                const ComponentIndex& getComponentIndex() const;
+
+                // getNeighborMask function that returns the free neighbors of
+                // every cell of the grid map, built when it is loaded
+                const NeighborMask& getNeighborMask() const;
 
                 // initializeGridMap function that initializes the grid map
                 // from the map file
-                void initializeGridMap(std::string const& map_file_path);
+                void initializeGridMap(std::string const& map_file_path, const MapLoadMode& load_mode = MapLoadMode::COPY);
+
+                // initializeGridMap function that initializes the grid map from
+                // a stream, the grid map is stored on disk while it is read
+                void initializeGridMap(std::istream& map_stream);
+
+                // saveBinaryMap function that writes the grid map, together with
+                // its start and end cells, as a binary map file
+                void saveBinaryMap(std::string const& binary_map_file_path) const;
 
                 // searchARowForEmptySpace function that searches
                 // a row of the grid map for empty space
@@ -65,38 +884,326 @@ namespace maze
                 // of integers. Each pair represents a cell in the grid map
                 // that is part of the hallway
                 std::vector<std::pair<int, int>> walkThrouhHallway() const;
+                PackedPath walkThroughHallwayPacked() const;
                 
                 // findPathToAndOutOfRoom function that returns a vector of pairs
                 // of integers. Each pair represents a cell in the grid map
                 // that is part of the path into and out of the room in the maze.
+                // The room is the first room of the region index, entered by
+                // the door of its top left corner and left by the door of its
+                // bottom right corner.
                 std::vector<std::pair<int, int>> findPathToAndOutOfRoom() const;
+                PackedPath findPathToAndOutOfRoomPacked() const;
 
                 // findWindingPath function that returns a vector of pairs
                 // of integers. Each pair represents a cell in the grid map
                 // that is part of the winding path in the maze.
                 std::vector<std::pair<int, int>> findWindingPath() const;
+                PackedPath findWindingPathPacked() const;
 
                 // solveMaze function that returns a vector of pairs
                 // of integers. Each pair represents a cell in the grid map
                 // that is part of the path from the start to the end of the maze.
-                std::vector<std::pair<int, int>> solveMaze() const;
+                // The time spent and the search counters are written to stats
+                // if it is not nullptr.
+                std::vector<std::pair<int, int>> solveMaze(const SearchAlgorithm& search_algorithm = SearchAlgorithm::ASTAR, SolveStats* stats = nullptr) const;
+                std::vector<std::pair<int, int>> solveMaze(SolveOptions const& options, SolveStats* stats = nullptr) const;
+
+                // solveMazePacked function that solves the maze like solveMaze
+                // and returns the path packed, which is empty if there is none
+                // or if it has diagonal steps
+                PackedPath solveMazePacked(SolveOptions const& options = SolveOptions(), SolveStats* stats = nullptr) const;
+
+                // findPath function that returns a path between any two cells
+                // of the grid map, or an empty path if there is none. The time
+                // spent and the search counters are added to stats if it is
+                // not nullptr.
+                std::vector<std::pair<int, int>> findPath(std::pair<int, int> const& start_cell, std::pair<int, int> const& end_cell, SolveOptions const& options = SolveOptions(), SolveStats* stats = nullptr) const;
+
+                // findPathPacked function that finds a path like findPath and
+                // returns it packed. A*, Dijkstra's algorithm and JPS write the
+                // moves while they trace the path back, the other searches
+                // pack their cells.
+                PackedPath findPathPacked(std::pair<int, int> const& start_cell, std::pair<int, int> const& end_cell, SolveOptions const& options = SolveOptions(), SolveStats* stats = nullptr) const;
+
+                // computeDistanceField function that returns the distance of
+                // every free cell to the end cell of the maze, computed on
+                // number_threads threads, or nullptr if there is no end cell
+                std::unique_ptr<maze::graph::DistanceField> computeDistanceField(const int& number_threads = 0) const;
+
+                // findPaths function that answers many queries on the loaded
+                // grid map. Every thread reuses its search workspace and all
+                // of them share the hierarchical map. The paths are in the
+                // order of the queries.
+                std::vector<std::vector<std::pair<int, int>>> findPaths(std::vector<PathQuery> const& queries, SolveOptions const& options = SolveOptions()) const;
+                std::vector<PackedPath> findPathsPacked(std::vector<PathQuery> const& queries, SolveOptions const& options = SolveOptions()) const;
+
+                // setCell and setCells functions that turn cells into walls or
+                // free cells and update the indexes of the grid map. A batch
+                // rebuilds the connected components once. Returns false, and
+                // changes nothing, if a cell is out of bounds. Must not run
+                // while queries are answered.
+                bool setCell(const int& row_index, const int& col_index, const bool& is_wall);
+                bool setCells(std::vector<CellUpdate> const& cell_updates);
+
+                // getRegionIndex function that returns the rooms, corridors and
+                // doors of the grid map, built by the first call
+                const RegionIndex& getRegionIndex() const;
+
+                // findRoomRoute function that returns the doors a path between
+                // two cells passes through, in order, crossing the fewest rooms
+                // and corridors, or an empty route if the cells are in the same
+                // region or not connected
+                std::vector<Door> findRoomRoute(std::pair<int, int> const& start_cell, std::pair<int, int> const& end_cell) const;
 
             private:
-                std::vector<std::vector<int>> grid_map;
+                GridMap grid_map;
+                WallBitmap wall_bitmap;
+                ComponentIndex component_index;
+                NeighborMask neighbor_mask;
                 bool is_initialized;
 
+                // the time spent loading the grid map and building its indexes
+                double load_milliseconds = 0.0;
+                double index_milliseconds = 0.0;
+
+                // the hierarchical map is built by the first query that needs it
+                mutable std::mutex hierarchy_mutex;
+                mutable std::unique_ptr<maze::graph::HierarchicalMap> hierarchical_map;
+
+                // the corridor graph is built by the first query that uses it
+                mutable std::mutex corridor_mutex;
+                mutable std::unique_ptr<maze::graph::CorridorGraph> corridor_graph;
+
+                // the region index is built by the first call that needs it
+                mutable std::mutex region_mutex;
+                mutable std::unique_ptr<RegionIndex> region_index;
+
+                std::pair<int, int> stored_start_cell;
+                std::pair<int, int> stored_end_cell;
+
+                // loadGridMap function that reads a text or binary map file
+                void loadGridMap(std::string const& map_file_path, const MapLoadMode& load_mode);
+
+                // findStartCell and findEndCell functions that return the stored
+                // endpoints, or search the first and last row and column
+                bool findStartCell(int& start_row_index, int& start_col_index) const;
+                bool findEndCell(int& end_row_index, int& end_col_index) const;
+
+                // buildSearchIndexes function that builds the structures
+                // derived from the grid map after it has been loaded. A wall
+                // bitmap read together with the map is kept.
+                void buildSearchIndexes(const bool& is_wall_bitmap_loaded = false);
+
+                // getHierarchicalMap function that returns the hierarchical
+                // map of the grid map and builds it on the first call
+                maze::graph::HierarchicalMap const& getHierarchicalMap() const;
+
+                // getCorridorGraph function that returns the corridor graph of
+                // the grid map and builds it on the first call
+                maze::graph::CorridorGraph const& getCorridorGraph() const;
+
+                // findMazeEndpoints function that finds the start and end cell
+                // of the maze for solveMaze and starts its stats, returns false
+                // if there are none
+                bool findMazeEndpoints(std::pair<int, int>& start_cell, std::pair<int, int>& end_cell, SolveStats* stats) const;
+
+                // searchPath, answerQueries, walkHallway, crossRoom and
+                // followWindingPath functions that do the work of findPath,
+                // findPaths, walkThrouhHallway, findPathToAndOutOfRoom and
+                // findWindingPath, writing the paths as cells or packed
+                template<typename Path>
+                void searchPath(std::pair<int, int> const& start_cell, std::pair<int, int> const& end_cell, SolveOptions const& options, SolveStats* stats, Path& path) const;
+                template<typename Path>
+                void answerQueries(std::vector<PathQuery> const& queries, SolveOptions const& options, std::vector<Path>& paths) const;
+                template<typename Path>
+                void walkHallway(Path& hallway_cells) const;
+                template<typename Path>
+                void crossRoom(Path& path) const;
+                template<typename Path>
+                void followWindingPath(Path& path) const;
+
                 // performColumnWalk function that performs a column walk
                 // in a hallway, starting from the given row and column index
-                void performColumnWalk(std::vector<std::pair<int, int>>& hallway_cells, const int& row_index, const int& col_index) const;
+                template<typename Path>
+                void performColumnWalk(Path& hallway_cells, const int& row_index, const int& col_index) const;
                 
                 // performRowWalk function that performs a row walk
                 // in a hallway, starting from the given row and column index
-                void performRowWalk(std::vector<std::pair<int, int>>& hallway_cells, const int& row_index, const int& col_index) const;
+                template<typename Path>
+                void performRowWalk(Path& hallway_cells, const int& row_index, const int& col_index) const;
 
                 // searchAColumnForEmptySpace function that searches
                 // a column of the grid map for empty space
                 int searchAColumnForEmptySpace(const int col_index) const;
         };
+
+        // WorkStealingPool class that runs a number of independent tasks on
+        // a set of threads. Every thread starts with its own contiguous share
+        // of the tasks and, once that is done, steals tasks from the back of
+        // the other threads' queues, so uneven tasks still keep all threads busy.
+        class WorkStealingPool
+        {
+            public:
+                // a number of threads of 0 uses one thread per hardware thread
+                WorkStealingPool(const int& number_threads = 0);
+                ~WorkStealingPool();
+
+                const int& getNumberThreads() const { return number_threads; }
+
+                // run function that calls task(task_index, thread_index) once
+                // for every task and returns when all tasks are done. The
+                // calling thread works as thread 0. The first exception thrown
+                // by a task is rethrown after all threads have stopped.
+                void run(const int& number_tasks, std::function<void(const int&, const int&)> const& task);
+
+            private:
+                struct TaskQueue
+                {
+                    std::mutex queue_mutex;
+                    std::deque<int> task_indices;
+                };
+
+                int number_threads;
+
+                // popTask function that takes the next task of a thread, from
+                // its own queue first and then from the other queues
+                bool popTask(std::vector<std::unique_ptr<TaskQueue>>& task_queues, const int& thread_index, int& task_index) const;
+        };
+
+        // BatchFormat enum that selects the output format of batch results
+        enum class BatchFormat
+        {
+            JSONL,
+            CSV
+        };
+
+        // BatchOptions struct that holds the settings of a batch run. The
+        // maps are solved on number_threads threads, each map with the
+        // solve options of user story 5.
+        struct BatchOptions
+        {
+            int user_story_id = 5;
+            int number_threads = 0;
+            MapLoadMode load_mode = MapLoadMode::COPY;
+            SolveOptions solve_options;
+        };
+
+        // BatchResult struct that holds the outcome of solving one map. The
+        // status is "solved", "no_path" or "invalid_map".
+        struct BatchResult
+        {
+            std::string map_file;
+            std::string status;
+            int path_length = 0;
+            double milliseconds = 0.0;
+        };
+
+        // collectMapFiles function that returns the map files of a batch. The
+        // source is a directory, which is searched recursively, a glob pattern
+        // or a manifest file with one map path per line. Relative manifest
+        // entries are relative to the manifest, lines starting with '#' are
+        // skipped. The files of a directory or glob are sorted.
+        std::vector<std::filesystem::path> collectMapFiles(std::string const& source);
+
+        // solveMaps function that loads and solves every map on a work
+        // stealing pool. The results are in the order of the map files.
+        std::vector<BatchResult> solveMaps(std::vector<std::filesystem::path> const& map_files, BatchOptions const& options);
+
+        // writeBatchResults function that writes the results as JSON Lines or
+        // as CSV with a header row
+        void writeBatchResults(std::ostream& output_stream, std::vector<BatchResult> const& results, const BatchFormat& format);
+
+        // GridCache class that keeps the most recently used grids, loaded
+        // from map files, so that they are parsed and indexed once. A map is
+        // loaded again when its file has been written since it was cached.
+        // Threads asking for a map that is being loaded wait for that load.
+        class GridCache
+        {
+            public:
+                GridCache(const int& capacity = 64, const MapLoadMode& load_mode = MapLoadMode::COPY);
+                ~GridCache();
+
+                // getGrid function that returns the grid of a map file, or
+                // nullptr if the map file can not be loaded
+                std::shared_ptr<const Grid> getGrid(std::string const& map_file_path);
+
+                int getNumberGrids() const;
+                const int& getCapacity() const { return capacity; }
+                std::int64_t getNumberHits() const;
+                std::int64_t getNumberLoads() const;
+
+            private:
+                struct CacheEntry
+                {
+                    std::string map_file_key;
+                    std::filesystem::file_time_type write_time;
+                    std::int64_t load_id;
+                    std::shared_future<std::shared_ptr<const Grid>> grid;
+                };
+
+                int capacity;
+                MapLoadMode load_mode;
+                mutable std::mutex cache_mutex;
+
+                // the entries are ordered from the most to the least recently used
+                std::list<CacheEntry> entries;
+                std::unordered_map<std::string, std::list<CacheEntry>::iterator> entry_indices;
+                std::int64_t number_hits;
+                std::int64_t number_loads;
+        };
+
+        // ServerOptions struct that holds the settings of a solver server. The
+        // search options apply to every request, each solved on one thread.
+        struct ServerOptions
+        {
+            std::string socket_path;
+            int number_threads = 0;
+            int cache_capacity = 64;
+            MapLoadMode load_mode = MapLoadMode::COPY;
+            SolveOptions solve_options;
+            PathFormat path_format = PathFormat::TEXT;
+        };
+
+        // SolverServer class that answers solve requests on a Unix domain
+        // socket. A request is one line, either "<map_file> <user_story>" or
+        // "<map_file> <start_row> <start_col> <end_row> <end_col>", and its
+        // response is the path in the path format of the server, or a line
+        // "error <message>". Every thread of the server serves one connection
+        // at a time, the grids are shared through a grid cache.
+        class SolverServer
+        {
+            public:
+                SolverServer(ServerOptions const& options);
+                ~SolverServer();
+
+                // run function that listens on the socket and serves requests
+                // until stop is called. Throws invalid_argument if the socket
+                // path is too long and system_error if the socket can not be
+                // opened.
+                void run();
+
+                // stop function that closes the socket and all connections, it
+                // can be called from any thread
+                void stop();
+
+                // answerRequest function that writes the response to a request
+                void answerRequest(std::string const& request, std::ostream& response_stream);
+
+                GridCache const& getGridCache() const { return grid_cache; }
+
+            private:
+                ServerOptions options;
+                GridCache grid_cache;
+                std::atomic<bool> is_stopping;
+                std::mutex connection_mutex;
+                int listen_fd;
+                std::vector<int> connection_fds;
+
+                // serveConnection function that answers the requests of one
+                // connection until the client closes it
+                void serveConnection(const int& connection_fd);
+        };
     }
 
     namespace graph
@@ -106,7 +1213,32 @@ namespace maze
         // of integers. Each pair represents a cell in the grid map
         // that is part of the path. DFS is rejected if there are forks.
         // See assumption in the README.md file.
-        void performSimpleDFS(std::vector<std::vector<int>> const& grid_map, const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path);
+        void performSimpleDFS(grid::GridMap const& grid_map, const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        void performSimpleDFS(std::vector<std::vector<int>> const& grid_map, const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+
+        // CorridorStatus enum that tells how following a corridor ended.
+        // COMPLETE and CYCLE leave every cell of the corridor in the path,
+        // FORK and INVALID_START leave the path empty.
+        enum class CorridorStatus
+        {
+            COMPLETE,       // the corridor ended at dead ends
+            CYCLE,          // the corridor closed a loop back to the start
+            FORK,           // a cell of the corridor has more than two neighbors
+            INVALID_START   // the start cell is out of bounds
+        };
+
+        // followCorridor function that follows a one cell wide path from a
+        // cell, in the same order as performSimpleDFS. Only the direction it
+        // came from is kept per step, the neighbors of a cell are read as a
+        // bitmask, and forks are reported through the status, so the loop
+        // neither allocates, other than to grow the path, nor throws. Given
+        // the neighbor mask of the grid map, the masks are not computed. The
+        // packed path is replaced and holds the same cells, written as moves;
+        // a corridor that runs both ways from the start cell is written from
+        // the end of its second branch, so that it stays one path.
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& row_index, const int& col_index, grid::PackedPath& path, SearchStats* stats = nullptr);
 
         // Node class that represents a node in the A* algorithm
         class Node
@@ -142,9 +1274,614 @@ namespace maze
                 int parent_row_index;
                 int parent_col_index;
         };
-        
-        // performAStar function that performs the A* algorithm
-        void performAStar(std::vector<std::vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path);
+
+        // IndexedPriorityQueue class that represents a binary min heap
+        // of integer keys (cell ids) in the range [0, capacity). The heap
+        // keeps the position of every key so that membership checks are O(1)
+        // and push, pop and decreaseKey are O(log n). Entries are ordered
+        // by priority first and by tie breaker second.
+        class IndexedPriorityQueue
+        {
+            public:
+                IndexedPriorityQueue(const int& capacity = 0);
+                ~IndexedPriorityQueue();
+
+                // reset function that empties the heap and resizes the
+                // position index to hold the given number of keys. The index
+                // is kept in a scratch file on disk if use_disk is true.
+                void reset(const int& capacity, const bool& use_disk = false);
+
+                bool empty() const;
+                int size() const;
+                const int& capacity() const;
+
+                // contains function that returns true if the key is queued
+                bool contains(const int& key) const;
+
+                // push function that inserts a key that is not queued yet
+                void push(const int& key, const int& priority, const int& tie_breaker);
+
+                // decreaseKey function that lowers the priority of a queued key
+                void decreaseKey(const int& key, const int& priority, const int& tie_breaker);
+
+                // updateKey function that raises or lowers the priority of a
+                // queued key
+                void updateKey(const int& key, const int& priority, const int& tie_breaker);
+
+                // remove function that removes a queued key
+                void remove(const int& key);
+
+                // top function that returns the key with the lowest priority
+                const int& top() const;
+
+                // topPriority and topTieBreaker functions that return the
+                // priority and tie breaker of the top key
+                const int& topPriority() const;
+                const int& topTieBreaker() const;
+
+                // pop function that removes and returns the key with the lowest priority
+                int pop();
+
+            private:
+                struct Entry
+                {
+                    int priority;
+                    int tie_breaker;
+                    int key;
+                };
+
+                std::vector<Entry> heap;
+                grid::ScratchArray<int> positions;
+                int key_capacity;
+
+                // isLess function that compares two heap entries
+                static bool isLess(const Entry& lhs, const Entry& rhs);
+
+                // siftUp and siftDown functions that restore the heap property
+                void siftUp(int heap_index);
+                void siftDown(int heap_index);
+        };
+
+        // SearchWorkspace class that holds the per-cell state of a search,
+        // the open list and a cell stack, so that the next query can reuse
+        // them. A cell only has a valid g-score and parent while its visit
+        // stamp equals the generation of the current query, so starting a
+        // query does not clear the arrays. They are only reallocated when a
+        // grid map has more cells or a different storage. Every thread has
+        // its own workspace, which performAStar and performSimpleDFS use.
+        class SearchWorkspace
+        {
+            public:
+                SearchWorkspace();
+                ~SearchWorkspace();
+
+                // prepare function that starts a new query on a grid map with
+                // the given number of cell indices. The state is kept in
+                // scratch files on disk if use_disk is true. Returns the number
+                // of bytes allocated, 0 if the workspace was large enough.
+                std::size_t prepare(const int& number_cells, const bool& use_disk = false);
+
+                // reach function that records the g-score and the parent of a cell
+                void reach(const int& cell, const int& g_score, const int& parent_cell)
+                {
+                    visit_stamps[cell] = generation;
+                    g_scores[cell] = g_score;
+                    parent_cells[cell] = parent_cell;
+                }
+
+                bool isReached(const int& cell) const { return visit_stamps[cell] == generation; }
+                const int& getGScore(const int& cell) const { return g_scores[cell]; }
+                const int& getParentCell(const int& cell) const { return parent_cells[cell]; }
+                IndexedPriorityQueue& getOpenList() { return open_list; }
+                std::vector<int>& getCellStack() { return cell_stack; }
+
+                // buildPath function that writes the path from the start cell
+                // to a reached end cell by following the parent cells back.
+                // The packed path is written from its end without reversing
+                // and throws invalid_argument for diagonal steps.
+                void buildPath(grid::GridMap const& grid_map, const int& start_cell, const int& end_cell, std::vector<std::pair<int, int>>& path) const;
+                void buildPath(grid::GridMap const& grid_map, const int& start_cell, const int& end_cell, grid::PackedPath& path) const;
+
+                // getThreadWorkspace function that returns the workspace of the calling thread
+                static SearchWorkspace& getThreadWorkspace();
+
+            private:
+                grid::ScratchArray<std::uint32_t> visit_stamps;
+                grid::ScratchArray<int> g_scores;
+                grid::ScratchArray<int> parent_cells;
+                std::uint32_t generation;
+                IndexedPriorityQueue open_list;
+                std::vector<int> cell_stack;
+        };
+
+        // getCellMove function that returns the packed move from a cell
+        // index to the index of a side neighbor, throws invalid_argument for
+        // other cells
+        std::uint8_t getCellMove(grid::GridMap const& grid_map, const int& cell, const int& next_cell);
+
+        // performAStar function that performs the A* algorithm. Given the
+        // neighbor mask of the grid map, the successors of a cell are read
+        // from its mask instead of from its four neighbors.
+        void performAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        void performAStar(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        void performAStar(std::vector<std::vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+
+        // FourConnected struct that is the neighbor policy of a search that
+        // moves left, right, up and down. A neighbor policy calls visit with
+        // every free neighbor of a cell and the cost of the step to it.
+        struct FourConnected
+        {
+            static constexpr int STRAIGHT_COST = 1;
+            static constexpr int DIAGONAL_COST = 2;
+
+            template<typename Visit>
+            void forEachNeighbor(grid::GridMap const& grid_map, const int& cell, Visit const& visit) const
+            {
+                const int row_stride = grid_map.getRowStride();
+                for(auto const& neighbor_cell : {cell - 1, cell + 1, cell - row_stride, cell + row_stride})
+                {
+                    if(grid_map.isFreeCell(neighbor_cell))
+                    {
+                        visit(neighbor_cell, STRAIGHT_COST);
+                    }
+                }
+            }
+        };
+
+        // MaskedFourConnected struct that is the neighbor policy of a search
+        // that moves like FourConnected and reads the free neighbors of a
+        // cell from the neighbor mask of the grid map
+        struct MaskedFourConnected
+        {
+            static constexpr int STRAIGHT_COST = 1;
+            static constexpr int DIAGONAL_COST = 2;
+
+            grid::NeighborMask const& neighbor_mask;
+
+            template<typename Visit>
+            void forEachNeighbor(grid::GridMap const& grid_map, const int& cell, Visit const& visit) const
+            {
+                // the bits of a mask are in the order of the offsets
+                const int neighbor_offsets[4] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+                for(unsigned mask = neighbor_mask.getMask(cell); mask != 0; mask &= mask - 1)
+                {
+                    visit(cell + neighbor_offsets[__builtin_ctz(mask)], STRAIGHT_COST);
+                }
+            }
+        };
+
+        // EightConnected struct that is the neighbor policy of a search that
+        // also moves diagonally, with 7 / 5 as the ratio of a diagonal to a
+        // straight step. A diagonal step needs both cells beside it to be
+        // free, or one of them if CUT_CORNERS is true, so it never squeezes
+        // between two walls and the connected components stay the same as
+        // for FourConnected.
+        template<bool CUT_CORNERS>
+        struct EightConnected
+        {
+            static constexpr int STRAIGHT_COST = 5;
+            static constexpr int DIAGONAL_COST = 7;
+
+            template<typename Visit>
+            void forEachNeighbor(grid::GridMap const& grid_map, const int& cell, Visit const& visit) const
+            {
+                const int row_stride = grid_map.getRowStride();
+                const bool is_left_free = grid_map.isFreeCell(cell - 1);
+                const bool is_right_free = grid_map.isFreeCell(cell + 1);
+                const bool is_top_free = grid_map.isFreeCell(cell - row_stride);
+                const bool is_bottom_free = grid_map.isFreeCell(cell + row_stride);
+
+                auto visitStraight = [&](const bool& is_free, const int& neighbor_cell)
+                {
+                    if(is_free)
+                    {
+                        visit(neighbor_cell, STRAIGHT_COST);
+                    }
+                };
+
+                auto visitDiagonal = [&](const bool& is_row_free, const bool& is_col_free, const int& neighbor_cell)
+                {
+                    if((CUT_CORNERS ? (is_row_free || is_col_free) : (is_row_free && is_col_free)) && grid_map.isFreeCell(neighbor_cell))
+                    {
+                        visit(neighbor_cell, DIAGONAL_COST);
+                    }
+                };
+
+                visitStraight(is_left_free, cell - 1);
+                visitStraight(is_right_free, cell + 1);
+                visitStraight(is_top_free, cell - row_stride);
+                visitStraight(is_bottom_free, cell + row_stride);
+                visitDiagonal(is_top_free, is_left_free, cell - row_stride - 1);
+                visitDiagonal(is_top_free, is_right_free, cell - row_stride + 1);
+                visitDiagonal(is_bottom_free, is_left_free, cell + row_stride - 1);
+                visitDiagonal(is_bottom_free, is_right_free, cell + row_stride + 1);
+            }
+        };
+
+        // ManhattanHeuristic, OctileHeuristic and ZeroHeuristic structs that
+        // estimate the cost between two cells from their row and column
+        // distance, in the step costs of a neighbor policy. Octile is exact
+        // on an open map with diagonal steps, ZeroHeuristic turns A* into
+        // Dijkstra's algorithm.
+        template<typename Neighbors>
+        struct ManhattanHeuristic
+        {
+            int operator()(const int& row_distance, const int& col_distance) const
+            {
+                return Neighbors::STRAIGHT_COST * (row_distance + col_distance);
+            }
+        };
+
+        template<typename Neighbors>
+        struct OctileHeuristic
+        {
+            int operator()(const int& row_distance, const int& col_distance) const
+            {
+                return Neighbors::STRAIGHT_COST * std::abs(row_distance - col_distance) + Neighbors::DIAGONAL_COST * std::min(row_distance, col_distance);
+            }
+        };
+
+        struct ZeroHeuristic
+        {
+            int operator()(const int&, const int&) const
+            {
+                return 0;
+            }
+        };
+
+        // performGridSearch function that performs A* with a neighbor policy
+        // and a heuristic that are chosen at compile time, so both are inlined
+        // into the loop. Ties between equal f-scores go to the cell with the
+        // lower heuristic, which is closer to the end. The path is shortest
+        // if the heuristic is consistent with the step costs, which all of
+        // the above are except ManhattanHeuristic with diagonal steps.
+        template<typename Neighbors, typename Heuristic, typename Path>
+        void performGridSearch(grid::GridMap const& grid_map, Neighbors const& neighbors, Heuristic const& heuristic, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats = nullptr)
+        {
+            if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+            {
+                throw std::invalid_argument("Invalid start cell.");
+            }
+
+            if(end_row_index < 0 || end_row_index >= grid_map.getNumberRows() || end_col_index < 0 || end_col_index >= grid_map.getNumberCols())
+            {
+                throw std::invalid_argument("Invalid end cell.");
+            }
+
+            // every cell is identified by its index in the padded grid map,
+            // which is used as the key in the open list and in the flat arrays
+            int number_cells = grid_map.getNumberCellIndices();
+            int start_cell = grid_map.getCellIndex(start_row_index, start_col_index);
+            int end_cell = grid_map.getCellIndex(end_row_index, end_col_index);
+
+            recordSearch(stats, [&](auto& recorder)
+            {
+                // the state is kept in the workspace of the thread, so repeated
+                // searches do not allocate. The state of a disk backed grid map
+                // is kept on disk as well and released after the search.
+                SearchWorkspace local_workspace;
+                SearchWorkspace& workspace = grid_map.isDiskBacked() ? local_workspace : SearchWorkspace::getThreadWorkspace();
+                recorder.allocate(workspace.prepare(number_cells, grid_map.isDiskBacked()));
+
+                IndexedPriorityQueue& open_list = workspace.getOpenList();
+                int start_h_score = heuristic(std::abs(start_row_index - end_row_index), std::abs(start_col_index - end_col_index));
+                workspace.reach(start_cell, 0, -1);
+                open_list.push(start_cell, start_h_score, start_h_score);
+                recorder.push(open_list.size());
+
+                while(!open_list.empty())
+                {
+                    int current_cell = open_list.pop();
+                    recorder.expand();
+
+                    if(current_cell == end_cell)
+                    {
+                        workspace.buildPath(grid_map, start_cell, end_cell, path);
+                        return;
+                    }
+
+                    int current_g_score = workspace.getGScore(current_cell);
+                    neighbors.forEachNeighbor(grid_map, current_cell, [&](const int& neighbor_cell, const int& step_cost)
+                    {
+                        int g_score = current_g_score + step_cost;
+
+                        // a reached node that is not queued any more is in the
+                        // closed list. The heuristic is consistent, so a shorter
+                        // path to a queued node only has to lower its key.
+                        if(!workspace.isReached(neighbor_cell) || (open_list.contains(neighbor_cell) && g_score < workspace.getGScore(neighbor_cell)))
+                        {
+                            int h_score = heuristic(std::abs(grid_map.getRowIndex(neighbor_cell) - end_row_index), std::abs(grid_map.getColIndex(neighbor_cell) - end_col_index));
+                            int f_score = g_score + h_score;
+
+                            if(open_list.contains(neighbor_cell))
+                            {
+                                open_list.decreaseKey(neighbor_cell, f_score, h_score);
+                                recorder.decreaseKey();
+                            }
+                            else
+                            {
+                                open_list.push(neighbor_cell, f_score, h_score);
+                                recorder.push(open_list.size());
+                            }
+                            workspace.reach(neighbor_cell, g_score, current_cell);
+                        }
+                    });
+                }
+            });
+        }
+
+        // performJumpPointSearch function that performs jump point search on
+        // the 4-connected grid. It returns a shortest path like performAStar,
+        // but only expands the cells where the path may have to turn, so
+        // straight corridors and open rooms are crossed without expansions.
+        void performJumpPointSearch(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        void performJumpPointSearch(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr);
+        void performJumpPointSearch(std::vector<std::vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+
+        // grid maps with at least this many cells are searched by the
+        // bidirectional BFS with one thread per frontier
+        constexpr int PARALLEL_SEARCH_CELLS = 1 << 20;
+
+        // performBidirectionalBFS function that performs a breadth first
+        // search from the start and the end cell at the same time, one level
+        // at a time, and stops once the frontiers have met. With
+        // use_two_threads each frontier is expanded on its own thread and the
+        // threads meet at a barrier after every level.
+        void performBidirectionalBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr, const bool& use_two_threads = false);
+        void performBidirectionalBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr, const bool& use_two_threads = false);
+
+        // performBidirectionalAStar function that performs A* from the start
+        // and from the end cell. It keeps the length of the shortest path
+        // found where the searches meet and stops once the lowest f-score of
+        // either open list is not below it, which keeps the path optimal.
+        void performBidirectionalAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+        void performBidirectionalAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr);
+
+        // HierarchicalMap class that answers repeated path queries on one
+        // grid map. The grid map is cut into square sectors. Pairs of free
+        // cells on both sides of a sector border are entrances, and the
+        // distances between the entrances of every sector are computed once
+        // when the map is built. A query connects its start and end cell to
+        // the entrances of their sectors, searches the small graph of
+        // entrances and refines every step of that path by a search inside
+        // one sector. Only the ends of a wide entrance are used, so a path
+        // can be slightly longer than the shortest one. The grid map must
+        // outlive the hierarchical map.
+        class HierarchicalMap
+        {
+            public:
+                static constexpr int DEFAULT_SECTOR_SIZE = 16;
+
+                HierarchicalMap(grid::GridMap const& grid_map, const int& sector_size = DEFAULT_SECTOR_SIZE);
+                ~HierarchicalMap();
+
+                // findPath function that finds a path between two cells. The
+                // map is only read, so several threads may query it at once.
+                void findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr) const;
+                void findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr) const;
+
+                const int& getSectorSize() const { return sector_size; }
+                int getNumberNodes() const { return static_cast<int>(node_cells.size()); }
+                int getNumberEdges() const;
+
+            private:
+                struct Edge
+                {
+                    int target_node;
+                    int cost;
+                };
+
+                grid::GridMap const& grid_map;
+                int sector_size;
+                int number_sector_rows;
+                int number_sector_cols;
+
+                // the cell of every node, the edges leaving every node and
+                // the nodes of every sector
+                std::vector<int> node_cells;
+                std::vector<std::vector<Edge>> node_edges;
+                std::vector<std::vector<int>> sector_nodes;
+
+                // getSector function that returns the sector of a cell
+                int getSector(const int& cell) const;
+
+                // addEntrances function that adds the nodes and edges of the
+                // entrances on the border between two neighboring sectors
+                void addEntrances(const int& first_cell, const int& step, const int& crossing_offset, const int& length, std::unordered_map<int, int>& cell_nodes);
+
+                // exploreSector function that runs a breadth first search
+                // from a cell that does not leave its sector. The distances
+                // and parents are left in the workspace. The search stops
+                // early once target_cell is reached, unless it is
+                // INDEX_NOT_FOUND.
+                void exploreSector(SearchWorkspace& workspace, const int& source_cell, const int& target_cell, SearchStats* stats) const;
+
+                // searchPath function that does the work of findPath, writing
+                // the path as cells or packed
+                template<typename Path>
+                void searchPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats) const;
+        };
+
+        // CorridorGraph class that contracts the corridors of a grid map. Every
+        // free cell that does not have exactly two free neighbors, a junction
+        // or a dead end, is a node, and every chain of cells with two free
+        // neighbors between two nodes is one edge weighted by its length. A
+        // query adds its start and end cell as extra nodes, searches the
+        // nodes with A* and walks the corridors of the found edges back into
+        // cells, so the path is a shortest one. The grid map and the neighbor
+        // mask must outlive the corridor graph.
+        class CorridorGraph
+        {
+            public:
+                CorridorGraph(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask);
+                ~CorridorGraph();
+
+                // findPath function that finds a shortest path between two
+                // cells. The graph is only read, so several threads may query
+                // it at once.
+                void findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr) const;
+                void findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr) const;
+
+                int getNumberNodes() const { return static_cast<int>(node_cells.size()); }
+                int getNumberEdges() const { return static_cast<int>(edges.size() / 2); }
+
+            private:
+                // Edge struct that holds the node at the other end of a
+                // corridor, its number of steps and the direction it leaves
+                // its first node in
+                struct Edge
+                {
+                    int target_node;
+                    int cost;
+                    int direction;
+                };
+
+                grid::GridMap const& grid_map;
+                grid::NeighborMask const& neighbor_mask;
+                std::array<int, 4> direction_offsets;
+
+                // the cell of every node, the node of every cell index and the
+                // edges of every node, those of node n are edges[edge_offsets[n]]
+                // up to edges[edge_offsets[n + 1]]. Every corridor is stored
+                // once from each of its ends.
+                std::vector<int> node_cells;
+                grid::ScratchArray<int> cell_nodes;
+                std::vector<int> edge_offsets;
+                std::vector<Edge> edges;
+
+                // walkCorridor function that steps from a cell in a direction
+                // and follows the corridor until it reaches a node, stop_cell
+                // or the cell it started from. The cell and direction are set
+                // to the last cell and step, and the number of steps is returned.
+                int walkCorridor(int& cell, int& direction, const int& stop_cell) const;
+
+                // searchPath function that does the work of findPath, writing
+                // the path as cells or packed
+                template<typename Path>
+                void searchPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats) const;
+        };
+
+        // DistanceField class that holds the breadth first distance from every
+        // cell of a grid map to one goal cell, as one 32-bit value per cell
+        // index. It is computed level by level. A level with a small frontier
+        // expands the frontier cell by cell; once the frontier is dense in
+        // the words of the map it covers, the next level is computed for 64
+        // cells at a time with bitwise operations on the frontier, free and
+        // visited bitmaps. Large levels are split over the threads. Any cell
+        // finds its path to the goal by stepping to a neighbor whose
+        // distance is one lower. With a stop cell, no level after the one
+        // that reaches it is computed and farther cells stay UNREACHABLE.
+        class DistanceField
+        {
+            public:
+                static constexpr std::uint32_t UNREACHABLE = UINT32_MAX;
+
+                DistanceField(grid::GridMap const& grid_map, const int& goal_row_index, const int& goal_col_index, const int& number_threads = 0, const int& stop_row_index = grid::Constants::INDEX_NOT_FOUND, const int& stop_col_index = grid::Constants::INDEX_NOT_FOUND, SearchStats* stats = nullptr);
+                DistanceField(DistanceField&& distance_field) noexcept = default;
+                DistanceField& operator=(DistanceField&& distance_field) noexcept = default;
+                ~DistanceField();
+
+                // getDistance function that returns the distance of a cell to
+                // the goal, or UNREACHABLE for walls and cut off cells
+                const std::uint32_t& getDistance(const int& row_index, const int& col_index) const { return distances[static_cast<std::size_t>(row_index + 1) * row_stride + col_index + 1]; }
+
+                // getPath function that descends the distances from a cell to
+                // the goal, the path is empty if the goal can not be reached
+                void getPath(const int& row_index, const int& col_index, std::vector<std::pair<int, int>>& path) const;
+                void getPath(const int& row_index, const int& col_index, grid::PackedPath& path) const;
+
+                // toRowMajor function that returns the distances of the cells
+                // without the border, one row after the other
+                std::vector<std::uint32_t> toRowMajor() const;
+
+                const int& getNumberRows() const { return number_rows; }
+                const int& getNumberCols() const { return number_cols; }
+                const int& getNumberLevels() const { return number_levels; }
+
+            private:
+                int number_rows;
+                int number_cols;
+                int row_stride;
+                int number_levels;
+                grid::ScratchArray<std::uint32_t> distances;
+
+                // descendPath function that does the work of getPath, writing
+                // the path as cells or packed
+                template<typename Path>
+                void descendPath(const int& row_index, const int& col_index, Path& path) const;
+        };
+
+        // performParallelBFS function that finds a shortest path with a
+        // distance field grown from the end cell on number_threads threads,
+        // 0 uses one thread per hardware thread. It is a delta-stepping
+        // search with unit buckets: every level is one bucket, its cells are
+        // expanded in parallel, and the search stops with the level that
+        // reaches the start cell. Levels with few cells, such as those of
+        // a corridor, stay on the calling thread.
+        void performParallelBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr, const int& number_threads = 0);
+        void performParallelBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats = nullptr, const int& number_threads = 0);
+
+        // DStarLite class that keeps a shortest path between a start and a
+        // goal cell while the cells of the grid map change. It searches from
+        // the goal towards the start and keeps its g-scores and one-step
+        // lookahead rhs-scores between searches. When cells change, only the
+        // cells whose scores become inconsistent are expanded again, which
+        // is usually a small part of the map. The grid map is read in place
+        // and must outlive the planner.
+        class DStarLite
+        {
+            public:
+                DStarLite(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& goal_row_index, const int& goal_col_index);
+                ~DStarLite();
+
+                // findPath function that repairs the scores and writes the
+                // path from the start to the goal, or nothing if there is none
+                void findPath(std::vector<std::pair<int, int>>& path, SearchStats* stats = nullptr);
+
+                // updateCells function that tells the planner about cells that
+                // have already been changed in the grid map
+                void updateCells(std::vector<grid::CellUpdate> const& cell_updates);
+
+                // moveStart function that moves the start, for example to the
+                // next cell of the path once the agent has stepped on it
+                void moveStart(const int& row_index, const int& col_index);
+
+            private:
+                grid::GridMap const& grid_map;
+                int start_cell;
+                int goal_cell;
+                int last_start_cell;
+                int key_modifier;
+                grid::ScratchArray<int> g_scores;
+                grid::ScratchArray<int> rhs_scores;
+                IndexedPriorityQueue open_list;
+
+                // getNeighborCells function that returns the four neighbors of
+                // a cell, walls included. The border keeps them in bounds.
+                std::array<int, 4> getNeighborCells(const int& cell) const;
+
+                // getHeuristic function that returns the manhattan distance
+                // of a cell to the start
+                int getHeuristic(const int& cell) const;
+
+                // getKey function that returns the primary key of a cell, the
+                // secondary key is min(g, rhs)
+                std::pair<int, int> getKey(const int& cell) const;
+
+                // getLookahead function that returns the lowest cost over the
+                // neighbors of a cell of stepping to it and on to the goal
+                int getLookahead(const int& cell) const;
+
+                // updateCell function that queues a cell if it is inconsistent
+                // and removes it from the open list otherwise
+                template<typename Recorder>
+                void updateCell(const int& cell, Recorder& recorder);
+
+                // computeShortestPath function that expands cells until the
+                // start is consistent and no queued cell can improve it
+                template<typename Recorder>
+                void computeShortestPath(Recorder& recorder);
+        };
     }
 }
 
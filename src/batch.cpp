@@ -0,0 +1,268 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+// system includes
+#include <glob.h>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // escapeJson function that escapes a string for a JSON string literal
+            string escapeJson(string const& value)
+            {
+                string escaped_value;
+                for(char character : value)
+                {
+                    if(character == '"' || character == '\\')
+                    {
+                        escaped_value += '\\';
+                        escaped_value += character;
+                    }
+                    else if(static_cast<unsigned char>(character) < 0x20)
+                    {
+                        char escape_sequence[7];
+                        snprintf(escape_sequence, sizeof(escape_sequence), "\\u%04x", static_cast<unsigned char>(character));
+                        escaped_value += escape_sequence;
+                    }
+                    else
+                    {
+                        escaped_value += character;
+                    }
+                }
+
+                return escaped_value;
+            }
+
+            // escapeCsv function that quotes a CSV field if it has to be quoted
+            string escapeCsv(string const& value)
+            {
+                if(value.find_first_of(",\"\r\n") == string::npos)
+                {
+                    return value;
+                }
+
+                string escaped_value = "\"";
+                for(char character : value)
+                {
+                    if(character == '"')
+                    {
+                        escaped_value += '"';
+                    }
+                    escaped_value += character;
+                }
+
+                return escaped_value + "\"";
+            }
+
+            // solveMap function that runs a user story on one map
+            BatchResult solveMap(filesystem::path const& map_file_path, BatchOptions const& options)
+            {
+                BatchResult result;
+                result.map_file = map_file_path.string();
+
+                auto start_time = chrono::steady_clock::now();
+                Grid grid(map_file_path.string(), options.load_mode);
+
+                vector<pair<int, int>> path;
+                if(!grid.isInitialized())
+                {
+                    result.status = "invalid_map";
+                }
+                else
+                {
+                    switch(options.user_story_id)
+                    {
+                        case 1:
+                            {
+                                if(int col_index = grid.searchARowForEmptySpace(0); col_index != Constants::INDEX_NOT_FOUND)
+                                {
+                                    path.push_back(make_pair(0, col_index));
+                                }
+                                break;
+                            }
+                        case 2:
+                            path = grid.walkThrouhHallway();
+                            break;
+                        case 3:
+                            path = grid.findPathToAndOutOfRoom();
+                            break;
+                        case 4:
+                            path = grid.findWindingPath();
+                            break;
+                        default:
+                            path = grid.solveMaze(options.solve_options);
+                            break;
+                    }
+
+                    result.status = path.empty() ? "no_path" : "solved";
+                    result.path_length = path.size();
+                }
+
+                result.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count();
+                return result;
+            }
+        }
+
+        vector<filesystem::path> collectMapFiles(string const& source)
+        {
+            vector<filesystem::path> map_files;
+
+            if(filesystem::is_directory(source))
+            {
+                for(auto const& entry : filesystem::recursive_directory_iterator(source))
+                {
+                    if(entry.is_regular_file())
+                    {
+                        map_files.push_back(entry.path());
+                    }
+                }
+                sort(map_files.begin(), map_files.end());
+            }
+            else if(filesystem::is_regular_file(source))
+            {
+                // manifest file with one map file per line
+                ifstream manifest_file_handler(source);
+                filesystem::path manifest_directory = filesystem::path(source).parent_path();
+                string manifest_line;
+
+                while(getline(manifest_file_handler, manifest_line))
+                {
+                    if(!manifest_line.empty() && manifest_line.back() == '\r')
+                    {
+                        manifest_line.pop_back();
+                    }
+
+                    if(manifest_line.empty() || manifest_line[0] == '#')
+                    {
+                        continue;
+                    }
+
+                    filesystem::path map_file_path(manifest_line);
+                    map_files.push_back(map_file_path.is_absolute() ? map_file_path : manifest_directory / map_file_path);
+                }
+            }
+            else if(source.find_first_of("*?[") != string::npos)
+            {
+                glob_t glob_result = {};
+                if(glob(source.c_str(), 0, nullptr, &glob_result) == 0)
+                {
+                    for(size_t path_index = 0; path_index < glob_result.gl_pathc; path_index++)
+                    {
+                        if(filesystem::is_regular_file(glob_result.gl_pathv[path_index]))
+                        {
+                            map_files.push_back(glob_result.gl_pathv[path_index]);
+                        }
+                    }
+                }
+                globfree(&glob_result);
+            }
+            else
+            {
+                cerr << "Batch source does not exist : " << source << endl;
+                throw filesystem::filesystem_error("Batch source does not exist.", error_code());
+            }
+
+            return map_files;
+        }
+
+        vector<PathQuery> readPathQueries(istream& query_stream)
+        {
+            vector<PathQuery> queries;
+            string query_line;
+            int line_number = 0;
+
+            while(getline(query_stream, query_line))
+            {
+                line_number++;
+                if(!query_line.empty() && query_line.back() == '\r')
+                {
+                    query_line.pop_back();
+                }
+
+                if(query_line.find_first_not_of(" \t") == string::npos || query_line[query_line.find_first_not_of(" \t")] == '#')
+                {
+                    continue;
+                }
+
+                PathQuery query;
+                istringstream query_line_stream(query_line);
+                string remaining_text;
+                if(!(query_line_stream >> query.start_cell.first >> query.start_cell.second >> query.end_cell.first >> query.end_cell.second) || query_line_stream >> remaining_text)
+                {
+                    cerr << "Invalid query on line " << line_number << " : " << query_line << endl;
+                    throw invalid_argument("Invalid query.");
+                }
+                queries.push_back(query);
+            }
+
+            return queries;
+        }
+
+        vector<BatchResult> solveMaps(vector<filesystem::path> const& map_files, BatchOptions const& options)
+        {
+            vector<BatchResult> results(map_files.size());
+            WorkStealingPool pool(options.number_threads);
+
+            // every task writes only its own result, so no locking is needed
+            pool.run(map_files.size(), [&](const int& task_index, const int&)
+            {
+                results[task_index] = solveMap(map_files[task_index], options);
+            });
+
+            return results;
+        }
+
+        void writeBatchResults(ostream& output_stream, vector<BatchResult> const& results, const BatchFormat& format)
+        {
+            if(format == BatchFormat::CSV)
+            {
+                output_stream << "map_file,status,path_length,milliseconds\n";
+            }
+
+            for(auto const& result : results)
+            {
+                if(format == BatchFormat::CSV)
+                {
+                    output_stream << escapeCsv(result.map_file) << ',' << result.status << ',' << result.path_length << ',' << result.milliseconds << '\n';
+                }
+                else
+                {
+                    output_stream << "{\"map_file\":\"" << escapeJson(result.map_file) << "\",\"status\":\"" << result.status
+                        << "\",\"path_length\":" << result.path_length << ",\"milliseconds\":" << result.milliseconds << "}\n";
+                }
+            }
+
+            output_stream.flush();
+        }
+    }
+}
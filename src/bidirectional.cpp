@@ -0,0 +1,443 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <limits>
+#include <cstdlib>
+#include <thread>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            constexpr int UNREACHED = numeric_limits<int>::max();
+
+            // Barrier class that blocks until a number of threads have arrived
+            class Barrier
+            {
+                public:
+                    Barrier(const int& number_threads) : number_threads(number_threads), number_waiting(0), generation(0) {}
+
+                    void wait()
+                    {
+                        unique_lock<mutex> barrier_lock(barrier_mutex);
+                        int arrival_generation = generation;
+
+                        if(++number_waiting == number_threads)
+                        {
+                            number_waiting = 0;
+                            generation++;
+                            all_arrived.notify_all();
+                        }
+                        else
+                        {
+                            all_arrived.wait(barrier_lock, [&]() { return arrival_generation != generation; });
+                        }
+                    }
+
+                private:
+                    mutex barrier_mutex;
+                    condition_variable all_arrived;
+                    int number_threads;
+                    int number_waiting;
+                    int generation;
+            };
+
+            // Meeting struct that holds the best cell where the searches met
+            struct Meeting
+            {
+                int path_length = UNREACHED;
+                int cell = grid::Constants::INDEX_NOT_FOUND;
+
+                void update(const int& candidate_length, const int& candidate_cell)
+                {
+                    if(candidate_length < path_length)
+                    {
+                        path_length = candidate_length;
+                        cell = candidate_cell;
+                    }
+                }
+            };
+
+            // BreadthFirstSide struct that holds one frontier of the
+            // bidirectional BFS. Every side only writes its own arrays.
+            struct BreadthFirstSide
+            {
+                grid::ScratchArray<int> distances;
+                grid::ScratchArray<int> parent_cells;
+                vector<int> frontier;
+                vector<int> next_frontier;
+                int level = 0;
+                int64_t nodes_expanded = 0;
+                int64_t nodes_pushed = 0;
+                int64_t peak_frontier_size = 1;
+
+                BreadthFirstSide(const int& number_cells, const int& root_cell, const bool& use_disk)
+                {
+                    distances.assign(number_cells, UNREACHED, use_disk);
+                    parent_cells.assign(number_cells, -1, use_disk);
+                    distances[root_cell] = 0;
+                    frontier.push_back(root_cell);
+                }
+
+                // expandLevel function that replaces the frontier by the
+                // unreached free neighbors of its cells
+                void expandLevel(grid::GridMap const& grid_map)
+                {
+                    const int neighbor_offsets[4] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+
+                    next_frontier.clear();
+                    for(auto const& cell : frontier)
+                    {
+                        nodes_expanded++;
+                        for(auto const& neighbor_offset : neighbor_offsets)
+                        {
+                            int neighbor_cell = cell + neighbor_offset;
+                            if(grid_map.isFreeCell(neighbor_cell) && distances[neighbor_cell] == UNREACHED)
+                            {
+                                distances[neighbor_cell] = level + 1;
+                                parent_cells[neighbor_cell] = cell;
+                                next_frontier.push_back(neighbor_cell);
+                            }
+                        }
+                    }
+
+                    nodes_pushed += next_frontier.size();
+                    peak_frontier_size = max(peak_frontier_size, static_cast<int64_t>(next_frontier.size()));
+                    frontier.swap(next_frontier);
+                    level++;
+                }
+
+                // findMeeting function that returns the best cell of the
+                // frontier that the other side has reached as well
+                Meeting findMeeting(BreadthFirstSide const& other_side) const
+                {
+                    Meeting meeting;
+                    for(auto const& cell : frontier)
+                    {
+                        if(other_side.distances[cell] != UNREACHED)
+                        {
+                            meeting.update(distances[cell] + other_side.distances[cell], cell);
+                        }
+                    }
+
+                    return meeting;
+                }
+            };
+
+            // getManhattanDistance function that returns the heuristic between two cells
+            int getManhattanDistance(grid::GridMap const& grid_map, const int& cell_a, const int& cell_b)
+            {
+                return abs(grid_map.getRowIndex(cell_a) - grid_map.getRowIndex(cell_b)) + abs(grid_map.getColIndex(cell_a) - grid_map.getColIndex(cell_b));
+            }
+
+            // buildPath functions that join the parent chains of both
+            // searches at the meeting cell, given a function that returns
+            // the parent cell of a cell for each side. A packed path is
+            // written without reversing.
+            template<typename ForwardParent, typename BackwardParent>
+            void buildPath(grid::GridMap const& grid_map, ForwardParent const& getForwardParent, BackwardParent const& getBackwardParent, const int& meeting_cell, vector<pair<int, int>>& path)
+            {
+                for(int cell = meeting_cell; cell != -1; cell = getForwardParent(cell))
+                {
+                    path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+                }
+                reverse(path.begin(), path.end());
+
+                for(int cell = getBackwardParent(meeting_cell); cell != -1; cell = getBackwardParent(cell))
+                {
+                    path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+                }
+            }
+
+            template<typename ForwardParent, typename BackwardParent>
+            void buildPath(grid::GridMap const& grid_map, ForwardParent const& getForwardParent, BackwardParent const& getBackwardParent, const int& meeting_cell, grid::PackedPath& path)
+            {
+                // both chains are counted first. The forward chain is written
+                // from the meeting cell back to the start cell, the backward
+                // chain from the meeting cell on to the end cell.
+                int64_t number_forward_moves = 0;
+                int start_cell = meeting_cell;
+                for(; getForwardParent(start_cell) != -1; start_cell = getForwardParent(start_cell))
+                {
+                    number_forward_moves++;
+                }
+
+                int64_t number_backward_moves = 0;
+                int end_cell = meeting_cell;
+                for(; getBackwardParent(end_cell) != -1; end_cell = getBackwardParent(end_cell))
+                {
+                    number_backward_moves++;
+                }
+
+                path = grid::PackedPath(make_pair(grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell)), make_pair(grid_map.getRowIndex(end_cell), grid_map.getColIndex(end_cell)), number_forward_moves + number_backward_moves);
+
+                int64_t step_index = number_forward_moves;
+                for(int cell = meeting_cell; cell != start_cell; cell = getForwardParent(cell))
+                {
+                    path.setMove(--step_index, getCellMove(grid_map, getForwardParent(cell), cell));
+                }
+
+                step_index = number_forward_moves;
+                for(int cell = meeting_cell; cell != end_cell; cell = getBackwardParent(cell))
+                {
+                    path.setMove(step_index++, getCellMove(grid_map, cell, getBackwardParent(cell)));
+                }
+            }
+
+            // getThreadWorkspaces function that returns the workspaces of the
+            // two sides of the bidirectional A* of the calling thread
+            SearchWorkspace* getThreadWorkspaces()
+            {
+                thread_local SearchWorkspace workspaces[2];
+                return workspaces;
+            }
+
+            // checkCells function that validates the start and end cells
+            void checkCells(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index)
+            {
+                if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+                {
+                    throw invalid_argument("Invalid start cell.");
+                }
+
+                if(end_row_index < 0 || end_row_index >= grid_map.getNumberRows() || end_col_index < 0 || end_col_index >= grid_map.getNumberCols())
+                {
+                    throw invalid_argument("Invalid end cell.");
+                }
+            }
+
+            // searchBidirectionalBFS and searchBidirectionalAStar functions that
+            // perform the searches and write the path as cells or packed
+            template<typename Path>
+            void searchBidirectionalBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats, const bool& use_two_threads)
+            {
+                checkCells(grid_map, start_row_index, start_col_index, end_row_index, end_col_index);
+
+                int number_cells = grid_map.getNumberCellIndices();
+                bool use_disk = grid_map.isDiskBacked();
+                BreadthFirstSide sides[2] = {
+                    BreadthFirstSide(number_cells, grid_map.getCellIndex(start_row_index, start_col_index), use_disk),
+                    BreadthFirstSide(number_cells, grid_map.getCellIndex(end_row_index, end_col_index), use_disk)
+                };
+                Meeting meeting = sides[0].findMeeting(sides[1]);
+
+                // all cells up to the levels of both frontiers are labeled, so a
+                // path that was not found yet is longer than the two levels
+                auto isDone = [](Meeting const& current_meeting, const int& number_levels, const bool& is_exhausted)
+                {
+                    return is_exhausted || current_meeting.path_length <= number_levels + 1;
+                };
+
+                if(!use_two_threads)
+                {
+                    // expand the smaller frontier, then look for cells on it that
+                    // the other side has reached
+                    while(!isDone(meeting, sides[0].level + sides[1].level, sides[0].frontier.empty() || sides[1].frontier.empty()))
+                    {
+                        int side_index = sides[0].frontier.size() <= sides[1].frontier.size() ? 0 : 1;
+                        sides[side_index].expandLevel(grid_map);
+
+                        Meeting side_meeting = sides[side_index].findMeeting(sides[1 - side_index]);
+                        meeting.update(side_meeting.path_length, side_meeting.cell);
+                    }
+                }
+                else
+                {
+                    // both frontiers are expanded at the same time. Each thread
+                    // only writes its own side while expanding, and only reads the
+                    // other side between the two barriers. The state both threads
+                    // decide on is published in the slots before the second
+                    // barrier, because the other side may already be expanding
+                    // its next level after it. Both threads start from a copy of
+                    // the meeting, which is only written back after the join.
+                    Barrier barrier(2);
+                    const Meeting initial_meeting = meeting;
+                    Meeting final_meeting;
+                    Meeting side_meetings[2];
+                    int side_levels[2] = {0, 0};
+                    bool side_exhausted[2] = {false, false};
+
+                    auto expandSide = [&](const int& side_index)
+                    {
+                        Meeting current_meeting = initial_meeting;
+                        while(!isDone(current_meeting, side_levels[0] + side_levels[1], side_exhausted[0] || side_exhausted[1]))
+                        {
+                            sides[side_index].expandLevel(grid_map);
+                            barrier.wait();
+
+                            side_meetings[side_index] = sides[side_index].findMeeting(sides[1 - side_index]);
+                            side_levels[side_index] = sides[side_index].level;
+                            side_exhausted[side_index] = sides[side_index].frontier.empty();
+                            barrier.wait();
+
+                            current_meeting.update(side_meetings[0].path_length, side_meetings[0].cell);
+                            current_meeting.update(side_meetings[1].path_length, side_meetings[1].cell);
+                        }
+
+                        if(side_index == 0)
+                        {
+                            final_meeting = current_meeting;
+                        }
+                    };
+
+                    thread backward_thread(expandSide, 1);
+                    expandSide(0);
+                    backward_thread.join();
+                    meeting = final_meeting;
+                }
+
+                // the sides count on their own threads and are added up here
+                if(stats != nullptr)
+                {
+                    stats->nodes_expanded += sides[0].nodes_expanded + sides[1].nodes_expanded;
+                    stats->nodes_pushed += sides[0].nodes_pushed + sides[1].nodes_pushed + 2;
+                    stats->peak_frontier_size = max(stats->peak_frontier_size, max(sides[0].peak_frontier_size, sides[1].peak_frontier_size));
+                    stats->bytes_allocated += 4 * static_cast<int64_t>(number_cells) * sizeof(int);
+                }
+
+                if(meeting.cell != grid::Constants::INDEX_NOT_FOUND)
+                {
+                    buildPath(grid_map, [&sides](const int& cell) { return sides[0].parent_cells[cell]; }, [&sides](const int& cell) { return sides[1].parent_cells[cell]; }, meeting.cell, path);
+                }
+            }
+
+            template<typename Path>
+            void searchBidirectionalAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats)
+            {
+                checkCells(grid_map, start_row_index, start_col_index, end_row_index, end_col_index);
+
+                int number_cells = grid_map.getNumberCellIndices();
+                int target_cells[2] = {grid_map.getCellIndex(end_row_index, end_col_index), grid_map.getCellIndex(start_row_index, start_col_index)};
+                const int neighbor_offsets[4] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+
+                recordSearch(stats, [&](auto& recorder)
+                {
+                    // side 0 searches from the start towards the end, side 1 the
+                    // other way. The state is kept in the workspaces of the thread,
+                    // so repeated searches do not allocate. The state of a disk
+                    // backed grid map is kept on disk as well and released after
+                    // the search.
+                    bool use_disk = grid_map.isDiskBacked();
+                    SearchWorkspace local_workspaces[2];
+                    SearchWorkspace* workspaces = use_disk ? local_workspaces : getThreadWorkspaces();
+
+                    for(int side_index = 0; side_index < 2; side_index++)
+                    {
+                        int root_cell = target_cells[1 - side_index];
+                        recorder.allocate(workspaces[side_index].prepare(number_cells, use_disk));
+
+                        int h_score = getManhattanDistance(grid_map, root_cell, target_cells[side_index]);
+                        workspaces[side_index].reach(root_cell, 0, -1);
+                        workspaces[side_index].getOpenList().push(root_cell, h_score, h_score);
+                        recorder.push(workspaces[side_index].getOpenList().size());
+                    }
+
+                    Meeting meeting;
+                    if(target_cells[0] == target_cells[1])
+                    {
+                        meeting.update(0, target_cells[0]);
+                    }
+
+                    // getTopFScore function that returns the lowest f-score of a side
+                    auto getTopFScore = [&](const int& side_index)
+                    {
+                        int top_cell = workspaces[side_index].getOpenList().top();
+                        return workspaces[side_index].getGScore(top_cell) + getManhattanDistance(grid_map, top_cell, target_cells[side_index]);
+                    };
+
+                    // each side is a consistent A*, so a path shorter than the best
+                    // meeting would still have a cell with a lower f-score on both lists
+                    while(!workspaces[0].getOpenList().empty() && !workspaces[1].getOpenList().empty() && getTopFScore(0) < meeting.path_length && getTopFScore(1) < meeting.path_length)
+                    {
+                        int side_index = workspaces[0].getOpenList().size() <= workspaces[1].getOpenList().size() ? 0 : 1;
+                        SearchWorkspace& workspace = workspaces[side_index];
+                        SearchWorkspace const& other_workspace = workspaces[1 - side_index];
+                        IndexedPriorityQueue& open_list = workspace.getOpenList();
+
+                        int current_cell = open_list.pop();
+                        recorder.expand();
+
+                        for(auto const& neighbor_offset : neighbor_offsets)
+                        {
+                            // a reached cell that is not queued any more is closed
+                            int neighbor_cell = current_cell + neighbor_offset;
+                            int g_score = workspace.getGScore(current_cell) + 1;
+                            if(!grid_map.isFreeCell(neighbor_cell) || (workspace.isReached(neighbor_cell) && (!open_list.contains(neighbor_cell) || g_score >= workspace.getGScore(neighbor_cell))))
+                            {
+                                continue;
+                            }
+
+                            int h_score = getManhattanDistance(grid_map, neighbor_cell, target_cells[side_index]);
+                            if(open_list.contains(neighbor_cell))
+                            {
+                                open_list.decreaseKey(neighbor_cell, g_score + h_score, h_score);
+                                recorder.decreaseKey();
+                            }
+                            else
+                            {
+                                open_list.push(neighbor_cell, g_score + h_score, h_score);
+                                recorder.push(open_list.size());
+                            }
+                            workspace.reach(neighbor_cell, g_score, current_cell);
+
+                            if(other_workspace.isReached(neighbor_cell))
+                            {
+                                meeting.update(g_score + other_workspace.getGScore(neighbor_cell), neighbor_cell);
+                            }
+                        }
+                    }
+
+                    if(meeting.cell != grid::Constants::INDEX_NOT_FOUND)
+                    {
+                        buildPath(grid_map, [workspaces](const int& cell) { return workspaces[0].getParentCell(cell); }, [workspaces](const int& cell) { return workspaces[1].getParentCell(cell); }, meeting.cell, path);
+                    }
+                });
+            }
+        }
+
+        void performBidirectionalBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats, const bool& use_two_threads)
+        {
+            searchBidirectionalBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, use_two_threads);
+        }
+
+        void performBidirectionalBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats, const bool& use_two_threads)
+        {
+            searchBidirectionalBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, use_two_threads);
+        }
+
+        void performBidirectionalAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            searchBidirectionalAStar(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        void performBidirectionalAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats)
+        {
+            searchBidirectionalAStar(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+    }
+}
@@ -0,0 +1,200 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        static_assert(sizeof(BinaryMapHeader) == 48, "Binary map header must not contain padding.");
+
+        namespace
+        {
+            // the 8 cells of every byte of a row word, one byte per cell
+            // with 1 for walls, in the byte order of a little endian machine
+            struct ByteCells
+            {
+                uint64_t cells[256];
+
+                constexpr ByteCells() : cells()
+                {
+                    for(int byte = 0; byte < 256; byte++)
+                    {
+                        for(int bit = 0; bit < 8; bit++)
+                        {
+                            cells[byte] |= static_cast<uint64_t>((byte >> bit) & 1) << (8 * bit);
+                        }
+                    }
+                }
+            };
+
+            constexpr ByteCells BYTE_CELLS;
+
+            // computeMapChecksum function that returns the checksum of the
+            // header, with its checksum field set to zero, and the payload
+            uint64_t computeMapChecksum(BinaryMapHeader header, const uint64_t* words, const size_t& number_words)
+            {
+                uint64_t header_words[sizeof(BinaryMapHeader) / sizeof(uint64_t)];
+                header.checksum = 0;
+                memcpy(header_words, &header, sizeof(header_words));
+
+                return computeChecksum(words, number_words, computeChecksum(header_words, sizeof(header_words) / sizeof(uint64_t)));
+            }
+        }
+
+        uint64_t computeChecksum(const uint64_t* words, const size_t& number_words, const uint64_t& checksum)
+        {
+            uint64_t word_checksum = checksum;
+
+            for(size_t word_index = 0; word_index < number_words; word_index++)
+            {
+                word_checksum ^= words[word_index];
+                word_checksum *= 1099511628211ULL;
+            }
+
+            return word_checksum;
+        }
+
+        bool isBinaryMap(filesystem::path const& map_file_path)
+        {
+            if(!filesystem::is_regular_file(map_file_path))
+            {
+                return false;
+            }
+
+            ifstream map_file_handler(map_file_path, ios::binary);
+            char magic[sizeof(BinaryMapHeader::MAGIC)] = {};
+            map_file_handler.read(magic, sizeof(magic));
+
+            return map_file_handler.gcount() == sizeof(magic) && memcmp(magic, BinaryMapHeader::MAGIC, sizeof(magic)) == 0;
+        }
+
+        GridMap readBinaryMap(filesystem::path const& map_file_path, BinaryMapHeader& header, WallBitmap* wall_bitmap)
+        {
+            if(!filesystem::is_regular_file(map_file_path))
+            {
+                cerr << "File does not exist : " << map_file_path << endl;
+                throw filesystem::filesystem_error("File does not exist.", error_code());
+            }
+
+            MappedRegion mapping(map_file_path);
+
+            if(mapping.getSize() < sizeof(BinaryMapHeader))
+            {
+                cerr << "Invalid binary map file : " << map_file_path << endl;
+                throw invalid_argument("Invalid binary map file.");
+            }
+
+            memcpy(&header, mapping.getData(), sizeof(BinaryMapHeader));
+
+            // check the header against the payload that follows it
+            bool is_valid_header = memcmp(header.magic, BinaryMapHeader::MAGIC, sizeof(header.magic)) == 0
+                && header.version == BinaryMapHeader::VERSION
+                && header.number_rows >= 0 && header.number_cols >= 0
+                && header.words_per_row == (header.number_cols + 63) / 64
+                && (static_cast<size_t>(header.number_rows) + 2) * (static_cast<size_t>(header.number_cols) + 2) <= static_cast<size_t>(numeric_limits<int>::max());
+
+            size_t number_words = is_valid_header ? static_cast<size_t>(header.number_rows) * header.words_per_row : 0;
+
+            if(!is_valid_header || mapping.getSize() != sizeof(BinaryMapHeader) + number_words * sizeof(uint64_t))
+            {
+                cerr << "Invalid binary map file : " << map_file_path << endl;
+                throw invalid_argument("Invalid binary map file.");
+            }
+
+            // the header is 48 bytes long, so the payload is 8 byte aligned
+            const uint64_t* words = reinterpret_cast<const uint64_t*>(mapping.getData() + sizeof(BinaryMapHeader));
+
+            if(computeMapChecksum(header, words, number_words) != header.checksum)
+            {
+                cerr << "Corrupted binary map file : " << map_file_path << endl;
+                throw invalid_argument("Invalid binary map file.");
+            }
+
+            // expand the words of every row into cells, a byte of a word at a time
+            GridMap grid_map(header.number_rows, header.number_cols);
+            for(int row_index = 0; row_index < header.number_rows; row_index++)
+            {
+                const uint64_t* row_words = words + static_cast<size_t>(row_index) * header.words_per_row;
+                uint8_t* row = grid_map.getRow(row_index);
+
+                for(int col_index = 0; col_index < header.number_cols; col_index += 8)
+                {
+                    uint64_t byte_cells = BYTE_CELLS.cells[(row_words[col_index >> 6] >> (col_index & 63)) & 0xff];
+                    memcpy(row + col_index, &byte_cells, min(8, header.number_cols - col_index));
+                }
+            }
+
+            if(wall_bitmap != nullptr)
+            {
+                *wall_bitmap = WallBitmap(header.number_rows, header.number_cols, words);
+            }
+
+            return grid_map;
+        }
+
+        void writeBinaryMap(filesystem::path const& map_file_path, WallBitmap const& wall_bitmap, const pair<int, int>& start_cell, const pair<int, int>& end_cell)
+        {
+            BinaryMapHeader header = {};
+            memcpy(header.magic, BinaryMapHeader::MAGIC, sizeof(header.magic));
+            header.version = BinaryMapHeader::VERSION;
+            header.number_rows = wall_bitmap.getNumberRows();
+            header.number_cols = wall_bitmap.getNumberCols();
+            header.start_row_index = start_cell.first;
+            header.start_col_index = start_cell.second;
+            header.end_row_index = end_cell.first;
+            header.end_col_index = end_cell.second;
+            header.words_per_row = wall_bitmap.getWordsPerRow();
+
+            // the rows of the bitmap are contiguous, so the payload is one block
+            size_t number_words = static_cast<size_t>(header.number_rows) * header.words_per_row;
+            const uint64_t* words = header.number_rows > 0 ? wall_bitmap.getRowWords(0) : nullptr;
+            header.checksum = computeMapChecksum(header, words, number_words);
+
+            ofstream map_file_handler(map_file_path, ios::binary | ios::trunc);
+            if(!map_file_handler.is_open())
+            {
+                cerr << "Could not open file : " << map_file_path << endl;
+                throw filesystem::filesystem_error("Could not open file..", error_code());
+            }
+
+            map_file_handler.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if(number_words > 0)
+            {
+                map_file_handler.write(reinterpret_cast<const char*>(words), number_words * sizeof(uint64_t));
+            }
+
+            if(!map_file_handler)
+            {
+                cerr << "Could not write file : " << map_file_path << endl;
+                throw filesystem::filesystem_error("Could not write file.", error_code());
+            }
+        }
+    }
+}
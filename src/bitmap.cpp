@@ -0,0 +1,284 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+
+// project includes
+#include "maze.hpp"
+
+// the AVX2 kernel is compiled with a target attribute and selected at
+// runtime, so the library still runs on CPUs without AVX2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MAZE_HAS_AVX2_KERNELS 1
+#endif
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            constexpr uint64_t ALL_BITS = ~uint64_t(0);
+
+            // findFirstWordScalar function that returns the index of the first
+            // word in [begin, end) that differs from skip_value, or end
+            int findFirstWordScalar(const uint64_t* words, int begin, int end, uint64_t skip_value)
+            {
+                for(int word_index = begin; word_index < end; word_index++)
+                {
+                    if(words[word_index] != skip_value)
+                    {
+                        return word_index;
+                    }
+                }
+
+                return end;
+            }
+
+#ifdef MAZE_HAS_AVX2_KERNELS
+            // findFirstWordAvx2 function that compares four words per iteration
+            __attribute__((target("avx2")))
+            int findFirstWordAvx2(const uint64_t* words, int begin, int end, uint64_t skip_value)
+            {
+                const __m256i skip_vector = _mm256_set1_epi64x(static_cast<long long>(skip_value));
+                int word_index = begin;
+
+                for(; word_index + 4 <= end; word_index += 4)
+                {
+                    __m256i word_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + word_index));
+                    __m256i equal_vector = _mm256_cmpeq_epi64(word_vector, skip_vector);
+                    int equal_mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal_vector));
+
+                    if(equal_mask != 0xF)
+                    {
+                        return word_index + __builtin_ctz(~equal_mask & 0xF);
+                    }
+                }
+
+                return findFirstWordScalar(words, word_index, end, skip_value);
+            }
+#endif
+
+            using FindFirstWordFunction = int (*)(const uint64_t*, int, int, uint64_t);
+
+            // selectFindFirstWord function that picks the kernel for this CPU
+            FindFirstWordFunction selectFindFirstWord()
+            {
+#ifdef MAZE_HAS_AVX2_KERNELS
+                if(__builtin_cpu_supports("avx2"))
+                {
+                    return findFirstWordAvx2;
+                }
+#endif
+                return findFirstWordScalar;
+            }
+
+            const FindFirstWordFunction find_first_word = selectFindFirstWord();
+
+            int countTrailingZeros(const uint64_t& word)
+            {
+                return __builtin_ctzll(word);
+            }
+        }
+
+        int findFirstZeroBit(const uint64_t* words, const int& number_words, const int& from_bit)
+        {
+            if(from_bit < 0 || from_bit >= number_words * 64)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            // bits before from_bit are set so that they are skipped
+            int word_index = from_bit >> 6;
+            uint64_t first_word = words[word_index] | ((uint64_t(1) << (from_bit & 63)) - 1);
+            if(first_word != ALL_BITS)
+            {
+                return word_index * 64 + countTrailingZeros(~first_word);
+            }
+
+            word_index = find_first_word(words, word_index + 1, number_words, ALL_BITS);
+            if(word_index == number_words)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            return word_index * 64 + countTrailingZeros(~words[word_index]);
+        }
+
+        int findFirstSetBit(const uint64_t* words, const int& number_words, const int& from_bit)
+        {
+            if(from_bit < 0 || from_bit >= number_words * 64)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            // bits before from_bit are cleared so that they are skipped
+            int word_index = from_bit >> 6;
+            uint64_t first_word = words[word_index] & ~((uint64_t(1) << (from_bit & 63)) - 1);
+            if(first_word != 0)
+            {
+                return word_index * 64 + countTrailingZeros(first_word);
+            }
+
+            word_index = find_first_word(words, word_index + 1, number_words, 0);
+            if(word_index == number_words)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            return word_index * 64 + countTrailingZeros(words[word_index]);
+        }
+
+        WallBitmap::WallBitmap()
+        {
+            this->number_rows = 0;
+            this->number_cols = 0;
+            this->words_per_row = 0;
+            this->words_per_col = 0;
+        }
+
+        WallBitmap::WallBitmap(GridMap const& grid_map)
+        {
+            this->number_rows = grid_map.getNumberRows();
+            this->number_cols = grid_map.getNumberCols();
+            this->words_per_row = (this->number_cols + 63) / 64;
+            this->words_per_col = (this->number_rows + 63) / 64;
+
+            // every bit starts as a wall, which also covers the padding bits
+            this->row_words.assign(static_cast<size_t>(this->number_rows) * this->words_per_row, ALL_BITS);
+            this->col_words.assign(static_cast<size_t>(this->number_cols) * this->words_per_col, ALL_BITS);
+
+            for(int row_index = 0; row_index < this->number_rows; row_index++)
+            {
+                const uint8_t* row = grid_map.getRow(row_index);
+                uint64_t* row_word = this->row_words.data() + static_cast<size_t>(row_index) * this->words_per_row;
+
+                for(int col_index = 0; col_index < this->number_cols; col_index++)
+                {
+                    if(row[col_index] == grid_map.getFreeValue())
+                    {
+                        row_word[col_index >> 6] &= ~(uint64_t(1) << (col_index & 63));
+                        this->col_words[static_cast<size_t>(col_index) * this->words_per_col + (row_index >> 6)] &= ~(uint64_t(1) << (row_index & 63));
+                    }
+                }
+            }
+        }
+
+        WallBitmap::WallBitmap(const int& number_rows, const int& number_cols, const uint64_t* row_words)
+        {
+            this->number_rows = number_rows;
+            this->number_cols = number_cols;
+            this->words_per_row = (this->number_cols + 63) / 64;
+            this->words_per_col = (this->number_rows + 63) / 64;
+            this->row_words.assign(row_words, row_words + static_cast<size_t>(this->number_rows) * this->words_per_row);
+            this->col_words.assign(static_cast<size_t>(this->number_cols) * this->words_per_col, ALL_BITS);
+
+            // the padding bits of a row are walls, whatever was stored in them
+            uint64_t padding_bits = (this->number_cols & 63) != 0 ? ALL_BITS << (this->number_cols & 63) : 0;
+            for(int row_index = 0; row_index < this->number_rows; row_index++)
+            {
+                uint64_t* row_word = this->row_words.data() + static_cast<size_t>(row_index) * this->words_per_row;
+                row_word[this->words_per_row - 1] |= padding_bits;
+
+                // only the free bits of a word are visited
+                for(int word_index = 0; word_index < this->words_per_row; word_index++)
+                {
+                    for(uint64_t free_bits = ~row_word[word_index]; free_bits != 0; free_bits &= free_bits - 1)
+                    {
+                        int col_index = (word_index << 6) + __builtin_ctzll(free_bits);
+                        this->col_words[static_cast<size_t>(col_index) * this->words_per_col + (row_index >> 6)] &= ~(uint64_t(1) << (row_index & 63));
+                    }
+                }
+            }
+        }
+
+        WallBitmap::~WallBitmap()
+        {
+        }
+
+        void WallBitmap::setWall(const int& row_index, const int& col_index, const bool& is_wall)
+        {
+            if(row_index < 0 || row_index >= this->number_rows || col_index < 0 || col_index >= this->number_cols)
+            {
+                throw out_of_range("Cell is out of bounds.");
+            }
+
+            uint64_t& row_word = this->row_words[static_cast<size_t>(row_index) * this->words_per_row + (col_index >> 6)];
+            uint64_t& col_word = this->col_words[static_cast<size_t>(col_index) * this->words_per_col + (row_index >> 6)];
+            uint64_t row_bit = uint64_t(1) << (col_index & 63);
+            uint64_t col_bit = uint64_t(1) << (row_index & 63);
+
+            if(is_wall)
+            {
+                row_word |= row_bit;
+                col_word |= col_bit;
+            }
+            else
+            {
+                row_word &= ~row_bit;
+                col_word &= ~col_bit;
+            }
+        }
+
+        int WallBitmap::findFirstFreeInRow(const int& row_index, const int& from_col_index) const
+        {
+            if(row_index < 0 || row_index >= this->number_rows)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            return findFirstZeroBit(getRowWords(row_index), this->words_per_row, from_col_index);
+        }
+
+        int WallBitmap::findFirstFreeInCol(const int& col_index, const int& from_row_index) const
+        {
+            if(col_index < 0 || col_index >= this->number_cols)
+            {
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            return findFirstZeroBit(getColWords(col_index), this->words_per_col, from_row_index);
+        }
+
+        int WallBitmap::findFirstWallInRow(const int& row_index, const int& from_col_index) const
+        {
+            if(row_index < 0 || row_index >= this->number_rows)
+            {
+                return this->number_cols;
+            }
+
+            // the padding bits are walls, so the result is clamped to the edge
+            int col_index = findFirstSetBit(getRowWords(row_index), this->words_per_row, from_col_index);
+            return col_index == Constants::INDEX_NOT_FOUND ? this->number_cols : min(col_index, this->number_cols);
+        }
+
+        int WallBitmap::findFirstWallInCol(const int& col_index, const int& from_row_index) const
+        {
+            if(col_index < 0 || col_index >= this->number_cols)
+            {
+                return this->number_rows;
+            }
+
+            int row_index = findFirstSetBit(getColWords(col_index), this->words_per_col, from_row_index);
+            return row_index == Constants::INDEX_NOT_FOUND ? this->number_rows : min(row_index, this->number_rows);
+        }
+    }
+}
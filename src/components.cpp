@@ -0,0 +1,120 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <algorithm>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        ComponentIndex::ComponentIndex()
+        {
+        }
+
+        ComponentIndex::ComponentIndex(GridMap const& grid_map)
+        {
+            int row_stride = grid_map.getRowStride();
+            labels.assign(grid_map.getNumberCellIndices(), Constants::INDEX_NOT_FOUND, grid_map.isDiskBacked());
+
+            // every run of free cells in a row gets a provisional label and
+            // is merged with the runs it touches in the row above. The root
+            // of a set is always its lowest label.
+            vector<int> run_parents;
+            auto findRoot = [&run_parents](int run)
+            {
+                while(run_parents[run] != run)
+                {
+                    run_parents[run] = run_parents[run_parents[run]];
+                    run = run_parents[run];
+                }
+                return run;
+            };
+
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                int cell = grid_map.getCellIndex(row_index, 0);
+                int row_end_cell = cell + grid_map.getNumberCols();
+
+                while(cell < row_end_cell)
+                {
+                    if(!grid_map.isFreeCell(cell))
+                    {
+                        cell++;
+                        continue;
+                    }
+
+                    int run = run_parents.size();
+                    run_parents.push_back(run);
+
+                    // the border row above the first row has no labels
+                    int previous_label = Constants::INDEX_NOT_FOUND;
+                    for(; cell < row_end_cell && grid_map.isFreeCell(cell); cell++)
+                    {
+                        labels[cell] = run;
+
+                        int label_above = labels[cell - row_stride];
+                        if(label_above != Constants::INDEX_NOT_FOUND && label_above != previous_label)
+                        {
+                            int root_above = findRoot(label_above);
+                            int root = findRoot(run);
+                            if(root_above != root)
+                            {
+                                run_parents[max(root_above, root)] = min(root_above, root);
+                            }
+                        }
+                        previous_label = label_above;
+                    }
+                }
+            }
+
+            // number the sets in the order of their roots, a root always
+            // comes before the other runs of its set
+            vector<int> run_components(run_parents.size());
+            for(size_t run = 0; run < run_parents.size(); run++)
+            {
+                int root = findRoot(run);
+                if(root == static_cast<int>(run))
+                {
+                    run_components[run] = component_sizes.size();
+                    component_sizes.push_back(0);
+                }
+                else
+                {
+                    run_components[run] = run_components[root];
+                }
+            }
+
+            for(int cell = 0; cell < grid_map.getNumberCellIndices(); cell++)
+            {
+                if(labels[cell] != Constants::INDEX_NOT_FOUND)
+                {
+                    labels[cell] = run_components[labels[cell]];
+                    component_sizes[labels[cell]]++;
+                }
+            }
+        }
+
+        ComponentIndex::~ComponentIndex()
+        {
+        }
+    }
+}
@@ -0,0 +1,229 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // the directions left, right, top and bottom, in the order of
+            // getNeighborCells. The opposite of a direction is direction ^ 1.
+            constexpr int NUMBER_DIRECTIONS = 4;
+
+            // getNeighborMask function that returns one bit per free neighbor
+            // of a cell. The wall border of the grid map makes bounds checks
+            // unnecessary.
+            unsigned getNeighborMask(grid::GridMap const& grid_map, const int (&neighbor_offsets)[NUMBER_DIRECTIONS], const int& cell)
+            {
+                unsigned neighbor_mask = 0;
+                for(int direction = 0; direction < NUMBER_DIRECTIONS; direction++)
+                {
+                    neighbor_mask |= static_cast<unsigned>(grid_map.isFreeCell(cell + neighbor_offsets[direction])) << direction;
+                }
+
+                return neighbor_mask;
+            }
+
+            // startCorridor, addCorridorCell, getCorridorSize and clearCorridor
+            // functions that
+            // write a corridor as cells or as packed moves. The directions are
+            // in the order of the packed moves, so a step is its direction.
+            void startCorridor(const int& row_index, const int& col_index, vector<pair<int, int>>& path)
+            {
+                path.push_back(make_pair(row_index, col_index));
+            }
+
+            void startCorridor(const int& row_index, const int& col_index, grid::PackedPath& path)
+            {
+                path = grid::PackedPath(row_index, col_index);
+            }
+
+            void addCorridorCell(grid::GridMap const& grid_map, const int& cell, const int&, vector<pair<int, int>>& path)
+            {
+                path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+            }
+
+            void addCorridorCell(grid::GridMap const&, const int&, const int& direction, grid::PackedPath& path)
+            {
+                path.addMove(direction);
+            }
+
+            size_t getCorridorSize(vector<pair<int, int>> const& path)
+            {
+                return path.size();
+            }
+
+            size_t getCorridorSize(grid::PackedPath const&)
+            {
+                return 0;
+            }
+
+            void clearCorridor(const size_t& path_size, vector<pair<int, int>>& path)
+            {
+                path.resize(path_size);
+            }
+
+            void clearCorridor(const size_t&, grid::PackedPath& path)
+            {
+                path = grid::PackedPath();
+            }
+
+            // followBranch function that follows the corridor that leaves the
+            // start cell in a direction until it ends, returns to the start
+            // cell or reaches a fork
+            template<typename GetMask, typename Recorder, typename Path>
+            CorridorStatus followBranch(grid::GridMap const& grid_map, GetMask const& getMask, const int (&neighbor_offsets)[NUMBER_DIRECTIONS], const int& start_cell, int direction, Path& path, Recorder& recorder)
+            {
+                int cell = start_cell + neighbor_offsets[direction];
+                while(true)
+                {
+                    addCorridorCell(grid_map, cell, direction, path);
+                    recorder.push(1);
+                    recorder.expand();
+
+                    unsigned neighbor_mask = getMask(cell);
+                    if(__builtin_popcount(neighbor_mask) > 2)
+                    {
+                        return CorridorStatus::FORK;
+                    }
+
+                    // the cell it came from is free, so at most one is left
+                    neighbor_mask &= ~(1u << (direction ^ 1));
+                    if(neighbor_mask == 0)
+                    {
+                        return CorridorStatus::COMPLETE;
+                    }
+
+                    direction = __builtin_ctz(neighbor_mask);
+                    cell += neighbor_offsets[direction];
+                    if(cell == start_cell)
+                    {
+                        return CorridorStatus::CYCLE;
+                    }
+                }
+            }
+
+            // followSecondBranch functions that follow the other corridor
+            // leaving the start cell after the first one ended. Cells are
+            // appended after those of the first corridor. A packed path can
+            // not jump back to the start cell, so the second corridor is
+            // followed into its own path, which is turned around and runs on
+            // into the first corridor.
+            template<typename GetMask, typename Recorder>
+            CorridorStatus followSecondBranch(grid::GridMap const& grid_map, GetMask const& getMask, const int (&neighbor_offsets)[NUMBER_DIRECTIONS], const int& start_cell, const int& direction, vector<pair<int, int>>& path, Recorder& recorder)
+            {
+                return followBranch(grid_map, getMask, neighbor_offsets, start_cell, direction, path, recorder);
+            }
+
+            template<typename GetMask, typename Recorder>
+            CorridorStatus followSecondBranch(grid::GridMap const& grid_map, GetMask const& getMask, const int (&neighbor_offsets)[NUMBER_DIRECTIONS], const int& start_cell, const int& direction, grid::PackedPath& path, Recorder& recorder)
+            {
+                grid::PackedPath branch_path(path.getStartCell().first, path.getStartCell().second);
+                CorridorStatus status = followBranch(grid_map, getMask, neighbor_offsets, start_cell, direction, branch_path, recorder);
+                if(status != CorridorStatus::FORK)
+                {
+                    branch_path.reverse();
+                    branch_path.append(path);
+                    path = std::move(branch_path);
+                }
+
+                return status;
+            }
+
+            // followCorridorWith function that follows the corridor through a
+            // cell, reading the free neighbors of a cell with getMask
+            template<typename GetMask, typename Path>
+            CorridorStatus followCorridorWith(grid::GridMap const& grid_map, GetMask const& getMask, const int& row_index, const int& col_index, Path& path, SearchStats* stats)
+            {
+                if(row_index < 0 || row_index >= grid_map.getNumberRows() || col_index < 0 || col_index >= grid_map.getNumberCols())
+                {
+                    return CorridorStatus::INVALID_START;
+                }
+
+                size_t path_size = getCorridorSize(path);
+                CorridorStatus status = CorridorStatus::COMPLETE;
+                recordSearch(stats, [&](auto& recorder)
+                {
+                    const int neighbor_offsets[NUMBER_DIRECTIONS] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+                    int start_cell = grid_map.getCellIndex(row_index, col_index);
+                    startCorridor(row_index, col_index, path);
+                    recorder.push(1);
+                    recorder.expand();
+
+                    unsigned neighbor_mask = getMask(start_cell);
+                    if(__builtin_popcount(neighbor_mask) > 2)
+                    {
+                        status = CorridorStatus::FORK;
+                        return;
+                    }
+
+                    // like the depth first search, the last neighbor is followed
+                    // first and the other one only if the corridor did not loop
+                    // back to the start through it
+                    if(neighbor_mask != 0)
+                    {
+                        int last_direction = 31 - __builtin_clz(neighbor_mask);
+                        status = followBranch(grid_map, getMask, neighbor_offsets, start_cell, last_direction, path, recorder);
+                        neighbor_mask &= ~(1u << last_direction);
+                    }
+
+                    if(status == CorridorStatus::COMPLETE && neighbor_mask != 0)
+                    {
+                        status = followSecondBranch(grid_map, getMask, neighbor_offsets, start_cell, __builtin_ctz(neighbor_mask), path, recorder);
+                    }
+                });
+
+                if(status == CorridorStatus::FORK)
+                {
+                    clearCorridor(path_size, path);
+                }
+
+                return status;
+            }
+        }
+
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, const int& row_index, const int& col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            const int neighbor_offsets[NUMBER_DIRECTIONS] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+            return followCorridorWith(grid_map, [&grid_map, &neighbor_offsets](const int& cell)
+            {
+                return getNeighborMask(grid_map, neighbor_offsets, cell);
+            }, row_index, col_index, path, stats);
+        }
+
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& row_index, const int& col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            return followCorridorWith(grid_map, [&neighbor_mask](const int& cell)
+            {
+                return static_cast<unsigned>(neighbor_mask.getMask(cell));
+            }, row_index, col_index, path, stats);
+        }
+
+        CorridorStatus followCorridor(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& row_index, const int& col_index, grid::PackedPath& path, SearchStats* stats)
+        {
+            return followCorridorWith(grid_map, [&neighbor_mask](const int& cell)
+            {
+                return static_cast<unsigned>(neighbor_mask.getMask(cell));
+            }, row_index, col_index, path, stats);
+        }
+    }
+}
@@ -0,0 +1,321 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // startPath functions that make room for a path of number_moves
+            // moves from the start cell to the end cell, whose steps are then
+            // written in any order
+            void startPath(pair<int, int> const& start_cell, pair<int, int> const&, const int& number_moves, vector<pair<int, int>>& path)
+            {
+                path.assign(number_moves + 1, start_cell);
+            }
+
+            void startPath(pair<int, int> const& start_cell, pair<int, int> const& end_cell, const int& number_moves, grid::PackedPath& path)
+            {
+                path = grid::PackedPath(start_cell, end_cell, number_moves);
+            }
+
+            // writeStep functions that write a step of a path into a cell.
+            // The directions are in the order of the packed moves.
+            void writeStep(grid::GridMap const& grid_map, const int& cell, const int&, const int& step_index, vector<pair<int, int>>& path)
+            {
+                path[step_index + 1] = make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell));
+            }
+
+            void writeStep(grid::GridMap const&, const int&, const int& direction, const int& step_index, grid::PackedPath& path)
+            {
+                path.setMove(step_index, direction);
+            }
+        }
+
+        CorridorGraph::CorridorGraph(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask) : grid_map(grid_map), neighbor_mask(neighbor_mask)
+        {
+            // the directions left, right, top and bottom, in the order of the
+            // neighbor mask bits. The opposite of a direction is direction ^ 1.
+            this->direction_offsets = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+            this->cell_nodes.assign(grid_map.getNumberCellIndices(), grid::Constants::INDEX_NOT_FOUND, grid_map.isDiskBacked());
+
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                int cell = grid_map.getCellIndex(row_index, 0);
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++, cell++)
+                {
+                    if(grid_map.isFreeCell(cell) && neighbor_mask.getDegree(cell) != 2)
+                    {
+                        this->cell_nodes[cell] = this->node_cells.size();
+                        this->node_cells.push_back(cell);
+                    }
+                }
+            }
+
+            // a corridor that leaves a node always ends at a node, which may
+            // be the node it left
+            this->edge_offsets.reserve(this->node_cells.size() + 1);
+            this->edge_offsets.push_back(0);
+            for(auto const& node_cell : this->node_cells)
+            {
+                unsigned node_mask = neighbor_mask.getMask(node_cell);
+                for(; node_mask != 0; node_mask &= node_mask - 1)
+                {
+                    int first_direction = __builtin_ctz(node_mask);
+                    int cell = node_cell;
+                    int direction = first_direction;
+                    int cost = walkCorridor(cell, direction, grid::Constants::INDEX_NOT_FOUND);
+                    this->edges.push_back({this->cell_nodes[cell], cost, first_direction});
+                }
+                this->edge_offsets.push_back(this->edges.size());
+            }
+        }
+
+        CorridorGraph::~CorridorGraph()
+        {
+        }
+
+        int CorridorGraph::walkCorridor(int& cell, int& direction, const int& stop_cell) const
+        {
+            int start_cell = cell;
+            int steps = 0;
+            while(true)
+            {
+                cell += this->direction_offsets[direction];
+                steps++;
+                if(this->cell_nodes[cell] != grid::Constants::INDEX_NOT_FOUND || cell == stop_cell || cell == start_cell)
+                {
+                    return steps;
+                }
+
+                // the cell has two free neighbors, one of them is the cell the
+                // step came from
+                direction = __builtin_ctz(this->neighbor_mask.getMask(cell) & ~(1u << (direction ^ 1)));
+            }
+        }
+
+        void CorridorGraph::findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats) const
+        {
+            searchPath(start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        void CorridorGraph::findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats) const
+        {
+            searchPath(start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        template<typename Path>
+        void CorridorGraph::searchPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats) const
+        {
+            if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid start cell.");
+            }
+
+            if(end_row_index < 0 || end_row_index >= grid_map.getNumberRows() || end_col_index < 0 || end_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid end cell.");
+            }
+
+            int start_cell = grid_map.getCellIndex(start_row_index, start_col_index);
+            int end_cell = grid_map.getCellIndex(end_row_index, end_col_index);
+
+            if(!grid_map.isFreeCell(start_cell) || !grid_map.isFreeCell(end_cell))
+            {
+                return;
+            }
+            else if(start_cell == end_cell)
+            {
+                startPath(make_pair(start_row_index, start_col_index), make_pair(end_row_index, end_col_index), 0, path);
+                return;
+            }
+
+            // a start or end cell inside a corridor is added as an extra node
+            // that is connected to the nodes at both ends of its corridor
+            int number_nodes = this->node_cells.size();
+            int start_node = this->cell_nodes[start_cell] != grid::Constants::INDEX_NOT_FOUND ? this->cell_nodes[start_cell] : number_nodes;
+            int end_node = this->cell_nodes[end_cell] != grid::Constants::INDEX_NOT_FOUND ? this->cell_nodes[end_cell] : number_nodes + 1;
+
+            // the end edges are kept with the node they leave from, pointing
+            // into the corridor of the end cell. A corridor that reaches the
+            // start cell first is left to the start edges.
+            vector<pair<int, Edge>> end_edges;
+            if(end_node == number_nodes + 1)
+            {
+                unsigned end_mask = this->neighbor_mask.getMask(end_cell);
+                for(; end_mask != 0; end_mask &= end_mask - 1)
+                {
+                    int cell = end_cell;
+                    int direction = __builtin_ctz(end_mask);
+                    int cost = walkCorridor(cell, direction, start_cell);
+                    if(cell != end_cell && this->cell_nodes[cell] != grid::Constants::INDEX_NOT_FOUND)
+                    {
+                        end_edges.push_back(make_pair(this->cell_nodes[cell], Edge{end_node, cost, direction ^ 1}));
+                    }
+                }
+            }
+
+            // the corridor of the start cell can lead to the end cell at once
+            vector<Edge> start_edges;
+            if(start_node == number_nodes)
+            {
+                unsigned start_mask = this->neighbor_mask.getMask(start_cell);
+                for(; start_mask != 0; start_mask &= start_mask - 1)
+                {
+                    int cell = start_cell;
+                    int first_direction = __builtin_ctz(start_mask);
+                    int direction = first_direction;
+                    int cost = walkCorridor(cell, direction, end_cell);
+                    if(cell == end_cell)
+                    {
+                        start_edges.push_back({end_node, cost, first_direction});
+                    }
+                    else if(cell != start_cell)
+                    {
+                        start_edges.push_back({this->cell_nodes[cell], cost, first_direction});
+                    }
+                }
+            }
+
+            // getNodeCell function that returns the cell of any node
+            auto getNodeCell = [&](const int& node)
+            {
+                return node == number_nodes ? start_cell : node == number_nodes + 1 ? end_cell : this->node_cells[node];
+            };
+
+            // getHScore function that returns the Manhattan distance to the end cell
+            auto getHScore = [&](const int& node)
+            {
+                int cell = getNodeCell(node);
+                return abs(grid_map.getRowIndex(cell) - end_row_index) + abs(grid_map.getColIndex(cell) - end_col_index);
+            };
+
+            recordSearch(stats, [&](auto& recorder)
+            {
+                // the edge costs are grid distances, so the Manhattan distance
+                // stays consistent
+                vector<int> g_scores(number_nodes + 2, numeric_limits<int>::max());
+                vector<int> parent_nodes(number_nodes + 2, grid::Constants::INDEX_NOT_FOUND);
+                vector<int> parent_directions(number_nodes + 2, 0);
+                vector<uint8_t> visited_nodes(number_nodes + 2, false);
+                IndexedPriorityQueue open_list(number_nodes + 2);
+                recorder.allocate(static_cast<size_t>(number_nodes + 2) * (5 * sizeof(int) + sizeof(uint8_t)));
+
+                auto relaxEdge = [&](const int& current_node, Edge const& edge)
+                {
+                    int g_score = g_scores[current_node] + edge.cost;
+                    if(visited_nodes[edge.target_node] || g_score >= g_scores[edge.target_node])
+                    {
+                        return;
+                    }
+
+                    int h_score = getHScore(edge.target_node);
+                    g_scores[edge.target_node] = g_score;
+                    parent_nodes[edge.target_node] = current_node;
+                    parent_directions[edge.target_node] = edge.direction;
+
+                    if(open_list.contains(edge.target_node))
+                    {
+                        open_list.decreaseKey(edge.target_node, g_score + h_score, h_score);
+                        recorder.decreaseKey();
+                    }
+                    else
+                    {
+                        open_list.push(edge.target_node, g_score + h_score, h_score);
+                        recorder.push(open_list.size());
+                    }
+                };
+
+                g_scores[start_node] = 0;
+                open_list.push(start_node, getHScore(start_node), getHScore(start_node));
+                recorder.push(open_list.size());
+
+                while(!open_list.empty())
+                {
+                    int current_node = open_list.pop();
+                    recorder.expand();
+
+                    if(current_node == end_node)
+                    {
+                        break;
+                    }
+
+                    visited_nodes[current_node] = true;
+
+                    if(current_node == number_nodes)
+                    {
+                        for(auto const& edge : start_edges)
+                        {
+                            relaxEdge(current_node, edge);
+                        }
+                        continue;
+                    }
+
+                    for(int edge_index = this->edge_offsets[current_node]; edge_index < this->edge_offsets[current_node + 1]; edge_index++)
+                    {
+                        relaxEdge(current_node, this->edges[edge_index]);
+                    }
+
+                    for(auto const& end_edge : end_edges)
+                    {
+                        if(end_edge.first == current_node)
+                        {
+                            relaxEdge(current_node, end_edge.second);
+                        }
+                    }
+                }
+
+                if(g_scores[end_node] == numeric_limits<int>::max())
+                {
+                    return;
+                }
+
+                // walk the corridor of every edge from its first node. The
+                // g-score of the first node is the index of its first step.
+                startPath(make_pair(start_row_index, start_col_index), make_pair(end_row_index, end_col_index), g_scores[end_node], path);
+                for(int node = end_node; node != start_node; node = parent_nodes[node])
+                {
+                    int cell = getNodeCell(parent_nodes[node]);
+                    int direction = parent_directions[node];
+                    int first_step_index = g_scores[parent_nodes[node]];
+                    int cost = g_scores[node] - first_step_index;
+
+                    for(int step = 0; step < cost; step++)
+                    {
+                        cell += this->direction_offsets[direction];
+                        writeStep(grid_map, cell, direction, first_step_index + step, path);
+                        if(step + 1 < cost)
+                        {
+                            direction = __builtin_ctz(this->neighbor_mask.getMask(cell) & ~(1u << (direction ^ 1)));
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,378 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // levels with less work than this are expanded on the calling
+            // thread, because starting the threads would cost more
+            constexpr int PARALLEL_LEVEL_SIZE = 1 << 12;
+
+            // a level is expanded with bitwise operations once the frontier
+            // has at least one cell for every DENSE_WORDS_PER_CELL words of
+            // the window it spans
+            constexpr int DENSE_WORDS_PER_CELL = 4;
+
+            // startPath functions that start a path at a cell, with room for
+            // its number of moves
+            void startPath(const int& row_index, const int& col_index, const uint32_t& number_moves, vector<pair<int, int>>& path)
+            {
+                path.reserve(path.size() + number_moves + 1);
+                path.push_back(make_pair(row_index, col_index));
+            }
+
+            void startPath(const int& row_index, const int& col_index, const uint32_t& number_moves, grid::PackedPath& path)
+            {
+                path = grid::PackedPath(row_index, col_index);
+                path.reserve(number_moves);
+            }
+
+            // addStep functions that add the step in the given move to a cell
+            void addStep(const int& row_index, const int& col_index, const uint8_t&, vector<pair<int, int>>& path)
+            {
+                path.push_back(make_pair(row_index, col_index));
+            }
+
+            void addStep(const int&, const int&, const uint8_t& move, grid::PackedPath& path)
+            {
+                path.addMove(move);
+            }
+
+            // smaller frontiers, such as the few cells of a corridor, are
+            // always expanded cell by cell
+            constexpr size_t DENSE_FRONTIER_SIZE = 64;
+
+            // BitmapShift struct that reads a bitmap shifted by a number of
+            // bits, word by word. The word at word_index of the shifted
+            // bitmap holds the bits of the cells cell - offset.
+            struct BitmapShift
+            {
+                int word_offset;
+                int bit_offset;
+
+                BitmapShift(const int& offset) : word_offset(offset >> 6), bit_offset(offset & 63) {}
+
+                uint64_t getWord(vector<uint64_t> const& words, const int& word_index) const
+                {
+                    auto getSourceWord = [&words](const int& source_index)
+                    {
+                        return source_index >= 0 && source_index < static_cast<int>(words.size()) ? words[source_index] : uint64_t(0);
+                    };
+
+                    uint64_t word = getSourceWord(word_index - word_offset) << bit_offset;
+                    if(bit_offset != 0)
+                    {
+                        word |= getSourceWord(word_index - word_offset - 1) >> (64 - bit_offset);
+                    }
+
+                    return word;
+                }
+            };
+        }
+
+        DistanceField::DistanceField(grid::GridMap const& grid_map, const int& goal_row_index, const int& goal_col_index, const int& number_threads, const int& stop_row_index, const int& stop_col_index, SearchStats* stats)
+        {
+            if(goal_row_index < 0 || goal_row_index >= grid_map.getNumberRows() || goal_col_index < 0 || goal_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid goal cell.");
+            }
+
+            bool has_stop_cell = stop_row_index != grid::Constants::INDEX_NOT_FOUND || stop_col_index != grid::Constants::INDEX_NOT_FOUND;
+            if(has_stop_cell && (stop_row_index < 0 || stop_row_index >= grid_map.getNumberRows() || stop_col_index < 0 || stop_col_index >= grid_map.getNumberCols()))
+            {
+                throw invalid_argument("Invalid stop cell.");
+            }
+
+            this->number_rows = grid_map.getNumberRows();
+            this->number_cols = grid_map.getNumberCols();
+            this->row_stride = grid_map.getRowStride();
+            this->number_levels = 0;
+
+            int number_cells = grid_map.getNumberCellIndices();
+            int number_words = (number_cells + 63) / 64;
+            this->distances.assign(number_cells, UNREACHABLE, grid_map.isDiskBacked());
+
+            int goal_cell = grid_map.getCellIndex(goal_row_index, goal_col_index);
+            int stop_cell = has_stop_cell ? grid_map.getCellIndex(stop_row_index, stop_col_index) : grid::Constants::INDEX_NOT_FOUND;
+            if(!grid_map.isFreeCell(goal_cell))
+            {
+                return;
+            }
+
+            // the free and visited cells as bitmaps over the cell indices.
+            // Cells are claimed in the visited bitmap with an atomic or, so
+            // every cell gets its distance from exactly one thread.
+            vector<uint64_t> free_words(number_words, 0);
+            for(int cell = 0; cell < number_cells; cell++)
+            {
+                if(grid_map.isFreeCell(cell))
+                {
+                    free_words[cell >> 6] |= uint64_t(1) << (cell & 63);
+                }
+            }
+
+            vector<atomic<uint64_t>> visited_words(number_words);
+            for(auto& visited_word : visited_words)
+            {
+                visited_word.store(0, memory_order_relaxed);
+            }
+
+            vector<uint64_t> frontier_words(number_words, 0);
+            vector<int> frontier = {goal_cell};
+            this->distances[goal_cell] = 0;
+            visited_words[goal_cell >> 6].store(uint64_t(1) << (goal_cell & 63), memory_order_relaxed);
+
+            // the threads only write cells, the counters are added up level
+            // by level on the calling thread
+            if(stats != nullptr)
+            {
+                stats->nodes_pushed++;
+                stats->peak_frontier_size = max<int64_t>(stats->peak_frontier_size, 1);
+                stats->bytes_allocated += static_cast<int64_t>(number_cells) * sizeof(uint32_t) + static_cast<int64_t>(number_words) * 3 * sizeof(uint64_t);
+            }
+
+            if(goal_cell == stop_cell)
+            {
+                return;
+            }
+
+            grid::WorkStealingPool pool(number_threads);
+            vector<vector<int>> thread_frontiers(pool.getNumberThreads());
+            const int neighbor_offsets[4] = {-1, 1, -this->row_stride, this->row_stride};
+            const BitmapShift neighbor_shifts[4] = {BitmapShift(1), BitmapShift(-1), BitmapShift(this->row_stride), BitmapShift(-this->row_stride)};
+
+            // runTasks function that splits a level into one task per chunk
+            // of items, on the calling thread if the level is small
+            auto runTasks = [&](const int& number_items, auto const& task)
+            {
+                if(number_items < PARALLEL_LEVEL_SIZE || pool.getNumberThreads() == 1)
+                {
+                    task(0, number_items, 0);
+                    return;
+                }
+
+                int number_tasks = pool.getNumberThreads() * 4;
+                pool.run(number_tasks, [&](const int& task_index, const int& thread_index)
+                {
+                    task(static_cast<long long>(number_items) * task_index / number_tasks, static_cast<long long>(number_items) * (task_index + 1) / number_tasks, thread_index);
+                });
+            };
+
+            for(uint32_t level = 1; !frontier.empty(); level++)
+            {
+                this->number_levels = level;
+
+                // the words of the next level lie within one row of the
+                // words of the current frontier
+                int first_word = 0;
+                int number_window_words = number_words;
+                if(frontier.size() >= DENSE_FRONTIER_SIZE)
+                {
+                    auto bounds = minmax_element(frontier.begin(), frontier.end());
+                    first_word = max(0, (*bounds.first - this->row_stride) >> 6);
+                    number_window_words = min(number_words - 1, (*bounds.second + this->row_stride) >> 6) - first_word + 1;
+                }
+
+                if(static_cast<long long>(frontier.size()) * DENSE_WORDS_PER_CELL >= number_window_words)
+                {
+                    for(auto const& cell : frontier)
+                    {
+                        frontier_words[cell >> 6] |= uint64_t(1) << (cell & 63);
+                    }
+
+                    // every task owns a range of words of the visited bitmap
+                    runTasks(number_window_words, [&](const int& first_index, const int& last_index, const int& thread_index)
+                    {
+                        for(int word_index = first_word + first_index; word_index < first_word + last_index; word_index++)
+                        {
+                            uint64_t neighbor_bits = 0;
+                            for(auto const& neighbor_shift : neighbor_shifts)
+                            {
+                                neighbor_bits |= neighbor_shift.getWord(frontier_words, word_index);
+                            }
+
+                            uint64_t new_bits = neighbor_bits & free_words[word_index] & ~visited_words[word_index].load(memory_order_relaxed);
+                            visited_words[word_index].fetch_or(new_bits, memory_order_relaxed);
+
+                            for(; new_bits != 0; new_bits &= new_bits - 1)
+                            {
+                                int cell = word_index * 64 + __builtin_ctzll(new_bits);
+                                this->distances[cell] = level;
+                                thread_frontiers[thread_index].push_back(cell);
+                            }
+                        }
+                    });
+
+                    for(auto const& cell : frontier)
+                    {
+                        frontier_words[cell >> 6] = 0;
+                    }
+                }
+                else
+                {
+                    runTasks(frontier.size(), [&](const int& first_index, const int& last_index, const int& thread_index)
+                    {
+                        for(int frontier_index = first_index; frontier_index < last_index; frontier_index++)
+                        {
+                            for(auto const& neighbor_offset : neighbor_offsets)
+                            {
+                                int neighbor_cell = frontier[frontier_index] + neighbor_offset;
+                                uint64_t neighbor_bit = uint64_t(1) << (neighbor_cell & 63);
+
+                                if((free_words[neighbor_cell >> 6] & neighbor_bit) != 0 && (visited_words[neighbor_cell >> 6].fetch_or(neighbor_bit, memory_order_relaxed) & neighbor_bit) == 0)
+                                {
+                                    this->distances[neighbor_cell] = level;
+                                    thread_frontiers[thread_index].push_back(neighbor_cell);
+                                }
+                            }
+                        }
+                    });
+                }
+
+                if(stats != nullptr)
+                {
+                    stats->nodes_expanded += frontier.size();
+                }
+
+                // a level expanded on the calling thread is the next frontier
+                frontier.clear();
+                swap(frontier, thread_frontiers[0]);
+                for(auto& thread_frontier : thread_frontiers)
+                {
+                    frontier.insert(frontier.end(), thread_frontier.begin(), thread_frontier.end());
+                    thread_frontier.clear();
+                }
+
+                if(stats != nullptr)
+                {
+                    stats->nodes_pushed += frontier.size();
+                    stats->peak_frontier_size = max<int64_t>(stats->peak_frontier_size, frontier.size());
+                }
+
+                // the levels behind the stop cell can not shorten its path
+                if(stop_cell != grid::Constants::INDEX_NOT_FOUND && this->distances[stop_cell] != UNREACHABLE)
+                {
+                    return;
+                }
+            }
+
+            // the last level found no new cells
+            this->number_levels--;
+        }
+
+        DistanceField::~DistanceField()
+        {
+        }
+
+        void DistanceField::getPath(const int& row_index, const int& col_index, vector<pair<int, int>>& path) const
+        {
+            descendPath(row_index, col_index, path);
+        }
+
+        void DistanceField::getPath(const int& row_index, const int& col_index, grid::PackedPath& path) const
+        {
+            descendPath(row_index, col_index, path);
+        }
+
+        template<typename Path>
+        void DistanceField::descendPath(const int& row_index, const int& col_index, Path& path) const
+        {
+            if(row_index < 0 || row_index >= this->number_rows || col_index < 0 || col_index >= this->number_cols)
+            {
+                throw invalid_argument("Invalid start cell.");
+            }
+
+            int cell = (row_index + 1) * this->row_stride + col_index + 1;
+            if(this->distances[cell] == UNREACHABLE)
+            {
+                return;
+            }
+
+            // walls and the border are UNREACHABLE, so they are never lower.
+            // The neighbors are in the order of the packed moves.
+            const int neighbor_offsets[4] = {-1, 1, -this->row_stride, this->row_stride};
+            startPath(row_index, col_index, this->distances[cell], path);
+            while(this->distances[cell] != 0)
+            {
+                uint8_t move = 0;
+                for(; move < 4; move++)
+                {
+                    if(this->distances[cell + neighbor_offsets[move]] == this->distances[cell] - 1)
+                    {
+                        cell += neighbor_offsets[move];
+                        break;
+                    }
+                }
+
+                addStep(cell / this->row_stride - 1, cell % this->row_stride - 1, move, path);
+            }
+        }
+
+        vector<uint32_t> DistanceField::toRowMajor() const
+        {
+            vector<uint32_t> row_major_distances(static_cast<size_t>(this->number_rows) * this->number_cols);
+            for(int row_index = 0; row_index < this->number_rows; row_index++)
+            {
+                const uint32_t* row = &getDistance(row_index, 0);
+                copy(row, row + this->number_cols, row_major_distances.begin() + static_cast<size_t>(row_index) * this->number_cols);
+            }
+
+            return row_major_distances;
+        }
+
+        namespace
+        {
+            // searchDistanceField function that does the work of
+            // performParallelBFS, writing the path as cells or packed
+            template<typename Path>
+            void searchDistanceField(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats, const int& number_threads)
+            {
+                if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+                {
+                    throw invalid_argument("Invalid start cell.");
+                }
+
+                // the levels grow from the end cell, so the path is read from the
+                // start cell down to it
+                DistanceField distance_field(grid_map, end_row_index, end_col_index, number_threads, start_row_index, start_col_index, stats);
+                distance_field.getPath(start_row_index, start_col_index, path);
+            }
+        }
+
+        void performParallelBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats, const int& number_threads)
+        {
+            searchDistanceField(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, number_threads);
+        }
+
+        void performParallelBFS(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats, const int& number_threads)
+        {
+            searchDistanceField(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats, number_threads);
+        }
+    }
+}
@@ -0,0 +1,275 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <array>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // scores of cells that can not reach the goal, low enough that
+            // adding a heuristic and the key modifier does not overflow
+            constexpr int INFINITE_SCORE = numeric_limits<int>::max() / 4;
+        }
+
+        DStarLite::DStarLite(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& goal_row_index, const int& goal_col_index) : grid_map(grid_map)
+        {
+            if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid start cell.");
+            }
+            else if(goal_row_index < 0 || goal_row_index >= grid_map.getNumberRows() || goal_col_index < 0 || goal_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid goal cell.");
+            }
+
+            this->start_cell = grid_map.getCellIndex(start_row_index, start_col_index);
+            this->goal_cell = grid_map.getCellIndex(goal_row_index, goal_col_index);
+            this->last_start_cell = this->start_cell;
+            this->key_modifier = 0;
+
+            this->g_scores.assign(grid_map.getNumberCellIndices(), INFINITE_SCORE, grid_map.isDiskBacked());
+            this->rhs_scores.assign(grid_map.getNumberCellIndices(), INFINITE_SCORE, grid_map.isDiskBacked());
+            this->open_list.reset(grid_map.getNumberCellIndices(), grid_map.isDiskBacked());
+
+            // the search grows from the goal, which is the only cell whose
+            // rhs-score is not computed from its neighbors
+            this->rhs_scores[this->goal_cell] = 0;
+            auto key = getKey(this->goal_cell);
+            this->open_list.push(this->goal_cell, key.first, key.second);
+        }
+
+        DStarLite::~DStarLite()
+        {
+        }
+
+        array<int, 4> DStarLite::getNeighborCells(const int& cell) const
+        {
+            int row_stride = this->grid_map.getRowStride();
+            return {cell - 1, cell + 1, cell - row_stride, cell + row_stride};
+        }
+
+        int DStarLite::getHeuristic(const int& cell) const
+        {
+            int row_stride = this->grid_map.getRowStride();
+            return abs(cell / row_stride - this->start_cell / row_stride) + abs(cell % row_stride - this->start_cell % row_stride);
+        }
+
+        pair<int, int> DStarLite::getKey(const int& cell) const
+        {
+            int score = min(this->g_scores[cell], this->rhs_scores[cell]);
+            return make_pair(score + getHeuristic(cell) + this->key_modifier, score);
+        }
+
+        int DStarLite::getLookahead(const int& cell) const
+        {
+            // a step costs 1 between two free cells and can not be taken
+            // from or into a wall
+            if(!this->grid_map.isFreeCell(cell))
+            {
+                return INFINITE_SCORE;
+            }
+
+            int lookahead = INFINITE_SCORE;
+            for(auto const& neighbor_cell : getNeighborCells(cell))
+            {
+                if(this->grid_map.isFreeCell(neighbor_cell) && this->g_scores[neighbor_cell] < INFINITE_SCORE)
+                {
+                    lookahead = min(lookahead, this->g_scores[neighbor_cell] + 1);
+                }
+            }
+
+            return lookahead;
+        }
+
+        template<typename Recorder>
+        void DStarLite::updateCell(const int& cell, Recorder& recorder)
+        {
+            bool is_consistent = this->g_scores[cell] == this->rhs_scores[cell];
+            if(!is_consistent)
+            {
+                auto key = getKey(cell);
+                if(this->open_list.contains(cell))
+                {
+                    this->open_list.updateKey(cell, key.first, key.second);
+                    recorder.decreaseKey();
+                }
+                else
+                {
+                    this->open_list.push(cell, key.first, key.second);
+                    recorder.push(this->open_list.size());
+                }
+            }
+            else if(this->open_list.contains(cell))
+            {
+                this->open_list.remove(cell);
+            }
+        }
+
+        template<typename Recorder>
+        void DStarLite::computeShortestPath(Recorder& recorder)
+        {
+            while(!this->open_list.empty())
+            {
+                auto top_key = make_pair(this->open_list.topPriority(), this->open_list.topTieBreaker());
+                if(!(top_key < getKey(this->start_cell)) && this->rhs_scores[this->start_cell] == this->g_scores[this->start_cell])
+                {
+                    break;
+                }
+
+                int cell = this->open_list.top();
+                auto key = getKey(cell);
+                recorder.expand();
+
+                if(top_key < key)
+                {
+                    // the key is out of date since the start moved
+                    this->open_list.updateKey(cell, key.first, key.second);
+                }
+                else if(this->g_scores[cell] > this->rhs_scores[cell])
+                {
+                    // overconsistent, the cell got closer to the goal
+                    this->g_scores[cell] = this->rhs_scores[cell];
+                    this->open_list.remove(cell);
+
+                    if(this->grid_map.isFreeCell(cell))
+                    {
+                        for(auto const& neighbor_cell : getNeighborCells(cell))
+                        {
+                            if(this->grid_map.isFreeCell(neighbor_cell) && neighbor_cell != this->goal_cell && this->g_scores[cell] + 1 < this->rhs_scores[neighbor_cell])
+                            {
+                                this->rhs_scores[neighbor_cell] = this->g_scores[cell] + 1;
+                                updateCell(neighbor_cell, recorder);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    // underconsistent, the path of the cell got longer or cut
+                    this->g_scores[cell] = INFINITE_SCORE;
+                    for(auto const& neighbor_cell : getNeighborCells(cell))
+                    {
+                        if(this->grid_map.isFreeCell(neighbor_cell) && neighbor_cell != this->goal_cell)
+                        {
+                            this->rhs_scores[neighbor_cell] = getLookahead(neighbor_cell);
+                            updateCell(neighbor_cell, recorder);
+                        }
+                    }
+
+                    if(cell != this->goal_cell)
+                    {
+                        this->rhs_scores[cell] = getLookahead(cell);
+                    }
+                    updateCell(cell, recorder);
+                }
+            }
+        }
+
+        void DStarLite::findPath(vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            recordSearch(stats, [&](auto& recorder)
+            {
+                computeShortestPath(recorder);
+            });
+
+            if(this->g_scores[this->start_cell] >= INFINITE_SCORE || !this->grid_map.isFreeCell(this->goal_cell))
+            {
+                return;
+            }
+
+            // every step goes to a neighbor that is one closer to the goal
+            int cell = this->start_cell;
+            path.push_back(make_pair(this->grid_map.getRowIndex(cell), this->grid_map.getColIndex(cell)));
+            while(cell != this->goal_cell)
+            {
+                int next_cell = cell;
+                for(auto const& neighbor_cell : getNeighborCells(cell))
+                {
+                    if(this->grid_map.isFreeCell(neighbor_cell) && this->g_scores[neighbor_cell] < this->g_scores[next_cell])
+                    {
+                        next_cell = neighbor_cell;
+                    }
+                }
+
+                // the scores along the path are consistent, so a step that
+                // does not get closer means the planner was not told about
+                // a changed cell
+                if(next_cell == cell)
+                {
+                    path.clear();
+                    return;
+                }
+
+                cell = next_cell;
+                path.push_back(make_pair(this->grid_map.getRowIndex(cell), this->grid_map.getColIndex(cell)));
+            }
+        }
+
+        void DStarLite::updateCells(vector<grid::CellUpdate> const& cell_updates)
+        {
+            // the cells queued here are counted by the next findPath
+            NoStatsRecorder recorder;
+
+            // the keys already queued were computed for the last start, the
+            // modifier keeps them lower bounds after the start has moved
+            this->key_modifier += getHeuristic(this->last_start_cell);
+            this->last_start_cell = this->start_cell;
+
+            for(auto const& cell_update : cell_updates)
+            {
+                if(cell_update.row_index < 0 || cell_update.row_index >= this->grid_map.getNumberRows() || cell_update.col_index < 0 || cell_update.col_index >= this->grid_map.getNumberCols())
+                {
+                    throw invalid_argument("Invalid cell update.");
+                }
+
+                // the steps into and out of the cell changed, which changes
+                // the lookahead of the cell and of all its neighbors
+                int cell = this->grid_map.getCellIndex(cell_update.row_index, cell_update.col_index);
+                auto neighbor_cells = getNeighborCells(cell);
+                for(auto const& changed_cell : {cell, neighbor_cells[0], neighbor_cells[1], neighbor_cells[2], neighbor_cells[3]})
+                {
+                    if(changed_cell != this->goal_cell)
+                    {
+                        this->rhs_scores[changed_cell] = getLookahead(changed_cell);
+                        updateCell(changed_cell, recorder);
+                    }
+                }
+            }
+        }
+
+        void DStarLite::moveStart(const int& row_index, const int& col_index)
+        {
+            if(row_index < 0 || row_index >= this->grid_map.getNumberRows() || col_index < 0 || col_index >= this->grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid start cell.");
+            }
+
+            this->start_cell = this->grid_map.getCellIndex(row_index, col_index);
+        }
+    }
+}
@@ -0,0 +1,295 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // SplitMix64 class that generates pseudo random numbers. Unlike the
+            // standard distributions, its output is the same on every platform.
+            class SplitMix64
+            {
+                public:
+                    SplitMix64(const uint64_t& seed) : state(seed) {}
+
+                    uint64_t next()
+                    {
+                        uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+                        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+                        return value ^ (value >> 31);
+                    }
+
+                    // nextBelow function that returns a number in [0, bound)
+                    uint32_t nextBelow(const uint32_t& bound)
+                    {
+                        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+                    }
+
+                private:
+                    uint64_t state;
+            };
+
+            // fillWithWalls function that turns every cell into a wall
+            void fillWithWalls(GridMap& grid_map)
+            {
+                for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+                {
+                    fill(grid_map.getRow(row_index), grid_map.getRow(row_index) + grid_map.getNumberCols(), Constants::WALL_CELL);
+                }
+            }
+
+            // carveCell function that turns a cell into a free cell
+            void carveCell(GridMap& grid_map, const int& row_index, const int& col_index)
+            {
+                grid_map.getRow(row_index)[col_index] = Constants::FREE_CELL;
+            }
+
+            // carvePassage function that frees the maze cells a and b, given in
+            // maze cell coordinates, and the wall cell between them
+            void carvePassage(GridMap& grid_map, const int& cell_a, const int& cell_b, const int& maze_cols)
+            {
+                int row_a = 2 * (cell_a / maze_cols) + 1;
+                int col_a = 2 * (cell_a % maze_cols) + 1;
+                int row_b = 2 * (cell_b / maze_cols) + 1;
+                int col_b = 2 * (cell_b % maze_cols) + 1;
+
+                carveCell(grid_map, row_a, col_a);
+                carveCell(grid_map, (row_a + row_b) / 2, (col_a + col_b) / 2);
+                carveCell(grid_map, row_b, col_b);
+            }
+
+            // generateBacktrackerMaze function that carves a perfect maze with
+            // an iterative recursive backtracker
+            void generateBacktrackerMaze(GridMap& grid_map, const int& maze_rows, const int& maze_cols, SplitMix64& random)
+            {
+                vector<uint8_t> visited_cells(static_cast<size_t>(maze_rows) * maze_cols, false);
+                vector<int> cell_stack = {0};
+                visited_cells[0] = true;
+                carveCell(grid_map, 1, 1);
+
+                while(!cell_stack.empty())
+                {
+                    int current_cell = cell_stack.back();
+                    int current_row = current_cell / maze_cols;
+                    int current_col = current_cell % maze_cols;
+
+                    int neighbor_cells[4];
+                    int number_neighbors = 0;
+
+                    if(current_row > 0 && !visited_cells[current_cell - maze_cols])
+                    {
+                        neighbor_cells[number_neighbors++] = current_cell - maze_cols;
+                    }
+                    if(current_row + 1 < maze_rows && !visited_cells[current_cell + maze_cols])
+                    {
+                        neighbor_cells[number_neighbors++] = current_cell + maze_cols;
+                    }
+                    if(current_col > 0 && !visited_cells[current_cell - 1])
+                    {
+                        neighbor_cells[number_neighbors++] = current_cell - 1;
+                    }
+                    if(current_col + 1 < maze_cols && !visited_cells[current_cell + 1])
+                    {
+                        neighbor_cells[number_neighbors++] = current_cell + 1;
+                    }
+
+                    if(number_neighbors == 0)
+                    {
+                        cell_stack.pop_back();
+                        continue;
+                    }
+
+                    int next_cell = neighbor_cells[random.nextBelow(number_neighbors)];
+                    visited_cells[next_cell] = true;
+                    carvePassage(grid_map, current_cell, next_cell, maze_cols);
+                    cell_stack.push_back(next_cell);
+                }
+            }
+
+            // findRoot function that returns the root of a union find set,
+            // halving the path on the way
+            int findRoot(vector<int>& parents, int cell)
+            {
+                while(parents[cell] != cell)
+                {
+                    parents[cell] = parents[parents[cell]];
+                    cell = parents[cell];
+                }
+
+                return cell;
+            }
+
+            // generateKruskalMaze function that builds a perfect maze by removing
+            // the walls between maze cells in random order, unless the cells are
+            // already connected
+            void generateKruskalMaze(GridMap& grid_map, const int& maze_rows, const int& maze_cols, SplitMix64& random)
+            {
+                int number_maze_cells = maze_rows * maze_cols;
+                vector<int> parents(number_maze_cells);
+                iota(parents.begin(), parents.end(), 0);
+
+                // every edge is stored as cell * 2, plus one for the edge below
+                vector<int> edges;
+                edges.reserve(2 * static_cast<size_t>(number_maze_cells));
+                for(int cell = 0; cell < number_maze_cells; cell++)
+                {
+                    if(cell % maze_cols + 1 < maze_cols)
+                    {
+                        edges.push_back(cell * 2);
+                    }
+                    if(cell / maze_cols + 1 < maze_rows)
+                    {
+                        edges.push_back(cell * 2 + 1);
+                    }
+                }
+
+                for(size_t edge_index = edges.size(); edge_index > 1; edge_index--)
+                {
+                    swap(edges[edge_index - 1], edges[random.nextBelow(edge_index)]);
+                }
+
+                carveCell(grid_map, 1, 1);
+                for(auto const& edge : edges)
+                {
+                    int cell_a = edge / 2;
+                    int cell_b = edge % 2 == 0 ? cell_a + 1 : cell_a + maze_cols;
+                    int root_a = findRoot(parents, cell_a);
+                    int root_b = findRoot(parents, cell_b);
+
+                    if(root_a != root_b)
+                    {
+                        parents[root_a] = root_b;
+                        carvePassage(grid_map, cell_a, cell_b, maze_cols);
+                    }
+                }
+            }
+        }
+
+        GridMap generateMaze(const MazeKind& maze_kind, const int& number_rows, const int& number_cols, const uint64_t& seed)
+        {
+            if(number_rows < 4 || number_cols < 4)
+            {
+                throw invalid_argument("Invalid maze dimensions.");
+            }
+
+            GridMap grid_map(number_rows, number_cols);
+            SplitMix64 random(seed);
+
+            // maze cells of perfect mazes and the runs of the winding path sit
+            // on odd rows and columns, the cells in between are walls
+            int maze_rows = (number_rows - 1) / 2;
+            int maze_cols = (number_cols - 1) / 2;
+            int last_maze_row = 2 * maze_rows - 1;
+            int last_maze_col = 2 * maze_cols - 1;
+
+            switch(maze_kind)
+            {
+                case MazeKind::BACKTRACKER:
+                case MazeKind::KRUSKAL:
+                    {
+                        fillWithWalls(grid_map);
+                        if(maze_kind == MazeKind::BACKTRACKER)
+                        {
+                            generateBacktrackerMaze(grid_map, maze_rows, maze_cols, random);
+                        }
+                        else
+                        {
+                            generateKruskalMaze(grid_map, maze_rows, maze_cols, random);
+                        }
+
+                        // entrance on the first row, exit below the last maze cell
+                        carveCell(grid_map, 0, 1);
+                        for(int row_index = last_maze_row + 1; row_index < number_rows; row_index++)
+                        {
+                            carveCell(grid_map, row_index, last_maze_col);
+                        }
+                        break;
+                    }
+                case MazeKind::ROOM:
+                    {
+                        // entrance on the first column, exit on the last row
+                        fillWithWalls(grid_map);
+                        for(int row_index = 1; row_index < number_rows - 1; row_index++)
+                        {
+                            fill(grid_map.getRow(row_index) + 1, grid_map.getRow(row_index) + number_cols - 1, Constants::FREE_CELL);
+                        }
+                        carveCell(grid_map, 1, 0);
+                        carveCell(grid_map, number_rows - 1, number_cols - 2);
+                        break;
+                    }
+                case MazeKind::OBSTACLES:
+                    {
+                        // three in ten cells inside the border are walls
+                        fillWithWalls(grid_map);
+                        for(int row_index = 1; row_index < number_rows - 1; row_index++)
+                        {
+                            uint8_t* row = grid_map.getRow(row_index);
+                            for(int col_index = 1; col_index < number_cols - 1; col_index++)
+                            {
+                                row[col_index] = random.nextBelow(10) < 3 ? Constants::WALL_CELL : Constants::FREE_CELL;
+                            }
+                        }
+                        carveCell(grid_map, 0, 1);
+                        carveCell(grid_map, 1, 1);
+                        carveCell(grid_map, number_rows - 2, number_cols - 2);
+                        carveCell(grid_map, number_rows - 1, number_cols - 2);
+                        break;
+                    }
+                case MazeKind::WINDING:
+                    {
+                        // runs on the odd rows, joined at alternating ends
+                        fillWithWalls(grid_map);
+                        for(int run_index = 0; run_index < maze_rows; run_index++)
+                        {
+                            int row_index = 2 * run_index + 1;
+                            fill(grid_map.getRow(row_index) + 1, grid_map.getRow(row_index) + number_cols - 1, Constants::FREE_CELL);
+
+                            if(run_index + 1 < maze_rows)
+                            {
+                                carveCell(grid_map, row_index + 1, run_index % 2 == 0 ? number_cols - 2 : 1);
+                            }
+                        }
+
+                        // entrance on the first column, exit below the end of the last run
+                        carveCell(grid_map, 1, 0);
+                        int exit_col_index = maze_rows % 2 == 1 ? number_cols - 2 : 1;
+                        for(int row_index = last_maze_row + 1; row_index < number_rows; row_index++)
+                        {
+                            carveCell(grid_map, row_index, exit_col_index);
+                        }
+                        break;
+                    }
+                default:
+                    throw invalid_argument("Invalid maze kind.");
+            }
+
+            return grid_map;
+        }
+    }
+}
@@ -15,12 +15,11 @@
 // If not, see <http://www.gnu.org/licenses/>.
 
 // stl includes
-#include <stack>
-#include <set>
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
-#include <unordered_map>
+#include <limits>
+#include <cstdlib>
 
 // project includes
 #include "maze.hpp"
@@ -31,52 +30,24 @@ namespace maze
     {
         using namespace std;
 
-        // getAllNeighbors function that returns the valid neighbors of a node
-        // Use this if full DFS is required
-        vector<pair<int, int>> getAllNeighbors(vector<vector<int>> const& grid_map, const int& row_index, const int& col_index, const int& number_rows, const int& number_cols)
+        // getNeighborCells function that writes the free neighbors of a cell
+        // into neighbor_cells and returns their number. The wall border of the
+        // grid map makes bounds checks unnecessary.
+        int getNeighborCells(grid::GridMap const& grid_map, const int& cell, int neighbor_cells[4])
         {
-            vector<pair<int, int>> neighbors;
+            const int neighbor_offsets[4] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+            int number_neighbors = 0;
 
-            // check for left neighbor
-            if (col_index - 1 >= 0 && grid_map[row_index][col_index - 1] == 0)
+            // check for left, right, top and bottom neighbors
+            for(auto const& neighbor_offset : neighbor_offsets)
             {
-                neighbors.push_back(make_pair(row_index, col_index - 1));
-            }
-
-            // check for right neighbor
-            if (col_index + 1 < number_cols && grid_map[row_index][col_index + 1] == 0)
-            {
-                neighbors.push_back(make_pair(row_index, col_index + 1));
-            }
-
-            // check for top neighbor
-            if (row_index - 1 >= 0 && grid_map[row_index - 1][col_index] == 0)
-            {
-                neighbors.push_back(make_pair(row_index - 1, col_index));
+                if(grid_map.isFreeCell(cell + neighbor_offset))
+                {
+                    neighbor_cells[number_neighbors++] = cell + neighbor_offset;
+                }
             }
 
-            // check for bottom neighbor
-            if (row_index + 1 < number_rows && grid_map[row_index + 1][col_index] == 0)
-            {
-                neighbors.push_back(make_pair(row_index + 1, col_index));
-            }
-            
-            return neighbors;
-        }
-
-        // getWindingPathNeighbors function that returns the valid neighbors of a node
-        vector<pair<int, int>> getWindingPathNeighbors(vector<vector<int>> const& grid_map, const int& row_index, const int& col_index, const int& number_rows, const int& number_cols)
-        {
-            vector<pair<int, int>> neighbors = getAllNeighbors(grid_map, row_index, col_index, number_rows, number_cols);
-
-            if(neighbors.size() <= 2)
-            {
-                return neighbors;
-            }
-            else
-            {   
-                throw invalid_argument("Invalid map.");
-            }
+            return number_neighbors;
         }
 
         Node::Node(const int& row_index, const int& col_index)
@@ -161,165 +132,81 @@ namespace maze
             }
         }
 
-        void performSimpleDFS(vector<vector<int>> const& grid_map, const int& row_index, const int& col_index, vector<pair<int, int>>& path)
+        void performSimpleDFS(grid::GridMap const& grid_map, const int& row_index, const int& col_index, vector<pair<int, int>>& path, SearchStats* stats)
         {
-            int number_rows = grid_map.size();
-            int number_cols = grid_map[0].size();
+            int number_rows = grid_map.getNumberRows();
+            int number_cols = grid_map.getNumberCols();
 
             if(row_index < 0 || row_index >= number_rows || col_index < 0 || col_index >= number_cols)
             {
                 throw invalid_argument("Invalid start cell.");
             }
             
-            stack<pair<int, int>> stack_for_dfs; // although not required because of assumptions, but using stack for dfs
-            set<pair<int, int>> visited_nodes;
-            
-            // push the starting node to the stack
-            // and mark it as visited
-            stack_for_dfs.push(make_pair(row_index, col_index));
-            visited_nodes.insert(make_pair(row_index, col_index));
-
-            // iterate until the stack is empty
-            while (!stack_for_dfs.empty())
+            recordSearch(stats, [&](auto& recorder)
             {
-                auto current_node = stack_for_dfs.top();
-                path.push_back(current_node);
-                stack_for_dfs.pop();
-
-                try
+                // the visited cells and the stack are kept in the workspace of
+                // the thread, so repeated searches do not allocate
+                SearchWorkspace local_workspace;
+                SearchWorkspace& workspace = grid_map.isDiskBacked() ? local_workspace : SearchWorkspace::getThreadWorkspace();
+                recorder.allocate(workspace.prepare(grid_map.getNumberCellIndices(), grid_map.isDiskBacked()));
+                vector<int>& stack_for_dfs = workspace.getCellStack(); // although not required because of assumptions, but using stack for dfs
+
+                // push the starting node to the stack
+                // and mark it as visited
+                int start_cell = grid_map.getCellIndex(row_index, col_index);
+                stack_for_dfs.push_back(start_cell);
+                workspace.reach(start_cell, 0, -1);
+                recorder.push(stack_for_dfs.size());
+
+                // iterate until the stack is empty
+                while (!stack_for_dfs.empty())
                 {
-                    // get the neighbors of the current node
-                    // and push them to the stack if they are not visited
-                    for(auto neighbor : getWindingPathNeighbors(grid_map, current_node.first, current_node.second, number_rows, number_cols))
+                    int current_cell = stack_for_dfs.back();
+                    path.push_back(make_pair(grid_map.getRowIndex(current_cell), grid_map.getColIndex(current_cell)));
+                    stack_for_dfs.pop_back();
+                    recorder.expand();
+
+                    // a cell of a winding path has at most two neighbors
+                    int neighbor_cells[4];
+                    int number_neighbors = getNeighborCells(grid_map, current_cell, neighbor_cells);
+                    if(number_neighbors > 2)
                     {
-                        if (visited_nodes.find(neighbor) == visited_nodes.end())
+                        throw invalid_argument("Invalid map.");
+                    }
+
+                    // push the neighbors of the current node
+                    // to the stack if they are not visited
+                    for(int neighbor_index = 0; neighbor_index < number_neighbors; neighbor_index++)
+                    {
+                        if(!workspace.isReached(neighbor_cells[neighbor_index]))
                         {
-                            stack_for_dfs.push(neighbor);
-                            visited_nodes.insert(neighbor);
+                            stack_for_dfs.push_back(neighbor_cells[neighbor_index]);
+                            workspace.reach(neighbor_cells[neighbor_index], 0, current_cell);
+                            recorder.push(stack_for_dfs.size());
                         }
                     }
                 }
-                catch(const invalid_argument& e)
-                {
-                    throw invalid_argument("Invalid map.");
-                }
-
-            }
-            
+            });
         }
 
-        struct hash_pair_ints {
-            template <class T1, class T2>
-            size_t operator()(const pair<T1, T2>& p) const
-            {
-                auto hash_of_first = hash<T1>{}(p.first);
-                auto hash_of_second = hash<T2>{}(p.second);
-        
-                if (hash_of_first != hash_of_second) {
-                    return hash_of_first ^ hash_of_second;              
-                }
-                return hash_of_first;
-            }
-        };
-
-        void performAStar(vector<vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path)
+        void performSimpleDFS(vector<vector<int>> const& grid_map, const int& row_index, const int& col_index, vector<pair<int, int>>& path, SearchStats* stats)
         {
-            int number_rows = grid_map.size();
-            int number_cols = grid_map[0].size();
-
-            if(start_row_index < 0 || start_row_index >= number_rows || start_col_index < 0 || start_col_index >= number_cols)
-            {
-                throw invalid_argument("Invalid start cell.");
-            }       
-
-            if(end_row_index < 0 || end_row_index >= number_rows || end_col_index < 0 || end_col_index >= number_cols)
-            {
-                throw invalid_argument("Invalid end cell.");
-            }
-
-            // create a priority queue of nodes
-            // and push the starting node to it
-            set<Node> open_list;
-            open_list.insert(Node(start_row_index, start_col_index));
-            set<pair<int, int>> visited_nodes;
-            unordered_map<pair<int, int>, pair<int, int>, hash_pair_ints> child_parent_map  ;
-
-            // iterate until the open list is empty
-            while(!open_list.empty())
-            {
-                Node current_node = *open_list.begin();
-
-                open_list.erase(open_list.begin());
-
-                // check if the current node is the goal node
-                if(current_node.getRowIndex() == end_row_index && current_node.getColIndex() == end_col_index)
-                {
-                    // backtrack the path
-                    
-                    pair<int, int> current_node = make_pair(end_row_index, end_col_index);
-
-                    while(current_node.first != start_row_index || current_node.second != start_col_index)
-                    {
-                        path.push_back(current_node);
-                        current_node = child_parent_map[current_node];
-                    }
-
-                    path.push_back(current_node);
-                    reverse(path.begin(), path.end());
-                    return;                    
-                }
-
-                // add the current node to the closed list
-                visited_nodes.insert(make_pair(current_node.getRowIndex(), current_node.getColIndex()));
-
-                // get the neighbors of the current node
-                for(auto neighbor : getAllNeighbors(grid_map, current_node.getRowIndex(), current_node.getColIndex(), number_rows, number_cols))
-                {
-                    if(visited_nodes.find(neighbor) == visited_nodes.end())
-                    {
-                        int g_score = current_node.getGScore() + 1;
-                        int h_score = abs(neighbor.first - end_row_index) + abs(neighbor.second - end_col_index);
-                        int f_score = g_score + h_score;
-
-                        // check if the neighbor is already in the open list
-                        // sadly, an O(n) operation. Priority queues do not support search
-                        bool found = false;
-                        for(auto node : open_list)
-                        {
-                            if(node.getRowIndex() == neighbor.first && node.getColIndex() == neighbor.second)
-                            {
-                                if(node.getFScore() > f_score)
-                                {
-                                    node.setGScore(g_score);
-                                    node.setFScore(f_score);
-                                    node.setHScore(h_score);
-                                    node.setParentColIndex(current_node.getColIndex());
-                                    node.setParentRowIndex(current_node.getRowIndex());
-                                    child_parent_map[neighbor] = make_pair(current_node.getRowIndex(), current_node.getColIndex());
-                                }
+            performSimpleDFS(grid::GridMap(grid_map), row_index, col_index, path, stats);
+        }
 
-                                found = true;   
-                                break;
-                            }
-                        }
+        void performAStar(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            performGridSearch(grid_map, FourConnected(), ManhattanHeuristic<FourConnected>(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
 
-                        // if the neighbor is not in the open list
-                        // add it to the open list
-                        if(!found)
-                        {
-                            Node node(neighbor.first, neighbor.second);
-                            node.setGScore(g_score);
-                            node.setFScore(f_score);
-                            node.setHScore(h_score);
-                            node.setParentColIndex(current_node.getColIndex());
-                            node.setParentRowIndex(current_node.getRowIndex());
-                            child_parent_map[neighbor] = make_pair(current_node.getRowIndex(), current_node.getColIndex());
-                            open_list.insert(node);
-                        }
-                    }
+        void performAStar(grid::GridMap const& grid_map, grid::NeighborMask const& neighbor_mask, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            performGridSearch(grid_map, MaskedFourConnected{neighbor_mask}, ManhattanHeuristic<MaskedFourConnected>(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
 
-                }
-            }
+        void performAStar(vector<vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            performAStar(grid::GridMap(grid_map), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
         }
     }
 }
\ No newline at end of file
@@ -17,6 +17,8 @@
 // stl includes
 #include <iostream>
 #include <algorithm> 
+#include <stdexcept>
+#include <chrono>
 
 // project includes
 #include "maze.hpp"
@@ -27,35 +29,128 @@ namespace maze
     {
         using namespace std;
 
-        Grid::Grid(string const& map_file_path)
+        namespace
+        {
+            // getMilliseconds function that returns the time since a point
+            double getMilliseconds(chrono::steady_clock::time_point const& start_time)
+            {
+                return chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count();
+            }
+
+            // performGridSearch function that runs the search core with a
+            // neighbor policy and the heuristic of the solve options. The
+            // octile heuristic is the Manhattan distance without diagonals.
+            template<typename Neighbors, typename Path>
+            void performGridSearch(GridMap const& grid_map, Neighbors const& neighbors, SolveOptions const& options, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, maze::graph::SearchStats* stats)
+            {
+                if(options.search_algorithm == SearchAlgorithm::DIJKSTRA || options.heuristic == SearchHeuristic::ZERO)
+                {
+                    maze::graph::performGridSearch(grid_map, neighbors, maze::graph::ZeroHeuristic(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+                }
+                else if(options.heuristic == SearchHeuristic::MANHATTAN)
+                {
+                    maze::graph::performGridSearch(grid_map, neighbors, maze::graph::ManhattanHeuristic<Neighbors>(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+                }
+                else
+                {
+                    maze::graph::performGridSearch(grid_map, neighbors, maze::graph::OctileHeuristic<Neighbors>(), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+                }
+            }
+
+            // appendCell functions that append a side neighbor of the last
+            // cell to a path of cells or to a packed path, or start the path
+            void appendCell(vector<pair<int, int>>& path, pair<int, int> const& cell)
+            {
+                path.push_back(cell);
+            }
+
+            void appendCell(PackedPath& path, pair<int, int> const& cell)
+            {
+                if(path.empty())
+                {
+                    path = PackedPath(cell.first, cell.second);
+                }
+                else
+                {
+                    path.addMove(PackedPath::getMoveBetween(path.getEndCell(), cell));
+                }
+            }
+
+            // reserveCells functions that make room for a number of cells in
+            // a path of cells or packed
+            void reserveCells(vector<pair<int, int>>& path, const int& number_cells)
+            {
+                path.reserve(number_cells);
+            }
+
+            void reserveCells(PackedPath& path, const int& number_cells)
+            {
+                path.reserve(number_cells - 1);
+            }
+        }
+
+        void writeSolveStats(ostream& output_stream, SolveStats const& stats)
+        {
+            output_stream << "Load time (ms) : " << stats.load_milliseconds << '\n';
+            output_stream << "Index time (ms) : " << stats.index_milliseconds << '\n';
+            output_stream << "Start/end detection time (ms) : " << stats.endpoint_milliseconds << '\n';
+            output_stream << "Validation time (ms) : " << stats.validate_milliseconds << '\n';
+            output_stream << "Search time (ms) : " << stats.search_milliseconds << '\n';
+            output_stream << "Nodes expanded : " << stats.search_stats.nodes_expanded << '\n';
+            output_stream << "Nodes pushed : " << stats.search_stats.nodes_pushed << '\n';
+            output_stream << "Decrease keys : " << stats.search_stats.decrease_keys << '\n';
+            output_stream << "Peak frontier size : " << stats.search_stats.peak_frontier_size << '\n';
+            output_stream << "Bytes allocated : " << stats.search_stats.bytes_allocated << '\n';
+        }
+
+        Grid::Grid(string const& map_file_path, const MapLoadMode& load_mode)
         {
             try
             {
-                grid_map = readMap(map_file_path);
+                loadGridMap(map_file_path, load_mode);
                 is_initialized = true;
             }
             catch(const exception& e)
             {
                 cerr << e.what() << '\n';
                 is_initialized = false;
-            }           
+            }
+        }
+
+        Grid::Grid(istream& map_stream)
+        {
+            initializeGridMap(map_stream);
         }
 
         Grid::~Grid()
         {
-            grid_map.clear();
         }
 
-        const vector<vector<int>>& Grid::getGridMap() const
+        vector<vector<int>> Grid::getGridMap() const
+        {
+            return grid_map.toVectorOfVectors();
+        }
+
+        const GridMap& Grid::getFlatGridMap() const
         {
             return grid_map;
         }
 
-        void Grid::initializeGridMap(string const& map_file_path)
+        const ComponentIndex& Grid::getComponentIndex() const
+        {
+            return component_index;
+        }
+
+        const NeighborMask& Grid::getNeighborMask() const
+        {
+            return neighbor_mask;
+        }
+
+        void Grid::initializeGridMap(string const& map_file_path, const MapLoadMode& load_mode)
         {
             try
             {
-                grid_map = readMap(map_file_path);
+                loadGridMap(map_file_path, load_mode);
                 is_initialized = true;
             }
             catch(const exception& e)
@@ -65,6 +160,94 @@ namespace maze
             }           
         }
 
+        void Grid::initializeGridMap(istream& map_stream)
+        {
+            try
+            {
+                stored_start_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+                stored_end_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+
+                auto load_start_time = chrono::steady_clock::now();
+                grid_map = readMapToDisk(map_stream);
+                load_milliseconds = getMilliseconds(load_start_time);
+
+                buildSearchIndexes();
+                is_initialized = true;
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << '\n';
+                is_initialized = false;
+            }
+        }
+
+        void Grid::loadGridMap(string const& map_file_path, const MapLoadMode& load_mode)
+        {
+            stored_start_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+            stored_end_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+
+            auto load_start_time = chrono::steady_clock::now();
+            bool is_wall_bitmap_loaded = false;
+            if(isBinaryMap(map_file_path))
+            {
+                BinaryMapHeader header;
+                grid_map = readBinaryMap(map_file_path, header, &wall_bitmap);
+                stored_start_cell = make_pair(header.start_row_index, header.start_col_index);
+                stored_end_cell = make_pair(header.end_row_index, header.end_col_index);
+                is_wall_bitmap_loaded = true;
+            }
+            else
+            {
+                grid_map = readMap(map_file_path, load_mode);
+            }
+            load_milliseconds = getMilliseconds(load_start_time);
+
+            buildSearchIndexes(is_wall_bitmap_loaded);
+        }
+
+        void Grid::buildSearchIndexes(const bool& is_wall_bitmap_loaded)
+        {
+            auto index_start_time = chrono::steady_clock::now();
+            if(!is_wall_bitmap_loaded)
+            {
+                wall_bitmap = WallBitmap(grid_map);
+            }
+            component_index = ComponentIndex(grid_map);
+            neighbor_mask = NeighborMask(grid_map);
+            index_milliseconds = getMilliseconds(index_start_time);
+
+            lock_guard<mutex> hierarchy_lock(hierarchy_mutex);
+            hierarchical_map.reset();
+
+            lock_guard<mutex> corridor_lock(corridor_mutex);
+            corridor_graph.reset();
+
+            lock_guard<mutex> region_lock(region_mutex);
+            region_index.reset();
+        }
+
+        maze::graph::HierarchicalMap const& Grid::getHierarchicalMap() const
+        {
+            lock_guard<mutex> hierarchy_lock(hierarchy_mutex);
+            if(!hierarchical_map)
+            {
+                hierarchical_map = make_unique<maze::graph::HierarchicalMap>(grid_map);
+            }
+
+            return *hierarchical_map;
+        }
+
+        maze::graph::CorridorGraph const& Grid::getCorridorGraph() const
+        {
+            lock_guard<mutex> corridor_lock(corridor_mutex);
+            if(!corridor_graph)
+            {
+                corridor_graph = make_unique<maze::graph::CorridorGraph>(grid_map, neighbor_mask);
+            }
+
+            return *corridor_graph;
+        }
+
         const bool& Grid::isInitialized() const
         {
             return is_initialized;
@@ -82,26 +265,19 @@ namespace maze
                 cerr << "Grid map is empty." << endl;
                 return Constants::INDEX_NOT_FOUND;
             }
-            else if(row_index < 0 || row_index >= grid_map.size())
+            else if(row_index < 0 || row_index >= grid_map.getNumberRows())
             {
                 cerr << "Row index is out of bounds." << endl;
                 return Constants::INDEX_NOT_FOUND;
             }
-            else if(grid_map[row_index].empty())
+            else if(grid_map.getNumberCols() == 0)
             {
                 cerr << "Given row of the map is empty." << endl;
                 return Constants::INDEX_NOT_FOUND;
             }
             else
             {
-                if(auto row_itr = find(grid_map[row_index].begin(), grid_map[row_index].end(), 0); row_itr != grid_map[row_index].end())
-                {
-                    return row_itr - grid_map[row_index].begin();
-                }
-                else
-                {
-                    return Constants::INDEX_NOT_FOUND;
-                }
+                return wall_bitmap.findFirstFreeInRow(row_index);
             }
 
             return Constants::INDEX_NOT_FOUND;
@@ -119,20 +295,15 @@ namespace maze
                 cerr << "Grid map is empty." << endl;
                 return Constants::INDEX_NOT_FOUND;
             }
-            else if(col_index < 0 || col_index >= grid_map[0].size())
+            else if(col_index < 0 || col_index >= grid_map.getNumberCols())
             {
                 cerr << "Column index is out of bounds." << endl;
                 return Constants::INDEX_NOT_FOUND;
             }
             else
             {
-                for(int row_index = 0; row_index < grid_map.size(); row_index++)
-                {
-                    if(grid_map[row_index][col_index] == 0)
-                    {
-                        return row_index;
-                    }
-                }
+                // the transposed bitmap keeps the column contiguous
+                return wall_bitmap.findFirstFreeInCol(col_index);
             }
 
             return Constants::INDEX_NOT_FOUND;
@@ -141,230 +312,240 @@ namespace maze
         vector<pair<int, int>> Grid::walkThrouhHallway() const
         {
             vector<pair<int, int>> hallway_cells;
+            walkHallway(hallway_cells);
+            return hallway_cells;
+        }
+
+        PackedPath Grid::walkThroughHallwayPacked() const
+        {
+            PackedPath hallway_path;
+            walkHallway(hallway_path);
+            return hallway_path;
+        }
 
+        template<typename Path>
+        void Grid::walkHallway(Path& hallway_cells) const
+        {
             if(!is_initialized)
             {
                 cerr << "Grid map is not initialized." << endl;
-                return {};
+                return;
             }
             else if(grid_map.empty())
             {
                 cerr << "Grid map is empty." << endl;
-                return {};
+                return;
             }
             else
             {
-                int number_rows = grid_map.size();
-                int number_cols = grid_map[0].size();
+                int number_rows = grid_map.getNumberRows();
 
                 for(int row_index = 0; row_index < number_rows; row_index++)
                 {
                     int col_index = searchARowForEmptySpace(row_index);
                     if(col_index != Constants::INDEX_NOT_FOUND)
                     {
-                        if(row_index + 1 < number_rows && grid_map[row_index + 1][col_index] == 0)
+                        // the border is a wall, so the mask covers the last row and column
+                        uint8_t cell_mask = neighbor_mask.getMask(grid_map.getCellIndex(row_index, col_index));
+                        if(cell_mask & NeighborMask::BOTTOM)
                         {
                             // column hallway found
                             performColumnWalk(hallway_cells, row_index, col_index);
 
-                            return hallway_cells;
+                            return;
                         }
-                        else if(col_index + 1 < number_cols && grid_map[row_index][col_index + 1] == 0)
+                        else if(cell_mask & NeighborMask::RIGHT)
                         {
                             // row hallway found
                             performRowWalk(hallway_cells, row_index, col_index);
                             
-                            return hallway_cells;
+                            return;
                         }
                         else
                         {
                             // just one cell
-                            hallway_cells.push_back(make_pair(row_index, col_index));
-                            return hallway_cells;
+                            appendCell(hallway_cells, make_pair(row_index, col_index));
+                            return;
                         }
                     }
                 }
             }
-
-            return hallway_cells;
         }
 
-        void Grid::performColumnWalk(vector<pair<int, int>>& hallway_cells, const int& row_index, const int& col_index) const
+        template<typename Path>
+        void Grid::performColumnWalk(Path& hallway_cells, const int& row_index, const int& col_index) const
         {
-            int number_rows = grid_map.size();
-            int number_cols = grid_map[0].size();
+            int number_rows = grid_map.getNumberRows();
+            int number_cols = grid_map.getNumberCols();
 
-            hallway_cells.push_back(make_pair(row_index, col_index));
-            int row_ctr = row_index + 1;
-            while(row_ctr < number_rows && grid_map[row_ctr][col_index] == 0)
+            appendCell(hallway_cells, make_pair(row_index, col_index));
+            int row_end = row_index + 1 < number_rows ? wall_bitmap.findFirstWallInCol(col_index, row_index + 1) : number_rows;
+            for(int row_ctr = row_index + 1; row_ctr < row_end; row_ctr++)
             {
-                hallway_cells.push_back(make_pair(row_ctr, col_index));
-                row_ctr++;
+                appendCell(hallway_cells, make_pair(row_ctr, col_index));
             }
         }
 
-        void Grid::performRowWalk(vector<pair<int, int>>& hallway_cells, const int& row_index, const int& col_index) const
+        template<typename Path>
+        void Grid::performRowWalk(Path& hallway_cells, const int& row_index, const int& col_index) const
         {
-            int number_rows = grid_map.size();
-            int number_cols = grid_map[0].size();
+            int number_rows = grid_map.getNumberRows();
+            int number_cols = grid_map.getNumberCols();
 
-            hallway_cells.push_back(make_pair(row_index, col_index));
-            int col_ctr = col_index + 1;
-            while(col_ctr < number_cols && grid_map[row_index][col_ctr] == 0)
+            appendCell(hallway_cells, make_pair(row_index, col_index));
+            int col_end = col_index + 1 < number_cols ? wall_bitmap.findFirstWallInRow(row_index, col_index + 1) : number_cols;
+            for(int col_ctr = col_index + 1; col_ctr < col_end; col_ctr++)
             {
-                hallway_cells.push_back(make_pair(row_index, col_ctr));
-                col_ctr++;
+                appendCell(hallway_cells, make_pair(row_index, col_ctr));
             }
         }
 
         vector<pair<int, int>> Grid::findPathToAndOutOfRoom() const
         {
             vector<pair<int, int>> path;
+            crossRoom(path);
+            return path;
+        }
+
+        PackedPath Grid::findPathToAndOutOfRoomPacked() const
+        {
+            PackedPath path;
+            crossRoom(path);
+            return path;
+        }
 
+        template<typename Path>
+        void Grid::crossRoom(Path& path) const
+        {
             if(!is_initialized)
             {
                 cerr << "Grid map is not initialized." << endl;
-                return {};
+                return;
             }
             else if(grid_map.empty())
             {
                 cerr << "Grid map is empty." << endl;
-                return {};
+                return;
             }
-            else
-            {
-                int number_rows = grid_map.size();
-                int number_cols = grid_map[0].size();
 
-                for(int row_index = 0; row_index < number_rows; row_index++)
+            // the first room of the region index is the room of the maze, see
+            // assumptions in the README.md file
+            RegionIndex const& regions = getRegionIndex();
+            int room = Constants::INDEX_NOT_FOUND;
+            for(int region = 0; region < regions.getNumberRegions() && room == Constants::INDEX_NOT_FOUND; region++)
+            {
+                if(regions.getRegionInfo(region).kind == RegionKind::ROOM)
                 {
-                    int col_index = searchARowForEmptySpace(row_index); // entrance cell may have been found
-                    
-                    if(col_index != Constants::INDEX_NOT_FOUND)
-                    {   
-                        // make sure that the room is valid, see assumptions in the README.md file
-                        if(row_index + 1 < number_rows && grid_map[row_index + 1][col_index] == 0 && col_index + 1 < number_cols && grid_map[row_index][col_index + 1] == 0)
-                        {
-                            cerr << "Invalid room." << endl;
-                            return {};
-                        }
+                    room = region;
+                }
+            }
 
-                        if(row_index + 1 < number_rows && grid_map[row_index + 1][col_index] == 0)
-                        {
-                            // room found below
-                            path.clear();
-                            path.push_back(make_pair(row_index, col_index));
-                            performColumnWalk(path, row_index + 1, col_index);
+            if(room == Constants::INDEX_NOT_FOUND)
+            {
+                cerr << "No room found." << endl;
+                return;
+            }
 
-                            if(path.size() > 2)
-                            {
-                                auto last_element = path.back();
-                                performRowWalk(path, last_element.first, last_element.second + 1);
-
-                                // check if the last is outside the room
-                                last_element = path.back();
-                                if((last_element.first + 1 < number_rows && grid_map[last_element.first + 1][last_element.second] == 1 && grid_map[last_element.first - 1][last_element.second] == 1)
-                                    || (last_element.first + 1 == number_rows && grid_map[last_element.first - 1][last_element.second] == 1)
-                                )
-                                {
-                                    // this is exit
-                                    return path;
-                                }
-                                else if((grid_map[last_element.first - 1][last_element.second] == 0)
-                                    && (last_element.first + 1 < number_rows && grid_map[last_element.first + 1][last_element.second] == 0))
-                                {
-                                    // add the exit
-                                    path.push_back(make_pair(last_element.first + 1, last_element.second));
-                                    return path;
-                                }
-                                else
-                                {                                
-                                    cerr << "Invalid room." << endl;
-                                    return {};
-                                }
-                            }
-                            else
-                            {                                
-                                cerr << "Invalid room. Must be atleast 2 cells wide." << endl; // See assumption in the README.md file  
-                                return {};
-                            }
-                        }
-                        else if(col_index + 1 < number_cols && grid_map[row_index][col_index + 1] == 0)
-                        {
-                            // room found to the right
-                            path.clear();
-                            path.push_back(make_pair(row_index, col_index));
-                            performRowWalk(path, row_index, col_index + 1);
+            Region const& room_info = regions.getRegionInfo(room);
+            if(!room_info.isRectangle())
+            {
+                cerr << "Invalid room." << endl;
+                return;
+            }
 
-                            if(path.size() > 2)
-                            {
-                                auto last_element = path.back();
-                                performColumnWalk(path, last_element.first + 1, last_element.second);
-
-                                // check if the last is outside the room
-                                last_element = path.back();
-                                if((last_element.second + 1 < number_cols && grid_map[last_element.first][last_element.second + 1] == 1 && grid_map[last_element.first][last_element.second - 1] == 1)
-                                    || (last_element.second + 1 == number_cols && grid_map[last_element.first][last_element.second - 1] == 1)
-                                )
-                                {
-                                    // this is exit
-                                    return path;
-                                }
-                                else if((grid_map[last_element.first][last_element.second - 1] == 0)
-                                    && (last_element.second + 1 < number_cols && grid_map[last_element.first][last_element.second + 1] == 0))
-                                {
-                                    // add the exit
-                                    path.push_back(make_pair(last_element.first, last_element.second + 1));
-                                    return path;
-                                }
-                                else
-                                {                                
-                                    cerr << "Invalid room." << endl;
-                                    return {};
-                                }
-                            }
-                            else
-                            {
-                                cerr << "Invalid room. Must be atleast 2 cells wide." << endl; // See assumption in the README.md file  
-                                return {};
-                            }
-                        }
-                        else
-                        {
-                            cerr << "No room found." << endl;
-                            return {};
-                        }
-                    }
+            // the entrance is a door of the top left corner, a door above it is
+            // taken before one to its left. The exit is a door of the bottom
+            // right corner.
+            pair<int, int> top_left_cell = make_pair(room_info.top_row_index, room_info.left_col_index);
+            pair<int, int> bottom_right_cell = make_pair(room_info.bottom_row_index, room_info.right_col_index);
+            pair<int, int> entrance_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+            pair<int, int> exit_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+            for(auto const& door : regions.getRegionDoors(room))
+            {
+                if(door.cell_a == top_left_cell && (entrance_cell.first == Constants::INDEX_NOT_FOUND || door.cell_b.first < top_left_cell.first))
+                {
+                    entrance_cell = door.cell_b;
+                }
+
+                if(door.cell_a == bottom_right_cell && (exit_cell.first == Constants::INDEX_NOT_FOUND || door.cell_b.first > bottom_right_cell.first))
+                {
+                    exit_cell = door.cell_b;
                 }
             }
 
-            return path; // TODO: Explore using graph search algorithms 
+            if(entrance_cell.first == Constants::INDEX_NOT_FOUND || exit_cell.first == Constants::INDEX_NOT_FOUND)
+            {
+                cerr << "Invalid room. The room must have a door at its top left and its bottom right corner." << endl;
+                return;
+            }
+
+            // a room entered from above is crossed down its left column and
+            // along its bottom row, one entered from the left along its top
+            // row and down its right column
+            appendCell(path, entrance_cell);
+            reserveCells(path, (room_info.bottom_row_index - room_info.top_row_index) + (room_info.right_col_index - room_info.left_col_index) + 3);
+            if(entrance_cell.first < top_left_cell.first)
+            {
+                for(int row_index = room_info.top_row_index; row_index <= room_info.bottom_row_index; row_index++)
+                {
+                    appendCell(path, make_pair(row_index, room_info.left_col_index));
+                }
+                for(int col_index = room_info.left_col_index + 1; col_index <= room_info.right_col_index; col_index++)
+                {
+                    appendCell(path, make_pair(room_info.bottom_row_index, col_index));
+                }
+            }
+            else
+            {
+                for(int col_index = room_info.left_col_index; col_index <= room_info.right_col_index; col_index++)
+                {
+                    appendCell(path, make_pair(room_info.top_row_index, col_index));
+                }
+                for(int row_index = room_info.top_row_index + 1; row_index <= room_info.bottom_row_index; row_index++)
+                {
+                    appendCell(path, make_pair(row_index, room_info.right_col_index));
+                }
+            }
+            appendCell(path, exit_cell);
         }
 
         std::vector<std::pair<int, int>> Grid::findWindingPath() const
         {
             vector<pair<int, int>> path;
+            followWindingPath(path);
+            return path;
+        }
+
+        PackedPath Grid::findWindingPathPacked() const
+        {
+            PackedPath path;
+            followWindingPath(path);
+            return path;
+        }
 
+        template<typename Path>
+        void Grid::followWindingPath(Path& path) const
+        {
             if(!is_initialized)
             {
                 cerr << "Grid map is not initialized." << endl;
-                return {};
+                return;
             }
             else if(grid_map.empty())
             {
                 cerr << "Grid map is empty." << endl;
-                return {};
+                return;
             }
             else
             {
-                int number_rows = grid_map.size();
-                int number_cols = grid_map[0].size();
+                int number_rows = grid_map.getNumberRows();
+                int number_cols = grid_map.getNumberCols();
 
                 int row_itr = 0; 
                 int col_itr = 0;
                 
                 // search each row and column for empty space
-                // if found, perform DFS from that cell
+                // if found, follow the corridor from that cell
                 // search begins from the 0th row and 0th column
                 while(row_itr < number_rows || col_itr < number_cols)
                 {   
@@ -373,16 +554,12 @@ namespace maze
                         int col_index = searchARowForEmptySpace(row_itr); 
                         if(col_index != Constants::INDEX_NOT_FOUND)
                         {   
-                            try
-                            {
-                                maze::graph::performSimpleDFS(grid_map, row_itr, col_index, path);  
-                                return path;
-                            }
-                            catch(const exception& e)
+                            if(maze::graph::followCorridor(grid_map, neighbor_mask, row_itr, col_index, path) == maze::graph::CorridorStatus::FORK)
                             {
-                                cerr << e.what() << '\n';
-                                return {};
+                                cerr << "Invalid map." << '\n';
+                                path = Path();
                             }
+                            return;
                         }
                         row_itr++;
                     }
@@ -392,111 +569,474 @@ namespace maze
                         int row_index = searchAColumnForEmptySpace(col_itr);
                         if(row_index != Constants::INDEX_NOT_FOUND)
                         {
-                            try
+                            if(maze::graph::followCorridor(grid_map, neighbor_mask, row_index, col_itr, path) == maze::graph::CorridorStatus::FORK)
                             {
-                                maze::graph::performSimpleDFS(grid_map, row_index, col_itr, path);  
-                                return path;
-                            }
-                            catch(const exception& e)
-                            {
-                                cerr << e.what() << '\n';
-                                return {};
+                                cerr << "Invalid map." << '\n';
+                                path = Path();
                             }
+                            return;
                         }
+                        col_itr++;
                     }
                 }
+            }
+        }
+
+        vector<pair<int, int>> Grid::solveMaze(const SearchAlgorithm& search_algorithm, SolveStats* stats) const
+        {
+            SolveOptions options;
+            options.search_algorithm = search_algorithm;
+            return solveMaze(options, stats);
+        }
 
+        vector<pair<int, int>> Grid::solveMaze(SolveOptions const& options, SolveStats* stats) const
+        {
+            pair<int, int> start_cell;
+            pair<int, int> end_cell;
+            if(!findMazeEndpoints(start_cell, end_cell, stats))
+            {
                 return {};
             }
-            
-            return {};
+
+            return findPath(start_cell, end_cell, options, stats);
+        }
+
+        PackedPath Grid::solveMazePacked(SolveOptions const& options, SolveStats* stats) const
+        {
+            pair<int, int> start_cell;
+            pair<int, int> end_cell;
+            if(!findMazeEndpoints(start_cell, end_cell, stats))
+            {
+                return PackedPath();
+            }
+
+            return findPathPacked(start_cell, end_cell, options, stats);
         }
 
-        vector<pair<int, int>> Grid::solveMaze() const
-        {   
+        bool Grid::findMazeEndpoints(pair<int, int>& start_cell, pair<int, int>& end_cell, SolveStats* stats) const
+        {
+            if(!is_initialized)
+            {
+                cerr << "Grid map is not initialized." << endl;
+                return false;
+            }
+            else if(grid_map.empty())
+            {
+                cerr << "Grid map is empty." << endl;
+                return false;
+            }
+
+            auto endpoint_start_time = chrono::steady_clock::now();
+            if(!findStartCell(start_cell.first, start_cell.second))
+            {
+                cerr << "Could not find start cell." << endl;
+                return false;
+            }
+            else if(!findEndCell(end_cell.first, end_cell.second))
+            {
+                cerr << "Could not find end cell." << endl;
+                return false;
+            }
+
+            if(stats != nullptr)
+            {
+                *stats = SolveStats();
+                stats->load_milliseconds = load_milliseconds;
+                stats->index_milliseconds = index_milliseconds;
+                stats->endpoint_milliseconds = getMilliseconds(endpoint_start_time);
+            }
+
+            return true;
+        }
+
+        vector<pair<int, int>> Grid::findPath(pair<int, int> const& start_cell, pair<int, int> const& end_cell, SolveOptions const& options, SolveStats* stats) const
+        {
             vector<pair<int, int>> path;
+            searchPath(start_cell, end_cell, options, stats, path);
+            return path;
+        }
+
+        PackedPath Grid::findPathPacked(pair<int, int> const& start_cell, pair<int, int> const& end_cell, SolveOptions const& options, SolveStats* stats) const
+        {
+            PackedPath path;
+            searchPath(start_cell, end_cell, options, stats, path);
+            return path;
+        }
+
+        template<typename Path>
+        void Grid::searchPath(pair<int, int> const& start_cell, pair<int, int> const& end_cell, SolveOptions const& options, SolveStats* stats, Path& path) const
+        {
+            maze::graph::SearchStats* search_stats = stats != nullptr ? &stats->search_stats : nullptr;
+            auto validate_start_time = chrono::steady_clock::now();
 
             if(!is_initialized)
             {
                 cerr << "Grid map is not initialized." << endl;
-                return {};
+                return;
             }
             else if(grid_map.empty())
             {
                 cerr << "Grid map is empty." << endl;
-                return {};
+                return;
             }
-            else
+
+            int start_row_index = start_cell.first;
+            int start_col_index = start_cell.second;
+            int end_row_index = end_cell.first;
+            int end_col_index = end_cell.second;
+
+            if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+            {
+                cerr << "Invalid start cell." << endl;
+                return;
+            }
+            else if(end_row_index < 0 || end_row_index >= grid_map.getNumberRows() || end_col_index < 0 || end_col_index >= grid_map.getNumberCols())
             {
-                int number_rows = grid_map.size();
-                int number_cols = grid_map[0].size();
+                cerr << "Invalid end cell." << endl;
+                return;
+            }
 
-                int start_row_index = -1;
-                int start_col_index = -1;
+            // cells in different components, or walls, are never connected
+            bool is_connected = component_index.isConnected(grid_map.getCellIndex(start_row_index, start_col_index), grid_map.getCellIndex(end_row_index, end_col_index));
+            if(stats != nullptr)
+            {
+                stats->validate_milliseconds += getMilliseconds(validate_start_time);
+            }
 
-                // search first row and column for empty space
-                int col_index = searchARowForEmptySpace(0);
+            if(!is_connected)
+            {
+                return;
+            }
 
-                if(col_index == Constants::INDEX_NOT_FOUND)
+            auto search_start_time = chrono::steady_clock::now();
+            try
+            {
+                if(options.search_algorithm == SearchAlgorithm::ASTAR || options.search_algorithm == SearchAlgorithm::DIJKSTRA)
                 {
-                    int row_index = searchAColumnForEmptySpace(0);
-                    if(row_index != Constants::INDEX_NOT_FOUND)
+                    if(options.connectivity == Connectivity::EIGHT)
+                    {
+                        performGridSearch(grid_map, maze::graph::EightConnected<false>(), options, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                    }
+                    else if(options.connectivity == Connectivity::EIGHT_CUTTING_CORNERS)
+                    {
+                        performGridSearch(grid_map, maze::graph::EightConnected<true>(), options, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                    }
+                    else
                     {
-                        start_row_index = row_index;
-                        start_col_index = 0;
+                        performGridSearch(grid_map, maze::graph::MaskedFourConnected{neighbor_mask}, options, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
                     }
                 }
-                else
+                else if(options.connectivity != Connectivity::FOUR)
+                {
+                    cerr << "Diagonal moves are only supported by A* and Dijkstra." << endl;
+                    return;
+                }
+                else if(options.search_algorithm == SearchAlgorithm::JPS)
                 {
-                    start_row_index = 0;
-                    start_col_index = col_index;
+                    maze::graph::performJumpPointSearch(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                }
+                else if(options.search_algorithm == SearchAlgorithm::BIDIRECTIONAL_BFS)
+                {
+                    bool use_two_threads = grid_map.getNumberCellIndices() >= maze::graph::PARALLEL_SEARCH_CELLS;
+                    maze::graph::performBidirectionalBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats, use_two_threads);
+                }
+                else if(options.search_algorithm == SearchAlgorithm::BIDIRECTIONAL_ASTAR)
+                {
+                    maze::graph::performBidirectionalAStar(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                }
+                else if(options.search_algorithm == SearchAlgorithm::HIERARCHICAL)
+                {
+                    getHierarchicalMap().findPath(start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                }
+                else if(options.search_algorithm == SearchAlgorithm::CORRIDOR_GRAPH)
+                {
+                    getCorridorGraph().findPath(start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats);
+                }
+                else if(options.search_algorithm == SearchAlgorithm::PARALLEL_BFS)
+                {
+                    maze::graph::performParallelBFS(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, search_stats, options.number_threads);
                 }
 
-                if(start_row_index == -1 || start_col_index == -1)
+                if(stats != nullptr)
                 {
-                    cerr << "Could not find start cell." << endl;
-                    return {};
+                    stats->search_milliseconds += getMilliseconds(search_start_time);
                 }
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << '\n';
+                path = Path();
+            }
+        }
 
-                int end_row_index = -1;
-                int end_col_index = -1;
+        vector<vector<pair<int, int>>> Grid::findPaths(vector<PathQuery> const& queries, SolveOptions const& options) const
+        {
+            vector<vector<pair<int, int>>> paths(queries.size());
+            answerQueries(queries, options, paths);
+            return paths;
+        }
 
-                // search last row and column for empty space
-                col_index = searchARowForEmptySpace(number_rows - 1);
+        vector<PackedPath> Grid::findPathsPacked(vector<PathQuery> const& queries, SolveOptions const& options) const
+        {
+            vector<PackedPath> paths(queries.size());
+            answerQueries(queries, options, paths);
+            return paths;
+        }
 
-                if(col_index == Constants::INDEX_NOT_FOUND)
+        template<typename Path>
+        void Grid::answerQueries(vector<PathQuery> const& queries, SolveOptions const& options, vector<Path>& paths) const
+        {
+            // build the hierarchical map or corridor graph before the queries
+            // wait for it
+            if((options.search_algorithm == SearchAlgorithm::HIERARCHICAL || options.search_algorithm == SearchAlgorithm::CORRIDOR_GRAPH) && is_initialized && !grid_map.empty())
+            {
+                try
                 {
-                    int row_index = searchAColumnForEmptySpace(number_cols - 1);
-                    if(row_index != Constants::INDEX_NOT_FOUND)
+                    if(options.search_algorithm == SearchAlgorithm::HIERARCHICAL)
+                    {
+                        getHierarchicalMap();
+                    }
+                    else
                     {
-                        end_row_index = row_index;
-                        end_col_index = number_cols - 1;
+                        getCorridorGraph();
                     }
                 }
-                else
+                catch(const exception& e)
                 {
-                    end_row_index = number_rows - 1;
-                    end_col_index = col_index;
+                    cerr << e.what() << '\n';
+                    return;
                 }
+            }
+
+            // the threads are already split over the queries, so a parallel
+            // search runs each query on its own thread
+            SolveOptions query_options = options;
+            query_options.number_threads = 1;
+
+            // every query writes only its own path, so no locking is needed
+            WorkStealingPool pool(options.number_threads);
+            pool.run(queries.size(), [&](const int& query_index, const int&)
+            {
+                searchPath(queries[query_index].start_cell, queries[query_index].end_cell, query_options, nullptr, paths[query_index]);
+            });
+        }
+
+        bool Grid::setCell(const int& row_index, const int& col_index, const bool& is_wall)
+        {
+            return setCells({{row_index, col_index, is_wall}});
+        }
 
-                if(end_row_index == -1 || end_col_index == -1)
+        bool Grid::setCells(vector<CellUpdate> const& cell_updates)
+        {
+            if(!is_initialized)
+            {
+                cerr << "Grid map is not initialized." << endl;
+                return false;
+            }
+
+            // check the whole batch first, so it is applied completely or not at all
+            for(auto const& cell_update : cell_updates)
+            {
+                if(cell_update.row_index < 0 || cell_update.row_index >= grid_map.getNumberRows() || cell_update.col_index < 0 || cell_update.col_index >= grid_map.getNumberCols())
                 {
-                    cerr << "Could not find end cell." << endl;
-                    return {};
+                    cerr << "Invalid cell update." << endl;
+                    return false;
                 }
+            }
 
-                try
+            for(auto const& cell_update : cell_updates)
+            {
+                grid_map.setCell(cell_update.row_index, cell_update.col_index, cell_update.is_wall ? Constants::WALL_CELL : Constants::FREE_CELL);
+                wall_bitmap.setWall(cell_update.row_index, cell_update.col_index, cell_update.is_wall);
+                neighbor_mask.updateCell(grid_map, cell_update.row_index, cell_update.col_index);
+            }
+
+            // opening a cell can join components and closing one can split
+            // them, so they are labeled again once for the whole batch
+            component_index = ComponentIndex(grid_map);
+
+            lock_guard<mutex> hierarchy_lock(hierarchy_mutex);
+            hierarchical_map.reset();
+
+            lock_guard<mutex> corridor_lock(corridor_mutex);
+            corridor_graph.reset();
+
+            lock_guard<mutex> region_lock(region_mutex);
+            region_index.reset();
+
+            return true;
+        }
+
+        const RegionIndex& Grid::getRegionIndex() const
+        {
+            lock_guard<mutex> region_lock(region_mutex);
+            if(!region_index)
+            {
+                region_index = make_unique<RegionIndex>(grid_map);
+            }
+
+            return *region_index;
+        }
+
+        vector<Door> Grid::findRoomRoute(pair<int, int> const& start_cell, pair<int, int> const& end_cell) const
+        {
+            if(!is_initialized)
+            {
+                cerr << "Grid map is not initialized." << endl;
+                return {};
+            }
+            else if(start_cell.first < 0 || start_cell.first >= grid_map.getNumberRows() || start_cell.second < 0 || start_cell.second >= grid_map.getNumberCols())
+            {
+                cerr << "Invalid start cell." << endl;
+                return {};
+            }
+            else if(end_cell.first < 0 || end_cell.first >= grid_map.getNumberRows() || end_cell.second < 0 || end_cell.second >= grid_map.getNumberCols())
+            {
+                cerr << "Invalid end cell." << endl;
+                return {};
+            }
+
+            RegionIndex const& regions = getRegionIndex();
+            int start_region = regions.getRegion(grid_map.getCellIndex(start_cell.first, start_cell.second));
+            int end_region = regions.getRegion(grid_map.getCellIndex(end_cell.first, end_cell.second));
+            if(start_region == Constants::INDEX_NOT_FOUND || end_region == Constants::INDEX_NOT_FOUND)
+            {
+                cerr << "Start or end cell is a wall." << endl;
+                return {};
+            }
+
+            vector<Door> route;
+            regions.findRoute(start_region, end_region, route);
+            return route;
+        }
+
+        unique_ptr<maze::graph::DistanceField> Grid::computeDistanceField(const int& number_threads) const
+        {
+            if(!is_initialized)
+            {
+                cerr << "Grid map is not initialized." << endl;
+                return nullptr;
+            }
+            else if(grid_map.empty())
+            {
+                cerr << "Grid map is empty." << endl;
+                return nullptr;
+            }
+
+            int end_row_index = -1;
+            int end_col_index = -1;
+
+            if(!findEndCell(end_row_index, end_col_index))
+            {
+                cerr << "Could not find end cell." << endl;
+                return nullptr;
+            }
+
+            try
+            {
+                return make_unique<maze::graph::DistanceField>(grid_map, end_row_index, end_col_index, number_threads);
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << '\n';
+                return nullptr;
+            }
+        }
+
+        bool Grid::findStartCell(int& start_row_index, int& start_col_index) const
+        {
+            // a start cell stored with the map takes precedence
+            if(stored_start_cell.first != Constants::INDEX_NOT_FOUND)
+            {
+                start_row_index = stored_start_cell.first;
+                start_col_index = stored_start_cell.second;
+                return true;
+            }
+
+            // search first row and column for empty space
+            int col_index = searchARowForEmptySpace(0);
+
+            if(col_index == Constants::INDEX_NOT_FOUND)
+            {
+                int row_index = searchAColumnForEmptySpace(0);
+                if(row_index != Constants::INDEX_NOT_FOUND)
                 {
-                    maze::graph::performAStar(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path);
-                    return path;
+                    start_row_index = row_index;
+                    start_col_index = 0;
+                    return true;
                 }
-                catch(const exception& e)
+            }
+            else
+            {
+                start_row_index = 0;
+                start_col_index = col_index;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool Grid::findEndCell(int& end_row_index, int& end_col_index) const
+        {
+            // an end cell stored with the map takes precedence
+            if(stored_end_cell.first != Constants::INDEX_NOT_FOUND)
+            {
+                end_row_index = stored_end_cell.first;
+                end_col_index = stored_end_cell.second;
+                return true;
+            }
+
+            int number_rows = grid_map.getNumberRows();
+            int number_cols = grid_map.getNumberCols();
+
+            // search last row and column for empty space
+            int col_index = searchARowForEmptySpace(number_rows - 1);
+
+            if(col_index == Constants::INDEX_NOT_FOUND)
+            {
+                int row_index = searchAColumnForEmptySpace(number_cols - 1);
+                if(row_index != Constants::INDEX_NOT_FOUND)
                 {
-                    cerr << e.what() << '\n';
-                    return {};
+                    end_row_index = row_index;
+                    end_col_index = number_cols - 1;
+                    return true;
+                }
+            }
+            else
+            {
+                end_row_index = number_rows - 1;
+                end_col_index = col_index;
+                return true;
+            }
+
+            return false;
+        }
+
+        void Grid::saveBinaryMap(string const& binary_map_file_path) const
+        {
+            if(!is_initialized)
+            {
+                throw invalid_argument("Grid map is not initialized.");
+            }
+
+            // the endpoints are stored so that loading skips the border search
+            pair<int, int> start_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+            pair<int, int> end_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+
+            if(!grid_map.empty())
+            {
+                if(!findStartCell(start_cell.first, start_cell.second))
+                {
+                    start_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+                }
+
+                if(!findEndCell(end_cell.first, end_cell.second))
+                {
+                    end_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
                 }
             }
-            return {};
+
+            writeBinaryMap(binary_map_file_path, wall_bitmap, start_cell, end_cell);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        GridMap::GridMap()
+        {
+            this->number_rows = 0;
+            this->number_cols = 0;
+            this->row_stride = 2;
+            this->number_cell_indices = 0;
+            this->free_value = Constants::FREE_CELL;
+            this->wall_value = Constants::WALL_CELL;
+            this->cell_data = nullptr;
+        }
+
+        GridMap::GridMap(const int& number_rows, const int& number_cols, const int& row_alignment)
+        {
+            if(number_rows < 0 || number_cols < 0 || row_alignment < 1)
+            {
+                throw invalid_argument("Invalid grid map dimensions.");
+            }
+
+            this->number_rows = number_rows;
+            this->number_cols = number_cols;
+            this->free_value = Constants::FREE_CELL;
+            this->wall_value = Constants::WALL_CELL;
+
+            // one wall cell on each side of the row, rounded up to the alignment
+            this->row_stride = ((number_cols + 2 + row_alignment - 1) / row_alignment) * row_alignment;
+
+            // all cells start as walls, which also builds the border
+            this->cells.assign(static_cast<size_t>(number_rows + 2) * this->row_stride, Constants::WALL_CELL);
+            this->cell_data = this->cells.data();
+            this->number_cell_indices = static_cast<int>(this->cells.size());
+            for(int row_index = 0; row_index < number_rows; row_index++)
+            {
+                fill(getRow(row_index), getRow(row_index) + number_cols, Constants::FREE_CELL);
+            }
+        }
+
+        GridMap::GridMap(vector<vector<int>> const& grid_map, const int& row_alignment)
+            : GridMap(grid_map.size(), grid_map.empty() ? 0 : grid_map[0].size(), row_alignment)
+        {
+            for(int row_index = 0; row_index < this->number_rows; row_index++)
+            {
+                if(static_cast<int>(grid_map[row_index].size()) != this->number_cols)
+                {
+                    throw invalid_argument("Invalid grid map dimensions.");
+                }
+
+                uint8_t* row = getRow(row_index);
+                for(int col_index = 0; col_index < this->number_cols; col_index++)
+                {
+                    row[col_index] = grid_map[row_index][col_index] == 0 ? Constants::FREE_CELL : Constants::WALL_CELL;
+                }
+            }
+        }
+
+        GridMap::GridMap(const GridMap& grid_map)
+        {
+            *this = grid_map;
+        }
+
+        GridMap::GridMap(GridMap&& grid_map) noexcept
+        {
+            *this = move(grid_map);
+        }
+
+        GridMap& GridMap::operator=(const GridMap& grid_map)
+        {
+            if(this != &grid_map)
+            {
+                this->number_rows = grid_map.number_rows;
+                this->number_cols = grid_map.number_cols;
+                this->row_stride = grid_map.row_stride;
+                this->number_cell_indices = grid_map.number_cell_indices;
+                this->free_value = grid_map.free_value;
+                this->wall_value = grid_map.wall_value;
+                this->cells = grid_map.cells;
+                this->mapping = grid_map.mapping;
+                this->cell_data = this->mapping ? grid_map.cell_data : this->cells.data();
+            }
+
+            return *this;
+        }
+
+        GridMap& GridMap::operator=(GridMap&& grid_map) noexcept
+        {
+            if(this != &grid_map)
+            {
+                this->number_rows = grid_map.number_rows;
+                this->number_cols = grid_map.number_cols;
+                this->row_stride = grid_map.row_stride;
+                this->number_cell_indices = grid_map.number_cell_indices;
+                this->free_value = grid_map.free_value;
+                this->wall_value = grid_map.wall_value;
+                this->cells = move(grid_map.cells);
+                this->mapping = move(grid_map.mapping);
+                this->cell_data = this->mapping ? grid_map.cell_data : this->cells.data();
+
+                grid_map.number_rows = 0;
+                grid_map.number_cols = 0;
+                grid_map.number_cell_indices = 0;
+                grid_map.cell_data = nullptr;
+            }
+
+            return *this;
+        }
+
+        GridMap::~GridMap()
+        {
+        }
+
+        GridMap GridMap::fromMappedAscii(shared_ptr<MappedRegion> const& mapping, const int& number_rows, const int& number_cols)
+        {
+            if(!mapping || number_rows < 0 || number_cols < 0)
+            {
+                throw invalid_argument("Invalid grid map dimensions.");
+            }
+
+            GridMap grid_map;
+            grid_map.number_rows = number_rows;
+            grid_map.number_cols = number_cols;
+            grid_map.free_value = '0';
+            grid_map.wall_value = '1';
+            grid_map.mapping = mapping;
+
+            // each line is followed by its line break, which is the right border
+            // of the line and the left border of the next one. The top and
+            // bottom border rows are read from the zeroed bytes around the file.
+            grid_map.row_stride = number_cols + 1;
+            grid_map.number_cell_indices = (number_rows + 2) * grid_map.row_stride;
+            grid_map.cell_data = mapping->getData() - (grid_map.row_stride + 1);
+
+            return grid_map;
+        }
+
+        GridMap GridMap::fromMappedCells(shared_ptr<MappedRegion> const& mapping, const int& number_rows, const int& number_cols)
+        {
+            if(!mapping || number_rows < 0 || number_cols < 0 || mapping->getSize() < (static_cast<size_t>(number_rows) + 2) * (number_cols + 2))
+            {
+                throw invalid_argument("Invalid grid map dimensions.");
+            }
+
+            GridMap grid_map;
+            grid_map.number_rows = number_rows;
+            grid_map.number_cols = number_cols;
+            grid_map.mapping = mapping;
+            grid_map.row_stride = number_cols + 2;
+            grid_map.number_cell_indices = (number_rows + 2) * grid_map.row_stride;
+            grid_map.cell_data = mapping->getData();
+
+            return grid_map;
+        }
+
+        void GridMap::setCell(const int& row_index, const int& col_index, const uint8_t& value)
+        {
+            if(row_index < 0 || row_index >= this->number_rows || col_index < 0 || col_index >= this->number_cols)
+            {
+                throw out_of_range("Cell is out of bounds.");
+            }
+
+            this->cell_data[getCellIndex(row_index, col_index)] = value == Constants::FREE_CELL ? this->free_value : this->wall_value;
+        }
+
+        vector<vector<int>> GridMap::toVectorOfVectors() const
+        {
+            vector<vector<int>> grid_map(this->number_rows, vector<int>(this->number_cols));
+
+            for(int row_index = 0; row_index < this->number_rows; row_index++)
+            {
+                for(int col_index = 0; col_index < this->number_cols; col_index++)
+                {
+                    grid_map[row_index][col_index] = getCell(row_index, col_index);
+                }
+            }
+
+            return grid_map;
+        }
+    }
+}
@@ -0,0 +1,473 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // entrances of at least this many cells get a node pair at both
+            // ends, narrower ones a single node pair in their middle
+            constexpr int WIDE_ENTRANCE_LENGTH = 6;
+
+            // startPath functions that start a path at its start cell. A
+            // packed path gets all of its moves at once, they are then set
+            // in order while the path is refined.
+            void startPath(pair<int, int> const& start_cell, pair<int, int> const&, const int&, vector<pair<int, int>>& path)
+            {
+                path.push_back(start_cell);
+            }
+
+            void startPath(pair<int, int> const& start_cell, pair<int, int> const& end_cell, const int& number_moves, grid::PackedPath& path)
+            {
+                path = grid::PackedPath(start_cell, end_cell, number_moves);
+            }
+
+            // writeStep functions that add the step from a cell to its side
+            // neighbor in another sector
+            void writeStep(grid::GridMap const& grid_map, const int&, const int& to_cell, int64_t&, vector<pair<int, int>>& path)
+            {
+                path.push_back(make_pair(grid_map.getRowIndex(to_cell), grid_map.getColIndex(to_cell)));
+            }
+
+            void writeStep(grid::GridMap const& grid_map, const int& from_cell, const int& to_cell, int64_t& step_index, grid::PackedPath& path)
+            {
+                path.setMove(step_index++, getCellMove(grid_map, from_cell, to_cell));
+            }
+
+            // writeSectorPath functions that add the steps of the path the
+            // workspace found inside a sector by following the parent cells
+            // back from to_cell to from_cell
+            void writeSectorPath(grid::GridMap const& grid_map, SearchWorkspace const& workspace, const int& from_cell, const int& to_cell, int64_t&, vector<pair<int, int>>& path)
+            {
+                size_t first_index = path.size();
+                for(int cell = to_cell; cell != from_cell; cell = workspace.getParentCell(cell))
+                {
+                    path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+                }
+                reverse(path.begin() + first_index, path.end());
+            }
+
+            void writeSectorPath(grid::GridMap const& grid_map, SearchWorkspace const& workspace, const int& from_cell, const int& to_cell, int64_t& step_index, grid::PackedPath& path)
+            {
+                step_index += workspace.getGScore(to_cell);
+                int64_t move_index = step_index;
+                for(int cell = to_cell; cell != from_cell; cell = workspace.getParentCell(cell))
+                {
+                    path.setMove(--move_index, getCellMove(grid_map, workspace.getParentCell(cell), cell));
+                }
+            }
+        }
+
+        HierarchicalMap::HierarchicalMap(grid::GridMap const& grid_map, const int& sector_size) : grid_map(grid_map)
+        {
+            if(sector_size < 2)
+            {
+                throw invalid_argument("Invalid sector size.");
+            }
+
+            int number_rows = grid_map.getNumberRows();
+            int number_cols = grid_map.getNumberCols();
+            this->sector_size = sector_size;
+            this->number_sector_rows = (number_rows + sector_size - 1) / sector_size;
+            this->number_sector_cols = (number_cols + sector_size - 1) / sector_size;
+            this->sector_nodes.resize(static_cast<size_t>(this->number_sector_rows) * this->number_sector_cols);
+
+            // add the entrances on the right and bottom border of every sector
+            unordered_map<int, int> cell_nodes;
+            for(int sector_row = 0; sector_row < this->number_sector_rows; sector_row++)
+            {
+                for(int sector_col = 0; sector_col < this->number_sector_cols; sector_col++)
+                {
+                    int first_row_index = sector_row * sector_size;
+                    int first_col_index = sector_col * sector_size;
+
+                    if(sector_col + 1 < this->number_sector_cols)
+                    {
+                        int border_cell = grid_map.getCellIndex(first_row_index, first_col_index + sector_size - 1);
+                        addEntrances(border_cell, grid_map.getRowStride(), 1, min(sector_size, number_rows - first_row_index), cell_nodes);
+                    }
+
+                    if(sector_row + 1 < this->number_sector_rows)
+                    {
+                        int border_cell = grid_map.getCellIndex(first_row_index + sector_size - 1, first_col_index);
+                        addEntrances(border_cell, 1, grid_map.getRowStride(), min(sector_size, number_cols - first_col_index), cell_nodes);
+                    }
+                }
+            }
+
+            // connect the nodes inside every sector. Every task only adds the
+            // edges of the nodes of its own sector. The scratch files of a
+            // disk backed grid map are only created for one thread.
+            grid::WorkStealingPool pool(grid_map.isDiskBacked() ? 1 : 0);
+            vector<SearchWorkspace> workspaces(pool.getNumberThreads());
+
+            pool.run(this->sector_nodes.size(), [&](const int& sector, const int& thread_index)
+            {
+                SearchWorkspace& workspace = workspaces[thread_index];
+                for(auto const& node : this->sector_nodes[sector])
+                {
+                    exploreSector(workspace, this->node_cells[node], grid::Constants::INDEX_NOT_FOUND, nullptr);
+                    for(auto const& other_node : this->sector_nodes[sector])
+                    {
+                        if(other_node != node && workspace.isReached(this->node_cells[other_node]))
+                        {
+                            this->node_edges[node].push_back({other_node, workspace.getGScore(this->node_cells[other_node])});
+                        }
+                    }
+                }
+            });
+        }
+
+        HierarchicalMap::~HierarchicalMap()
+        {
+        }
+
+        int HierarchicalMap::getNumberEdges() const
+        {
+            int number_edges = 0;
+            for(auto const& edges : this->node_edges)
+            {
+                number_edges += edges.size();
+            }
+
+            return number_edges;
+        }
+
+        int HierarchicalMap::getSector(const int& cell) const
+        {
+            return grid_map.getRowIndex(cell) / this->sector_size * this->number_sector_cols + grid_map.getColIndex(cell) / this->sector_size;
+        }
+
+        void HierarchicalMap::addEntrances(const int& first_cell, const int& step, const int& crossing_offset, const int& length, unordered_map<int, int>& cell_nodes)
+        {
+            // getNode function that returns the node of a cell and adds it
+            // to the sector of the cell if it does not exist yet
+            auto getNode = [&](const int& cell)
+            {
+                if(auto node_itr = cell_nodes.find(cell); node_itr != cell_nodes.end())
+                {
+                    return node_itr->second;
+                }
+
+                int node = this->node_cells.size();
+                this->node_cells.push_back(cell);
+                this->node_edges.emplace_back();
+                this->sector_nodes[getSector(cell)].push_back(node);
+                cell_nodes[cell] = node;
+                return node;
+            };
+
+            // addTransition function that connects a border cell with the
+            // cell on the other side of the border
+            auto addTransition = [&](const int& cell)
+            {
+                int node = getNode(cell);
+                int crossing_node = getNode(cell + crossing_offset);
+                this->node_edges[node].push_back({crossing_node, 1});
+                this->node_edges[crossing_node].push_back({node, 1});
+            };
+
+            // an entrance is a run of border cells that are free on both sides
+            int run_start = grid::Constants::INDEX_NOT_FOUND;
+            for(int index = 0; index <= length; index++)
+            {
+                int cell = first_cell + index * step;
+                bool is_open = index < length && grid_map.isFreeCell(cell) && grid_map.isFreeCell(cell + crossing_offset);
+
+                if(is_open && run_start == grid::Constants::INDEX_NOT_FOUND)
+                {
+                    run_start = index;
+                }
+                else if(!is_open && run_start != grid::Constants::INDEX_NOT_FOUND)
+                {
+                    int run_length = index - run_start;
+                    if(run_length < WIDE_ENTRANCE_LENGTH)
+                    {
+                        addTransition(first_cell + (run_start + run_length / 2) * step);
+                    }
+                    else
+                    {
+                        addTransition(first_cell + run_start * step);
+                        addTransition(first_cell + (index - 1) * step);
+                    }
+                    run_start = grid::Constants::INDEX_NOT_FOUND;
+                }
+            }
+        }
+
+        void HierarchicalMap::exploreSector(SearchWorkspace& workspace, const int& source_cell, const int& target_cell, SearchStats* stats) const
+        {
+            int first_row_index = grid_map.getRowIndex(source_cell) / this->sector_size * this->sector_size;
+            int first_col_index = grid_map.getColIndex(source_cell) / this->sector_size * this->sector_size;
+            int last_row_index = min(first_row_index + this->sector_size, grid_map.getNumberRows()) - 1;
+            int last_col_index = min(first_col_index + this->sector_size, grid_map.getNumberCols()) - 1;
+            const int neighbor_offsets[4] = {-1, 1, -grid_map.getRowStride(), grid_map.getRowStride()};
+
+            // the cell stack of the workspace serves as the queue
+            size_t number_bytes = workspace.prepare(grid_map.getNumberCellIndices(), grid_map.isDiskBacked());
+            vector<int>& cell_queue = workspace.getCellStack();
+            workspace.reach(source_cell, 0, -1);
+            cell_queue.push_back(source_cell);
+
+            size_t queue_index = 0;
+            for(; queue_index < cell_queue.size(); queue_index++)
+            {
+                int current_cell = cell_queue[queue_index];
+                if(current_cell == target_cell)
+                {
+                    queue_index++;
+                    break;
+                }
+
+                for(auto const& neighbor_offset : neighbor_offsets)
+                {
+                    int neighbor_cell = current_cell + neighbor_offset;
+                    if(!grid_map.isFreeCell(neighbor_cell) || workspace.isReached(neighbor_cell))
+                    {
+                        continue;
+                    }
+
+                    int row_index = grid_map.getRowIndex(neighbor_cell);
+                    int col_index = grid_map.getColIndex(neighbor_cell);
+                    if(row_index >= first_row_index && row_index <= last_row_index && col_index >= first_col_index && col_index <= last_col_index)
+                    {
+                        workspace.reach(neighbor_cell, workspace.getGScore(current_cell) + 1, current_cell);
+                        cell_queue.push_back(neighbor_cell);
+                    }
+                }
+            }
+
+            // the queue keeps every cell it held, so its length gives the
+            // pushes and bounds the frontier, and the cells before
+            // queue_index were expanded
+            if(stats != nullptr)
+            {
+                stats->nodes_expanded += queue_index;
+                stats->nodes_pushed += cell_queue.size();
+                stats->peak_frontier_size = max(stats->peak_frontier_size, static_cast<int64_t>(cell_queue.size()));
+                stats->bytes_allocated += number_bytes;
+            }
+        }
+
+        void HierarchicalMap::findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats) const
+        {
+            searchPath(start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        void HierarchicalMap::findPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats) const
+        {
+            searchPath(start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        template<typename Path>
+        void HierarchicalMap::searchPath(const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats) const
+        {
+            if(start_row_index < 0 || start_row_index >= grid_map.getNumberRows() || start_col_index < 0 || start_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid start cell.");
+            }
+
+            if(end_row_index < 0 || end_row_index >= grid_map.getNumberRows() || end_col_index < 0 || end_col_index >= grid_map.getNumberCols())
+            {
+                throw invalid_argument("Invalid end cell.");
+            }
+
+            int start_cell = grid_map.getCellIndex(start_row_index, start_col_index);
+            int end_cell = grid_map.getCellIndex(end_row_index, end_col_index);
+
+            if(start_cell == end_cell)
+            {
+                startPath(make_pair(start_row_index, start_col_index), make_pair(end_row_index, end_col_index), 0, path);
+                return;
+            }
+
+            SearchWorkspace local_workspace;
+            SearchWorkspace& workspace = grid_map.isDiskBacked() ? local_workspace : SearchWorkspace::getThreadWorkspace();
+
+            // the start and the end cell are added as two extra nodes that
+            // are connected to the nodes of their sectors
+            int number_nodes = this->node_cells.size();
+            int start_node = number_nodes;
+            int end_node = number_nodes + 1;
+            int end_sector = getSector(end_cell);
+
+            vector<Edge> end_edges;
+            exploreSector(workspace, end_cell, grid::Constants::INDEX_NOT_FOUND, stats);
+            for(auto const& node : this->sector_nodes[end_sector])
+            {
+                if(workspace.isReached(this->node_cells[node]))
+                {
+                    end_edges.push_back({node, workspace.getGScore(this->node_cells[node])});
+                }
+            }
+
+            vector<Edge> start_edges;
+            exploreSector(workspace, start_cell, grid::Constants::INDEX_NOT_FOUND, stats);
+            for(auto const& node : this->sector_nodes[getSector(start_cell)])
+            {
+                if(workspace.isReached(this->node_cells[node]))
+                {
+                    start_edges.push_back({node, workspace.getGScore(this->node_cells[node])});
+                }
+            }
+
+            if(workspace.isReached(end_cell))
+            {
+                start_edges.push_back({end_node, workspace.getGScore(end_cell)});
+            }
+
+            // getNodeCell function that returns the cell of any node
+            auto getNodeCell = [&](const int& node)
+            {
+                return node == start_node ? start_cell : node == end_node ? end_cell : this->node_cells[node];
+            };
+
+            // getHScore function that returns the Manhattan distance to the end cell
+            auto getHScore = [&](const int& node)
+            {
+                int cell = getNodeCell(node);
+                return abs(grid_map.getRowIndex(cell) - end_row_index) + abs(grid_map.getColIndex(cell) - end_col_index);
+            };
+
+            recordSearch(stats, [&](auto& recorder)
+            {
+                // search the abstract graph with A*. The edge costs are grid
+                // distances, so the Manhattan distance stays consistent.
+                vector<int> g_scores(number_nodes + 2, numeric_limits<int>::max());
+                vector<int> parent_nodes(number_nodes + 2, -1);
+                vector<uint8_t> visited_nodes(number_nodes + 2, false);
+                IndexedPriorityQueue open_list(number_nodes + 2);
+                recorder.allocate(static_cast<size_t>(number_nodes + 2) * (3 * sizeof(int) + sizeof(uint8_t)));
+
+                auto relaxEdge = [&](const int& current_node, Edge const& edge)
+                {
+                    int g_score = g_scores[current_node] + edge.cost;
+                    if(visited_nodes[edge.target_node] || g_score >= g_scores[edge.target_node])
+                    {
+                        return;
+                    }
+
+                    int h_score = getHScore(edge.target_node);
+                    g_scores[edge.target_node] = g_score;
+                    parent_nodes[edge.target_node] = current_node;
+
+                    if(open_list.contains(edge.target_node))
+                    {
+                        open_list.decreaseKey(edge.target_node, g_score + h_score, h_score);
+                        recorder.decreaseKey();
+                    }
+                    else
+                    {
+                        open_list.push(edge.target_node, g_score + h_score, h_score);
+                        recorder.push(open_list.size());
+                    }
+                };
+
+                g_scores[start_node] = 0;
+                open_list.push(start_node, getHScore(start_node), getHScore(start_node));
+                recorder.push(open_list.size());
+
+                while(!open_list.empty())
+                {
+                    int current_node = open_list.pop();
+                    recorder.expand();
+
+                    if(current_node == end_node)
+                    {
+                        break;
+                    }
+
+                    visited_nodes[current_node] = true;
+
+                    if(current_node == start_node)
+                    {
+                        for(auto const& edge : start_edges)
+                        {
+                            relaxEdge(current_node, edge);
+                        }
+                        continue;
+                    }
+
+                    for(auto const& edge : this->node_edges[current_node])
+                    {
+                        relaxEdge(current_node, edge);
+                    }
+
+                    if(getSector(this->node_cells[current_node]) == end_sector)
+                    {
+                        for(auto const& end_edge : end_edges)
+                        {
+                            if(end_edge.target_node == current_node)
+                            {
+                                relaxEdge(current_node, {end_node, end_edge.cost});
+                            }
+                        }
+                    }
+                }
+
+                if(g_scores[end_node] == numeric_limits<int>::max())
+                {
+                    return;
+                }
+
+                vector<int> abstract_cells;
+                for(int node = end_node; node != -1; node = parent_nodes[node])
+                {
+                    abstract_cells.push_back(getNodeCell(node));
+                }
+                reverse(abstract_cells.begin(), abstract_cells.end());
+
+                // refine the abstract path. Consecutive cells in different
+                // sectors are neighbors, the others are joined by a search
+                // inside their sector. The edge costs are the lengths of
+                // these steps, so the path has g_scores[end_node] moves.
+                int64_t step_index = 0;
+                startPath(make_pair(start_row_index, start_col_index), make_pair(end_row_index, end_col_index), g_scores[end_node], path);
+                for(size_t cell_index = 1; cell_index < abstract_cells.size(); cell_index++)
+                {
+                    int from_cell = abstract_cells[cell_index - 1];
+                    int to_cell = abstract_cells[cell_index];
+
+                    if(from_cell == to_cell)
+                    {
+                        continue;
+                    }
+                    else if(getSector(from_cell) != getSector(to_cell))
+                    {
+                        writeStep(grid_map, from_cell, to_cell, step_index, path);
+                        continue;
+                    }
+
+                    exploreSector(workspace, from_cell, to_cell, stats);
+                    writeSectorPath(grid_map, workspace, from_cell, to_cell, step_index, path);
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,473 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        namespace
+        {
+            // the directions a cell can be entered in, the direction decides
+            // which of its neighbors are pruned
+            constexpr int NUMBER_DIRECTIONS = 4;
+            constexpr int DIRECTION_RIGHT = 0;
+            constexpr int DIRECTION_LEFT = 1;
+            constexpr int DIRECTION_DOWN = 2;
+            constexpr int DIRECTION_UP = 3;
+
+            // JumpPointSearch class that holds the state of one search. Paths
+            // are canonical when they turn vertical as early as possible, so
+            // a horizontal move only turns where the vertical neighbor can
+            // not be reached from the cell behind it, while a vertical move
+            // may always turn. Vertical jumps look for jump points left and
+            // right of every cell they pass.
+            class JumpPointSearch
+            {
+                public:
+                    JumpPointSearch(grid::GridMap const& grid_map, const int& end_cell)
+                        : grid_map(grid_map), row_stride(grid_map.getRowStride()), end_cell(end_cell) {}
+
+                    // getOffset function that returns the cell index offset of a direction
+                    int getOffset(const int& direction) const
+                    {
+                        switch(direction)
+                        {
+                            case DIRECTION_RIGHT: return 1;
+                            case DIRECTION_LEFT: return -1;
+                            case DIRECTION_DOWN: return row_stride;
+                            default: return -row_stride;
+                        }
+                    }
+
+                    // hasForcedNeighbor function that returns true if a vertical
+                    // neighbor of a cell that was entered horizontally is free
+                    // while the cell behind that neighbor is a wall
+                    bool hasForcedNeighbor(const int& cell, const int& offset, const int& vertical_offset) const
+                    {
+                        return grid_map.isFreeCell(cell + vertical_offset) && !grid_map.isFreeCell(cell + vertical_offset - offset);
+                    }
+
+                    // jumpHorizontal function that moves from a cell along its row
+                    // and returns the first jump point, or INDEX_NOT_FOUND
+                    int jumpHorizontal(int cell, const int& offset) const
+                    {
+                        while(true)
+                        {
+                            cell += offset;
+
+                            if(!grid_map.isFreeCell(cell))
+                            {
+                                return grid::Constants::INDEX_NOT_FOUND;
+                            }
+                            else if(cell == end_cell || hasForcedNeighbor(cell, offset, -row_stride) || hasForcedNeighbor(cell, offset, row_stride))
+                            {
+                                return cell;
+                            }
+                        }
+                    }
+
+                    // jumpVertical function that moves from a cell along its column
+                    // and returns the first cell from which a horizontal jump
+                    // finds a jump point, or INDEX_NOT_FOUND
+                    int jumpVertical(int cell, const int& offset) const
+                    {
+                        while(true)
+                        {
+                            cell += offset;
+
+                            if(!grid_map.isFreeCell(cell))
+                            {
+                                return grid::Constants::INDEX_NOT_FOUND;
+                            }
+                            else if(cell == end_cell || jumpHorizontal(cell, 1) != grid::Constants::INDEX_NOT_FOUND || jumpHorizontal(cell, -1) != grid::Constants::INDEX_NOT_FOUND)
+                            {
+                                return cell;
+                            }
+                        }
+                    }
+
+                    // jump function that jumps from a cell in a direction
+                    int jump(const int& cell, const int& direction) const
+                    {
+                        if(direction == DIRECTION_RIGHT || direction == DIRECTION_LEFT)
+                        {
+                            return jumpHorizontal(cell, getOffset(direction));
+                        }
+
+                        return jumpVertical(cell, getOffset(direction));
+                    }
+
+                    // getSuccessorDirections function that returns the directions
+                    // that are not pruned for a cell entered in the given direction
+                    int getSuccessorDirections(const int& cell, const int& direction, int directions[NUMBER_DIRECTIONS]) const
+                    {
+                        int number_directions = 0;
+                        directions[number_directions++] = direction;
+
+                        if(direction == DIRECTION_RIGHT || direction == DIRECTION_LEFT)
+                        {
+                            int offset = getOffset(direction);
+                            if(hasForcedNeighbor(cell, offset, -row_stride))
+                            {
+                                directions[number_directions++] = DIRECTION_UP;
+                            }
+                            if(hasForcedNeighbor(cell, offset, row_stride))
+                            {
+                                directions[number_directions++] = DIRECTION_DOWN;
+                            }
+                        }
+                        else
+                        {
+                            directions[number_directions++] = DIRECTION_RIGHT;
+                            directions[number_directions++] = DIRECTION_LEFT;
+                        }
+
+                        return number_directions;
+                    }
+
+                private:
+                    grid::GridMap const& grid_map;
+                    int row_stride;
+                    int end_cell;
+            };
+
+            // JumpPointWorkspace class that holds the state of the jump point
+            // searches of one thread, one entry per cell, so a search only
+            // costs the cells it touches. A cell keeps its g-score, the jump
+            // point it was reached from and a byte of direction bits: the
+            // low four bits are the directions it was entered in at its
+            // g-score, the high four bits the directions already jumped from
+            // it. Stamps tell the entries of the current search from those
+            // of earlier ones.
+            class JumpPointWorkspace
+            {
+                public:
+                    JumpPointWorkspace() : generation(0) {}
+
+                    // prepare function that starts a new search on a grid map
+                    // with the given number of cell indices. Returns the number
+                    // of bytes allocated, 0 if the workspace was large enough.
+                    size_t prepare(const int& number_cells, const bool& use_disk)
+                    {
+                        size_t number_bytes = 0;
+                        if(static_cast<size_t>(number_cells) > visit_stamps.size() || use_disk != visit_stamps.isOnDisk())
+                        {
+                            visit_stamps.assign(number_cells, 0, use_disk);
+                            g_scores.assign(number_cells, 0, use_disk);
+                            parent_cells.assign(number_cells, -1, use_disk);
+                            direction_bits.assign(number_cells, 0, use_disk);
+                            generation = 0;
+
+                            // the open list resizes its position index to match below
+                            number_bytes = static_cast<size_t>(number_cells) * (sizeof(uint32_t) + 3 * sizeof(int) + sizeof(uint8_t));
+                        }
+
+                        // the stamps of old searches could match again once the
+                        // generation wraps around, so they are cleared then
+                        if(++generation == 0)
+                        {
+                            fill(visit_stamps.data(), visit_stamps.data() + visit_stamps.size(), 0);
+                            generation = 1;
+                        }
+
+                        open_list.reset(visit_stamps.size(), use_disk);
+                        return number_bytes;
+                    }
+
+                    // reach function that records a new g-score of a cell, which
+                    // replaces the directions it was entered and jumped in
+                    void reach(const int& cell, const int& g_score, const int& parent_cell, const uint8_t& entry_directions)
+                    {
+                        visit_stamps[cell] = generation;
+                        g_scores[cell] = g_score;
+                        parent_cells[cell] = parent_cell;
+                        direction_bits[cell] = entry_directions;
+                    }
+
+                    // addEntryDirection function that records one more direction
+                    // a cell was entered in at its g-score. Returns false if the
+                    // direction was recorded already.
+                    bool addEntryDirection(const int& cell, const int& direction)
+                    {
+                        uint8_t direction_bit = 1 << direction;
+                        if(direction_bits[cell] & direction_bit)
+                        {
+                            return false;
+                        }
+
+                        direction_bits[cell] |= direction_bit;
+                        return true;
+                    }
+
+                    // markJumped function that records the given directions as
+                    // jumped from a cell and returns the ones that were not yet
+                    uint8_t markJumped(const int& cell, const uint8_t& directions)
+                    {
+                        uint8_t new_directions = directions & ~(direction_bits[cell] >> NUMBER_DIRECTIONS);
+                        direction_bits[cell] |= new_directions << NUMBER_DIRECTIONS;
+                        return new_directions;
+                    }
+
+                    bool isReached(const int& cell) const { return visit_stamps[cell] == generation; }
+                    const int& getGScore(const int& cell) const { return g_scores[cell]; }
+                    const int& getParentCell(const int& cell) const { return parent_cells[cell]; }
+                    uint8_t getEntryDirections(const int& cell) const { return direction_bits[cell] & ((1 << NUMBER_DIRECTIONS) - 1); }
+                    IndexedPriorityQueue& getOpenList() { return open_list; }
+
+                    // getThreadWorkspace function that returns the workspace of the calling thread
+                    static JumpPointWorkspace& getThreadWorkspace()
+                    {
+                        thread_local JumpPointWorkspace workspace;
+                        return workspace;
+                    }
+
+                private:
+                    grid::ScratchArray<uint32_t> visit_stamps;
+                    grid::ScratchArray<int> g_scores;
+                    grid::ScratchArray<int> parent_cells;
+                    grid::ScratchArray<uint8_t> direction_bits;
+                    uint32_t generation;
+                    IndexedPriorityQueue open_list;
+            };
+
+            // getSegmentOffset function that returns the cell index offset of
+            // one step of the straight jump from a jump point to a cell
+            int getSegmentOffset(grid::GridMap const& grid_map, const int& parent_cell, const int& cell)
+            {
+                if(grid_map.getRowIndex(parent_cell) == grid_map.getRowIndex(cell))
+                {
+                    return cell > parent_cell ? 1 : -1;
+                }
+
+                return cell > parent_cell ? grid_map.getRowStride() : -grid_map.getRowStride();
+            }
+
+            // writeSingleCellPath functions that write the path of a search
+            // whose start is its end
+            void writeSingleCellPath(const int& row_index, const int& col_index, vector<pair<int, int>>& path)
+            {
+                path.push_back(make_pair(row_index, col_index));
+            }
+
+            void writeSingleCellPath(const int& row_index, const int& col_index, grid::PackedPath& path)
+            {
+                path = grid::PackedPath(row_index, col_index);
+            }
+
+            // writeJumpPath functions that backtrack the jump points from the
+            // end cell and fill in the straight segments between them. A
+            // packed path is written from its last move, its number of moves
+            // is the g-score of the end cell.
+            void writeJumpPath(grid::GridMap const& grid_map, JumpPointWorkspace const& workspace, const int& start_cell, const int& end_cell, vector<pair<int, int>>& path)
+            {
+                for(int current_cell = end_cell; current_cell != start_cell; current_cell = workspace.getParentCell(current_cell))
+                {
+                    int parent_cell = workspace.getParentCell(current_cell);
+                    int offset = getSegmentOffset(grid_map, parent_cell, current_cell);
+
+                    for(int cell = current_cell; cell != parent_cell; cell -= offset)
+                    {
+                        path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+                    }
+                }
+
+                path.push_back(make_pair(grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell)));
+                reverse(path.begin(), path.end());
+            }
+
+            void writeJumpPath(grid::GridMap const& grid_map, JumpPointWorkspace const& workspace, const int& start_cell, const int& end_cell, grid::PackedPath& path)
+            {
+                int64_t number_moves = workspace.getGScore(end_cell);
+                path = grid::PackedPath(make_pair(grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell)), make_pair(grid_map.getRowIndex(end_cell), grid_map.getColIndex(end_cell)), number_moves);
+
+                int64_t step_index = number_moves;
+                for(int current_cell = end_cell; current_cell != start_cell; current_cell = workspace.getParentCell(current_cell))
+                {
+                    int parent_cell = workspace.getParentCell(current_cell);
+                    int offset = getSegmentOffset(grid_map, parent_cell, current_cell);
+                    uint8_t move = getCellMove(grid_map, 0, offset);
+
+                    for(int cell = current_cell; cell != parent_cell; cell -= offset)
+                    {
+                        path.setMove(--step_index, move);
+                    }
+                }
+            }
+
+            // searchJumpPoints function that performs jump point search and
+            // writes the path as cells or packed
+            template<typename Path>
+            void searchJumpPoints(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, Path& path, SearchStats* stats)
+            {
+                int number_rows = grid_map.getNumberRows();
+                int number_cols = grid_map.getNumberCols();
+
+                if(start_row_index < 0 || start_row_index >= number_rows || start_col_index < 0 || start_col_index >= number_cols)
+                {
+                    throw invalid_argument("Invalid start cell.");
+                }
+
+                if(end_row_index < 0 || end_row_index >= number_rows || end_col_index < 0 || end_col_index >= number_cols)
+                {
+                    throw invalid_argument("Invalid end cell.");
+                }
+
+                int start_cell = grid_map.getCellIndex(start_row_index, start_col_index);
+                int end_cell = grid_map.getCellIndex(end_row_index, end_col_index);
+
+                if(start_cell == end_cell)
+                {
+                    writeSingleCellPath(start_row_index, start_col_index, path);
+                    return;
+                }
+
+                recordSearch(stats, [&](auto& recorder)
+                {
+                    // the state is kept in the workspace of the thread, so repeated
+                    // searches do not allocate. The state of a disk backed grid map
+                    // is kept on disk as well and released after the search.
+                    JumpPointWorkspace local_workspace;
+                    JumpPointWorkspace& workspace = grid_map.isDiskBacked() ? local_workspace : JumpPointWorkspace::getThreadWorkspace();
+                    recorder.allocate(workspace.prepare(grid_map.getNumberCellIndices(), grid_map.isDiskBacked()));
+
+                    JumpPointSearch jump_point_search(grid_map, end_cell);
+                    IndexedPriorityQueue& open_list = workspace.getOpenList();
+
+                    // getDistance function that returns the Manhattan distance
+                    // between two cells, which is also the cost of a straight jump
+                    auto getDistance = [&grid_map](const int& cell_a, const int& cell_b)
+                    {
+                        return abs(grid_map.getRowIndex(cell_a) - grid_map.getRowIndex(cell_b)) + abs(grid_map.getColIndex(cell_a) - grid_map.getColIndex(cell_b));
+                    };
+
+                    // addSuccessor function that queues the jump point found from a
+                    // cell, or lowers its key if the new path to it is shorter. A
+                    // path as short as the known one that enters in another
+                    // direction is kept as well, because the direction decides
+                    // which neighbors are pruned.
+                    auto addSuccessor = [&](const int& parent_cell, const int& parent_g_score, const int& direction)
+                    {
+                        int jump_point = jump_point_search.jump(parent_cell, direction);
+                        if(jump_point == grid::Constants::INDEX_NOT_FOUND)
+                        {
+                            return;
+                        }
+
+                        int g_score = parent_g_score + getDistance(parent_cell, jump_point);
+                        if(!workspace.isReached(jump_point) || g_score < workspace.getGScore(jump_point))
+                        {
+                            workspace.reach(jump_point, g_score, parent_cell, 1 << direction);
+                        }
+                        else if(g_score > workspace.getGScore(jump_point) || !workspace.addEntryDirection(jump_point, direction) || open_list.contains(jump_point))
+                        {
+                            // a queued cell jumps its new direction once it is expanded
+                            return;
+                        }
+
+                        int h_score = getDistance(jump_point, end_cell);
+                        if(open_list.contains(jump_point))
+                        {
+                            open_list.decreaseKey(jump_point, g_score + h_score, h_score);
+                            recorder.decreaseKey();
+                        }
+                        else
+                        {
+                            open_list.push(jump_point, g_score + h_score, h_score);
+                            recorder.push(open_list.size());
+                        }
+                    };
+
+                    // the start cell has no direction, so no neighbor is pruned. It
+                    // is expanded without going through the open list.
+                    workspace.reach(start_cell, 0, -1, 0);
+                    workspace.markJumped(start_cell, (1 << NUMBER_DIRECTIONS) - 1);
+                    recorder.push(1);
+                    recorder.expand();
+
+                    for(int direction = 0; direction < NUMBER_DIRECTIONS; direction++)
+                    {
+                        addSuccessor(start_cell, 0, direction);
+                    }
+
+                    // iterate until the open list is empty
+                    while(!open_list.empty())
+                    {
+                        int current_cell = open_list.pop();
+                        recorder.expand();
+
+                        // check if the current cell is the goal cell
+                        if(current_cell == end_cell)
+                        {
+                            writeJumpPath(grid_map, workspace, start_cell, end_cell, path);
+                            return;
+                        }
+
+                        // the directions of all entries are jumped once, a cell that
+                        // is queued again for a new entry only jumps the new ones
+                        uint8_t successor_directions = 0;
+                        uint8_t entry_directions = workspace.getEntryDirections(current_cell);
+                        for(int entry_direction = 0; entry_direction < NUMBER_DIRECTIONS; entry_direction++)
+                        {
+                            if(entry_directions & (1 << entry_direction))
+                            {
+                                int directions[NUMBER_DIRECTIONS];
+                                int number_directions = jump_point_search.getSuccessorDirections(current_cell, entry_direction, directions);
+                                for(int direction_index = 0; direction_index < number_directions; direction_index++)
+                                {
+                                    successor_directions |= 1 << directions[direction_index];
+                                }
+                            }
+                        }
+
+                        successor_directions = workspace.markJumped(current_cell, successor_directions);
+                        for(int direction = 0; direction < NUMBER_DIRECTIONS; direction++)
+                        {
+                            if(successor_directions & (1 << direction))
+                            {
+                                addSuccessor(current_cell, workspace.getGScore(current_cell), direction);
+                            }
+                        }
+                    }
+                });
+            }
+        }
+
+        void performJumpPointSearch(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            searchJumpPoints(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        void performJumpPointSearch(grid::GridMap const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, grid::PackedPath& path, SearchStats* stats)
+        {
+            searchJumpPoints(grid_map, start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+
+        void performJumpPointSearch(vector<vector<int>> const& grid_map, const int& start_row_index, const int& start_col_index, const int& end_row_index, const int& end_col_index, vector<pair<int, int>>& path, SearchStats* stats)
+        {
+            performJumpPointSearch(grid::GridMap(grid_map), start_row_index, start_col_index, end_row_index, end_col_index, path, stats);
+        }
+    }
+}
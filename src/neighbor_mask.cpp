@@ -0,0 +1,94 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // computeMask function that returns the free neighbors of a cell
+            // index. The wall border makes bounds checks unnecessary.
+            uint8_t computeMask(GridMap const& grid_map, const int& cell)
+            {
+                int row_stride = grid_map.getRowStride();
+                return grid_map.isFreeCell(cell - 1) * NeighborMask::LEFT
+                    | grid_map.isFreeCell(cell + 1) * NeighborMask::RIGHT
+                    | grid_map.isFreeCell(cell - row_stride) * NeighborMask::TOP
+                    | grid_map.isFreeCell(cell + row_stride) * NeighborMask::BOTTOM;
+            }
+        }
+
+        NeighborMask::NeighborMask()
+        {
+        }
+
+        NeighborMask::NeighborMask(GridMap const& grid_map)
+        {
+            int row_stride = grid_map.getRowStride();
+            uint8_t free_value = grid_map.getFreeValue();
+            this->masks.assign(grid_map.getNumberCellIndices(), 0, grid_map.isDiskBacked());
+
+            // the rows above and below the grid map are its border, so every
+            // row has both neighbor rows
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                const uint8_t* row = grid_map.getRow(row_index);
+                const uint8_t* row_above = row - row_stride;
+                const uint8_t* row_below = row + row_stride;
+                uint8_t* row_masks = &this->masks[grid_map.getCellIndex(row_index, 0)];
+
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++)
+                {
+                    row_masks[col_index] = (row[col_index - 1] == free_value) * LEFT
+                        | (row[col_index + 1] == free_value) * RIGHT
+                        | (row_above[col_index] == free_value) * TOP
+                        | (row_below[col_index] == free_value) * BOTTOM;
+                }
+            }
+        }
+
+        NeighborMask::~NeighborMask()
+        {
+        }
+
+        void NeighborMask::updateCell(GridMap const& grid_map, const int& row_index, const int& col_index)
+        {
+            if(row_index < 0 || row_index >= grid_map.getNumberRows() || col_index < 0 || col_index >= grid_map.getNumberCols())
+            {
+                throw out_of_range("Cell is out of bounds.");
+            }
+
+            // the masks of the border cells stay empty
+            for(auto const& neighbor : {make_pair(row_index, col_index), make_pair(row_index, col_index - 1), make_pair(row_index, col_index + 1), make_pair(row_index - 1, col_index), make_pair(row_index + 1, col_index)})
+            {
+                if(neighbor.first >= 0 && neighbor.first < grid_map.getNumberRows() && neighbor.second >= 0 && neighbor.second < grid_map.getNumberCols())
+                {
+                    int cell = grid_map.getCellIndex(neighbor.first, neighbor.second);
+                    this->masks[cell] = computeMask(grid_map, cell);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,383 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // the row and column steps of the moves left, right, up and down
+            constexpr int MOVE_ROW_STEPS[4] = {0, 0, -1, 1};
+            constexpr int MOVE_COL_STEPS[4] = {-1, 1, 0, 0};
+            constexpr char MOVE_LETTERS[4] = {'L', 'R', 'U', 'D'};
+
+            // the first bytes of a binary path
+            constexpr char BINARY_PATH_MAGIC[4] = {'M', 'Z', 'P', '1'};
+
+            // appendNumber function that appends the decimal digits of a
+            // number to a buffer
+            void appendNumber(string& buffer, const int64_t& number)
+            {
+                char digits[24];
+                auto result = to_chars(digits, digits + sizeof(digits), number);
+                buffer.append(digits, result.ptr);
+            }
+
+            // appendTextCell function that appends a cell of the TEXT format
+            void appendTextCell(string& buffer, pair<int, int> const& cell)
+            {
+                buffer.push_back('(');
+                appendNumber(buffer, cell.first);
+                buffer.append(", ");
+                appendNumber(buffer, cell.second);
+                buffer.append(") -> ");
+            }
+
+            // appendBytes function that appends the bytes of a value, in the
+            // byte order of the machine
+            template<typename T>
+            void appendBytes(string& buffer, const T& value)
+            {
+                buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            // appendRunLengths function that appends the moves of a path as
+            // letters, each followed by its run length if that is above one
+            void appendRunLengths(string& buffer, PackedPath const& path)
+            {
+                for(int64_t step_index = 0; step_index < path.getNumberMoves();)
+                {
+                    uint8_t move = path.getMove(step_index);
+                    int64_t run_length = 1;
+                    while(step_index + run_length < path.getNumberMoves() && path.getMove(step_index + run_length) == move)
+                    {
+                        run_length++;
+                    }
+
+                    buffer.push_back(MOVE_LETTERS[move]);
+                    if(run_length > 1)
+                    {
+                        appendNumber(buffer, run_length);
+                    }
+                    step_index += run_length;
+                }
+            }
+        }
+
+        PackedPath::PackedPath() : start_cell(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND), end_cell(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND), number_moves(0)
+        {
+        }
+
+        PackedPath::PackedPath(const int& start_row_index, const int& start_col_index) : start_cell(start_row_index, start_col_index), end_cell(start_row_index, start_col_index), number_moves(0)
+        {
+        }
+
+        PackedPath::PackedPath(vector<pair<int, int>> const& path) : PackedPath()
+        {
+            if(path.empty())
+            {
+                return;
+            }
+
+            this->start_cell = path.front();
+            this->end_cell = path.front();
+            reserve(path.size() - 1);
+            for(size_t path_index = 1; path_index < path.size(); path_index++)
+            {
+                addMove(getMoveBetween(path[path_index - 1], path[path_index]));
+            }
+        }
+
+        PackedPath::PackedPath(pair<int, int> const& start_cell, pair<int, int> const& end_cell, const int64_t& number_moves) : start_cell(start_cell), end_cell(end_cell), number_moves(0)
+        {
+            if(start_cell.first == Constants::INDEX_NOT_FOUND || number_moves < 0)
+            {
+                throw invalid_argument("Invalid path.");
+            }
+
+            this->number_moves = number_moves;
+            this->words.assign((number_moves + MOVES_PER_WORD - 1) / MOVES_PER_WORD, 0);
+        }
+
+        uint8_t PackedPath::getMoveBetween(pair<int, int> const& cell, pair<int, int> const& next_cell)
+        {
+            int row_step = next_cell.first - cell.first;
+            int col_step = next_cell.second - cell.second;
+            if(abs(row_step) + abs(col_step) != 1)
+            {
+                throw invalid_argument("Only steps between side neighbors can be packed.");
+            }
+
+            return row_step != 0 ? (row_step < 0 ? UP : DOWN) : (col_step < 0 ? LEFT : RIGHT);
+        }
+
+        void PackedPath::reserve(const int64_t& number_moves)
+        {
+            this->words.reserve((number_moves + MOVES_PER_WORD - 1) / MOVES_PER_WORD);
+        }
+
+        void PackedPath::addMove(const uint8_t& move)
+        {
+            if(empty())
+            {
+                throw invalid_argument("A path without a start cell can not be extended.");
+            }
+            else if(move > DOWN)
+            {
+                throw invalid_argument("Invalid move.");
+            }
+
+            if(this->number_moves % MOVES_PER_WORD == 0)
+            {
+                this->words.push_back(0);
+            }
+
+            this->words.back() |= static_cast<uint64_t>(move) << (2 * (this->number_moves % MOVES_PER_WORD));
+            this->number_moves++;
+            this->end_cell.first += MOVE_ROW_STEPS[move];
+            this->end_cell.second += MOVE_COL_STEPS[move];
+        }
+
+        void PackedPath::setMove(const int64_t& step_index, const uint8_t& move)
+        {
+            if(step_index < 0 || step_index >= this->number_moves)
+            {
+                throw invalid_argument("Invalid step.");
+            }
+            else if(move > DOWN)
+            {
+                throw invalid_argument("Invalid move.");
+            }
+
+            int shift = 2 * (step_index % MOVES_PER_WORD);
+            uint64_t& word = this->words[step_index / MOVES_PER_WORD];
+            word = (word & ~(static_cast<uint64_t>(3) << shift)) | (static_cast<uint64_t>(move) << shift);
+        }
+
+        void PackedPath::append(PackedPath const& path)
+        {
+            if(path.empty())
+            {
+                return;
+            }
+            else if(empty())
+            {
+                *this = path;
+                return;
+            }
+            else if(path.start_cell != this->end_cell)
+            {
+                throw invalid_argument("A path can only be appended at the end cell.");
+            }
+
+            // the moves are shifted into the free bits of the last word
+            // unless the path ends on a word boundary
+            int shift = 2 * (this->number_moves % MOVES_PER_WORD);
+            this->words.reserve((this->number_moves + path.number_moves + MOVES_PER_WORD - 1) / MOVES_PER_WORD);
+            for(size_t word_index = 0; word_index < path.words.size(); word_index++)
+            {
+                uint64_t word = path.words[word_index];
+                if(shift == 0)
+                {
+                    this->words.push_back(word);
+                    continue;
+                }
+
+                this->words.back() |= word << shift;
+                int64_t number_moves_left = path.number_moves - static_cast<int64_t>(word_index) * MOVES_PER_WORD;
+                if(number_moves_left > MOVES_PER_WORD - shift / 2)
+                {
+                    this->words.push_back(word >> (64 - shift));
+                }
+            }
+
+            this->number_moves += path.number_moves;
+            this->end_cell = path.end_cell;
+        }
+
+        void PackedPath::reverse()
+        {
+            if(empty())
+            {
+                return;
+            }
+
+            // a move is turned around by flipping its lowest bit
+            PackedPath reversed_path(this->end_cell, this->start_cell, this->number_moves);
+            for(int64_t step_index = 0; step_index < this->number_moves; step_index++)
+            {
+                reversed_path.setMove(this->number_moves - 1 - step_index, getMove(step_index) ^ 1);
+            }
+
+            *this = std::move(reversed_path);
+        }
+
+        vector<pair<int, int>> PackedPath::unpack() const
+        {
+            vector<pair<int, int>> path;
+            if(empty())
+            {
+                return path;
+            }
+
+            path.reserve(getNumberCells());
+            path.push_back(this->start_cell);
+            for(int64_t step_index = 0; step_index < this->number_moves; step_index++)
+            {
+                uint8_t move = getMove(step_index);
+                path.push_back(make_pair(path.back().first + MOVE_ROW_STEPS[move], path.back().second + MOVE_COL_STEPS[move]));
+            }
+
+            return path;
+        }
+
+        void writePath(ostream& output_stream, PackedPath const& path, const PathFormat& format)
+        {
+            string buffer;
+            if(format == PathFormat::BINARY)
+            {
+                buffer.reserve(sizeof(BINARY_PATH_MAGIC) + 2 * sizeof(int32_t) + sizeof(int64_t) + path.getWords().size() * sizeof(uint64_t));
+                buffer.append(BINARY_PATH_MAGIC, sizeof(BINARY_PATH_MAGIC));
+                appendBytes(buffer, static_cast<int32_t>(path.getStartCell().first));
+                appendBytes(buffer, static_cast<int32_t>(path.getStartCell().second));
+                appendBytes(buffer, static_cast<int64_t>(path.getNumberMoves()));
+                buffer.append(reinterpret_cast<const char*>(path.getWords().data()), path.getWords().size() * sizeof(uint64_t));
+            }
+            else if(path.empty())
+            {
+                buffer = format == PathFormat::JSON ? "null\n" : "No path found or an error occured.\n";
+            }
+            else if(format == PathFormat::TEXT)
+            {
+                // every cell takes at most two numbers of 11 characters and
+                // the 8 characters around them
+                buffer.reserve(static_cast<size_t>(path.getNumberCells()) * 30 + 32);
+                buffer.append("Path Start -> ");
+                pair<int, int> cell = path.getStartCell();
+                for(int64_t step_index = 0; step_index <= path.getNumberMoves(); step_index++)
+                {
+                    if(step_index > 0)
+                    {
+                        uint8_t move = path.getMove(step_index - 1);
+                        cell.first += MOVE_ROW_STEPS[move];
+                        cell.second += MOVE_COL_STEPS[move];
+                    }
+
+                    appendTextCell(buffer, cell);
+                }
+                buffer.append("End\n");
+            }
+            else if(format == PathFormat::RLE)
+            {
+                appendNumber(buffer, path.getStartCell().first);
+                buffer.push_back(' ');
+                appendNumber(buffer, path.getStartCell().second);
+                buffer.push_back(' ');
+                appendRunLengths(buffer, path);
+                buffer.push_back('\n');
+            }
+            else
+            {
+                buffer.append("{\"start\":[");
+                appendNumber(buffer, path.getStartCell().first);
+                buffer.push_back(',');
+                appendNumber(buffer, path.getStartCell().second);
+                buffer.append("],\"end\":[");
+                appendNumber(buffer, path.getEndCell().first);
+                buffer.push_back(',');
+                appendNumber(buffer, path.getEndCell().second);
+                buffer.append("],\"length\":");
+                appendNumber(buffer, path.getNumberCells());
+                buffer.append(",\"moves\":\"");
+                appendRunLengths(buffer, path);
+                buffer.append("\"}\n");
+            }
+
+            output_stream.write(buffer.data(), buffer.size());
+        }
+
+        void writePath(ostream& output_stream, vector<pair<int, int>> const& path, const PathFormat& format)
+        {
+            try
+            {
+                writePath(output_stream, PackedPath(path), format);
+            }
+            catch(const invalid_argument&)
+            {
+                if(format != PathFormat::TEXT)
+                {
+                    throw;
+                }
+
+                string buffer = "Path Start -> ";
+                buffer.reserve(path.size() * 30 + 32);
+                for(auto const& cell : path)
+                {
+                    appendTextCell(buffer, cell);
+                }
+                buffer.append("End\n");
+                output_stream.write(buffer.data(), buffer.size());
+            }
+        }
+
+        PackedPath readPath(istream& input_stream)
+        {
+            char magic[sizeof(BINARY_PATH_MAGIC)];
+            int32_t start_row_index = 0;
+            int32_t start_col_index = 0;
+            int64_t number_moves = 0;
+
+            input_stream.read(magic, sizeof(magic));
+            input_stream.read(reinterpret_cast<char*>(&start_row_index), sizeof(start_row_index));
+            input_stream.read(reinterpret_cast<char*>(&start_col_index), sizeof(start_col_index));
+            input_stream.read(reinterpret_cast<char*>(&number_moves), sizeof(number_moves));
+            if(!input_stream || memcmp(magic, BINARY_PATH_MAGIC, sizeof(magic)) != 0 || number_moves < 0)
+            {
+                throw invalid_argument("Invalid binary path.");
+            }
+
+            if(start_row_index == Constants::INDEX_NOT_FOUND)
+            {
+                return PackedPath();
+            }
+
+            PackedPath path(start_row_index, start_col_index);
+            uint64_t word = 0;
+            for(int64_t step_index = 0; step_index < number_moves; step_index++)
+            {
+                if(step_index % PackedPath::MOVES_PER_WORD == 0 && !input_stream.read(reinterpret_cast<char*>(&word), sizeof(word)))
+                {
+                    throw invalid_argument("Invalid binary path.");
+                }
+
+                path.addMove((word >> (2 * (step_index % PackedPath::MOVES_PER_WORD))) & 3);
+            }
+
+            return path;
+        }
+    }
+}
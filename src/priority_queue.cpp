@@ -0,0 +1,261 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        IndexedPriorityQueue::IndexedPriorityQueue(const int& capacity)
+        {
+            this->key_capacity = 0;
+            reset(capacity);
+        }
+
+        IndexedPriorityQueue::~IndexedPriorityQueue()
+        {
+        }
+
+        void IndexedPriorityQueue::reset(const int& capacity, const bool& use_disk)
+        {
+            if(capacity < 0)
+            {
+                throw invalid_argument("Invalid priority queue capacity.");
+            }
+
+            // only the keys that are still queued have to be cleared
+            // when the capacity does not change
+            for(auto const& entry : this->heap)
+            {
+                if(entry.key < static_cast<int>(this->positions.size()))
+                {
+                    this->positions[entry.key] = -1;
+                }
+            }
+            this->heap.clear();
+
+            if(capacity != this->key_capacity || use_disk != this->positions.isOnDisk())
+            {
+                this->positions.assign(capacity, -1, use_disk);
+                this->key_capacity = capacity;
+            }
+        }
+
+        bool IndexedPriorityQueue::empty() const
+        {
+            return this->heap.empty();
+        }
+
+        int IndexedPriorityQueue::size() const
+        {
+            return static_cast<int>(this->heap.size());
+        }
+
+        const int& IndexedPriorityQueue::capacity() const
+        {
+            return this->key_capacity;
+        }
+
+        bool IndexedPriorityQueue::contains(const int& key) const
+        {
+            return key >= 0 && key < this->key_capacity && this->positions[key] != -1;
+        }
+
+        void IndexedPriorityQueue::push(const int& key, const int& priority, const int& tie_breaker)
+        {
+            if(key < 0 || key >= this->key_capacity)
+            {
+                throw out_of_range("Priority queue key is out of bounds.");
+            }
+            else if(this->positions[key] != -1)
+            {
+                throw invalid_argument("Key is already in the priority queue.");
+            }
+
+            this->heap.push_back({priority, tie_breaker, key});
+            this->positions[key] = static_cast<int>(this->heap.size()) - 1;
+            siftUp(this->positions[key]);
+        }
+
+        void IndexedPriorityQueue::decreaseKey(const int& key, const int& priority, const int& tie_breaker)
+        {
+            if(!contains(key))
+            {
+                throw invalid_argument("Key is not in the priority queue.");
+            }
+
+            Entry& entry = this->heap[this->positions[key]];
+            Entry updated_entry = {priority, tie_breaker, key};
+
+            if(isLess(entry, updated_entry))
+            {
+                throw invalid_argument("New priority is higher than the current priority.");
+            }
+
+            entry = updated_entry;
+            siftUp(this->positions[key]);
+        }
+
+        void IndexedPriorityQueue::updateKey(const int& key, const int& priority, const int& tie_breaker)
+        {
+            if(!contains(key))
+            {
+                throw invalid_argument("Key is not in the priority queue.");
+            }
+
+            int heap_index = this->positions[key];
+            this->heap[heap_index] = {priority, tie_breaker, key};
+            siftUp(heap_index);
+            siftDown(this->positions[key]);
+        }
+
+        void IndexedPriorityQueue::remove(const int& key)
+        {
+            if(!contains(key))
+            {
+                throw invalid_argument("Key is not in the priority queue.");
+            }
+
+            int heap_index = this->positions[key];
+            this->positions[key] = -1;
+
+            // move the last entry into the hole, it may have to go either way
+            if(heap_index != static_cast<int>(this->heap.size()) - 1)
+            {
+                int moved_key = this->heap.back().key;
+                this->heap[heap_index] = this->heap.back();
+                this->heap.pop_back();
+                siftUp(heap_index);
+                siftDown(this->positions[moved_key]);
+            }
+            else
+            {
+                this->heap.pop_back();
+            }
+        }
+
+        const int& IndexedPriorityQueue::top() const
+        {
+            if(this->heap.empty())
+            {
+                throw out_of_range("Priority queue is empty.");
+            }
+
+            return this->heap.front().key;
+        }
+
+        const int& IndexedPriorityQueue::topPriority() const
+        {
+            if(this->heap.empty())
+            {
+                throw out_of_range("Priority queue is empty.");
+            }
+
+            return this->heap.front().priority;
+        }
+
+        const int& IndexedPriorityQueue::topTieBreaker() const
+        {
+            if(this->heap.empty())
+            {
+                throw out_of_range("Priority queue is empty.");
+            }
+
+            return this->heap.front().tie_breaker;
+        }
+
+        int IndexedPriorityQueue::pop()
+        {
+            int key = top();
+            remove(key);
+            return key;
+        }
+
+        bool IndexedPriorityQueue::isLess(const Entry& lhs, const Entry& rhs)
+        {
+            if(lhs.priority == rhs.priority)
+            {
+                return lhs.tie_breaker < rhs.tie_breaker;
+            }
+            else
+            {
+                return lhs.priority < rhs.priority;
+            }
+        }
+
+        void IndexedPriorityQueue::siftUp(int heap_index)
+        {
+            Entry entry = this->heap[heap_index];
+
+            // move the parents down until the slot for the entry is found
+            while(heap_index > 0)
+            {
+                int parent_index = (heap_index - 1) / 2;
+                if(!isLess(entry, this->heap[parent_index]))
+                {
+                    break;
+                }
+
+                this->heap[heap_index] = this->heap[parent_index];
+                this->positions[this->heap[heap_index].key] = heap_index;
+                heap_index = parent_index;
+            }
+
+            this->heap[heap_index] = entry;
+            this->positions[entry.key] = heap_index;
+        }
+
+        void IndexedPriorityQueue::siftDown(int heap_index)
+        {
+            int heap_size = static_cast<int>(this->heap.size());
+            Entry entry = this->heap[heap_index];
+
+            // move the smaller child up until the slot for the entry is found
+            while(true)
+            {
+                int child_index = 2 * heap_index + 1;
+                if(child_index >= heap_size)
+                {
+                    break;
+                }
+
+                if(child_index + 1 < heap_size && isLess(this->heap[child_index + 1], this->heap[child_index]))
+                {
+                    child_index++;
+                }
+
+                if(!isLess(this->heap[child_index], entry))
+                {
+                    break;
+                }
+
+                this->heap[heap_index] = this->heap[child_index];
+                this->positions[this->heap[heap_index].key] = heap_index;
+                heap_index = child_index;
+            }
+
+            this->heap[heap_index] = entry;
+            this->positions[entry.key] = heap_index;
+        }
+    }
+}
@@ -0,0 +1,246 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // isRoomCell function that returns true if a free cell is a corner
+            // of a square of 2x2 free cells. The wall border makes bounds
+            // checks unnecessary.
+            bool isRoomCell(GridMap const& grid_map, const int& cell)
+            {
+                int row_stride = grid_map.getRowStride();
+                bool left = grid_map.isFreeCell(cell - 1);
+                bool right = grid_map.isFreeCell(cell + 1);
+                bool top = grid_map.isFreeCell(cell - row_stride);
+                bool bottom = grid_map.isFreeCell(cell + row_stride);
+
+                return (top && left && grid_map.isFreeCell(cell - row_stride - 1))
+                    || (top && right && grid_map.isFreeCell(cell - row_stride + 1))
+                    || (bottom && left && grid_map.isFreeCell(cell + row_stride - 1))
+                    || (bottom && right && grid_map.isFreeCell(cell + row_stride + 1));
+            }
+        }
+
+        RegionIndex::RegionIndex()
+        {
+        }
+
+        RegionIndex::RegionIndex(GridMap const& grid_map)
+        {
+            int row_stride = grid_map.getRowStride();
+            labels.assign(grid_map.getNumberCellIndices(), Constants::INDEX_NOT_FOUND, grid_map.isDiskBacked());
+
+            // the kind of every free cell is decided before the flood fill, so
+            // a fill only has to compare kinds
+            ScratchArray<uint8_t> room_cells;
+            room_cells.assign(grid_map.getNumberCellIndices(), 0, grid_map.isDiskBacked());
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                int cell = grid_map.getCellIndex(row_index, 0);
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++, cell++)
+                {
+                    room_cells[cell] = grid_map.isFreeCell(cell) && isRoomCell(grid_map, cell);
+                }
+            }
+
+            // every free cell without a label starts a new region, which is
+            // filled with all the connected cells of the same kind
+            vector<int> queue;
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                int cell = grid_map.getCellIndex(row_index, 0);
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++, cell++)
+                {
+                    if(!grid_map.isFreeCell(cell) || labels[cell] != Constants::INDEX_NOT_FOUND)
+                    {
+                        continue;
+                    }
+
+                    int region = regions.size();
+                    uint8_t is_room = room_cells[cell];
+                    Region region_info{is_room ? RegionKind::ROOM : RegionKind::CORRIDOR, row_index, col_index, row_index, col_index, 0};
+
+                    queue.assign(1, cell);
+                    labels[cell] = region;
+                    for(size_t queue_index = 0; queue_index < queue.size(); queue_index++)
+                    {
+                        int region_cell = queue[queue_index];
+                        int region_row_index = grid_map.getRowIndex(region_cell);
+                        int region_col_index = grid_map.getColIndex(region_cell);
+                        region_info.top_row_index = min(region_info.top_row_index, region_row_index);
+                        region_info.bottom_row_index = max(region_info.bottom_row_index, region_row_index);
+                        region_info.left_col_index = min(region_info.left_col_index, region_col_index);
+                        region_info.right_col_index = max(region_info.right_col_index, region_col_index);
+                        region_info.number_cells++;
+
+                        for(auto const& neighbor_cell : {region_cell - 1, region_cell + 1, region_cell - row_stride, region_cell + row_stride})
+                        {
+                            if(grid_map.isFreeCell(neighbor_cell) && labels[neighbor_cell] == Constants::INDEX_NOT_FOUND && room_cells[neighbor_cell] == is_room)
+                            {
+                                labels[neighbor_cell] = region;
+                                queue.push_back(neighbor_cell);
+                            }
+                        }
+                    }
+
+                    regions.push_back(region_info);
+                }
+            }
+
+            // a door is a pair of neighboring free cells of different regions,
+            // each pair is found once from its left or top cell
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                int cell = grid_map.getCellIndex(row_index, 0);
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++, cell++)
+                {
+                    if(labels[cell] == Constants::INDEX_NOT_FOUND)
+                    {
+                        continue;
+                    }
+
+                    for(auto const& neighbor_cell : {cell + 1, cell + row_stride})
+                    {
+                        if(labels[neighbor_cell] != Constants::INDEX_NOT_FOUND && labels[neighbor_cell] != labels[cell])
+                        {
+                            doors.push_back({labels[cell], labels[neighbor_cell], make_pair(row_index, col_index), make_pair(grid_map.getRowIndex(neighbor_cell), grid_map.getColIndex(neighbor_cell))});
+                        }
+                    }
+                }
+            }
+
+            // the doors of every region are kept next to each other, so the
+            // region graph is walked without per region allocations
+            door_offsets.assign(regions.size() + 1, 0);
+            for(auto const& door : doors)
+            {
+                door_offsets[door.region_a + 1]++;
+                door_offsets[door.region_b + 1]++;
+            }
+
+            for(size_t region = 0; region < regions.size(); region++)
+            {
+                door_offsets[region + 1] += door_offsets[region];
+            }
+
+            door_indices.resize(door_offsets.back());
+            vector<int> next_door_indices(door_offsets.begin(), door_offsets.end() - 1);
+            for(size_t door_index = 0; door_index < doors.size(); door_index++)
+            {
+                door_indices[next_door_indices[doors[door_index].region_a]++] = door_index;
+                door_indices[next_door_indices[doors[door_index].region_b]++] = door_index;
+            }
+        }
+
+        RegionIndex::~RegionIndex()
+        {
+        }
+
+        vector<Door> RegionIndex::getRegionDoors(const int& region) const
+        {
+            if(region < 0 || region >= getNumberRegions())
+            {
+                throw invalid_argument("Invalid region.");
+            }
+
+            // the doors are turned so that their first cell is in the region
+            vector<Door> region_doors;
+            for(int door_offset = door_offsets[region]; door_offset < door_offsets[region + 1]; door_offset++)
+            {
+                Door door = doors[door_indices[door_offset]];
+                if(door.region_a != region)
+                {
+                    swap(door.region_a, door.region_b);
+                    swap(door.cell_a, door.cell_b);
+                }
+                region_doors.push_back(door);
+            }
+
+            return region_doors;
+        }
+
+        bool RegionIndex::findRoute(const int& from_region, const int& to_region, vector<Door>& route) const
+        {
+            if(from_region < 0 || from_region >= getNumberRegions())
+            {
+                throw invalid_argument("Invalid start region.");
+            }
+            else if(to_region < 0 || to_region >= getNumberRegions())
+            {
+                throw invalid_argument("Invalid end region.");
+            }
+
+            // breadth first search over the regions, remembering the door every
+            // region was entered through
+            vector<int> entry_doors(regions.size(), Constants::INDEX_NOT_FOUND);
+            vector<bool> visited(regions.size(), false);
+            vector<int> queue(1, from_region);
+            visited[from_region] = true;
+
+            for(size_t queue_index = 0; queue_index < queue.size() && !visited[to_region]; queue_index++)
+            {
+                int region = queue[queue_index];
+                for(int door_offset = door_offsets[region]; door_offset < door_offsets[region + 1]; door_offset++)
+                {
+                    Door const& door = doors[door_indices[door_offset]];
+                    int next_region = door.region_a == region ? door.region_b : door.region_a;
+                    if(!visited[next_region])
+                    {
+                        visited[next_region] = true;
+                        entry_doors[next_region] = door_indices[door_offset];
+                        queue.push_back(next_region);
+                    }
+                }
+            }
+
+            if(!visited[to_region])
+            {
+                return false;
+            }
+
+            // the doors are collected from the end and turned so that their
+            // first cell is in the region that is left
+            size_t route_size = route.size();
+            for(int region = to_region; region != from_region;)
+            {
+                Door door = doors[entry_doors[region]];
+                if(door.region_b != region)
+                {
+                    swap(door.region_a, door.region_b);
+                    swap(door.cell_a, door.cell_b);
+                }
+                route.push_back(door);
+                region = door.region_a;
+            }
+            reverse(route.begin() + route_size, route.end());
+
+            return true;
+        }
+    }
+}
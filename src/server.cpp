@@ -0,0 +1,456 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+
+// system includes
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        namespace
+        {
+            // sendAll function that sends a whole buffer, returns false if the
+            // connection has been closed
+            bool sendAll(const int& connection_fd, string const& buffer)
+            {
+                size_t sent_size = 0;
+                while(sent_size < buffer.size())
+                {
+                    ssize_t result = send(connection_fd, buffer.data() + sent_size, buffer.size() - sent_size, MSG_NOSIGNAL);
+                    if(result < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    else if(result <= 0)
+                    {
+                        return false;
+                    }
+                    sent_size += result;
+                }
+
+                return true;
+            }
+        }
+
+        GridCache::GridCache(const int& capacity, const MapLoadMode& load_mode) : capacity(max(1, capacity)), load_mode(load_mode), number_hits(0), number_loads(0)
+        {
+        }
+
+        GridCache::~GridCache()
+        {
+        }
+
+        shared_ptr<const Grid> GridCache::getGrid(string const& map_file_path)
+        {
+            string map_file_key;
+            filesystem::file_time_type write_time;
+            try
+            {
+                map_file_key = filesystem::weakly_canonical(map_file_path).string();
+                write_time = filesystem::last_write_time(map_file_path);
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+                return nullptr;
+            }
+
+            promise<shared_ptr<const Grid>> grid_promise;
+            shared_future<shared_ptr<const Grid>> cached_grid;
+            int64_t load_id = 0;
+            {
+                lock_guard<mutex> lock(this->cache_mutex);
+                auto entry_index = this->entry_indices.find(map_file_key);
+                if(entry_index != this->entry_indices.end() && entry_index->second->write_time == write_time)
+                {
+                    this->entries.splice(this->entries.begin(), this->entries, entry_index->second);
+                    this->number_hits++;
+                    cached_grid = entry_index->second->grid;
+                }
+                else
+                {
+                    if(entry_index != this->entry_indices.end())
+                    {
+                        this->entries.erase(entry_index->second);
+                        this->entry_indices.erase(entry_index);
+                    }
+
+                    // evicted grids stay alive as long as a request still uses them
+                    load_id = ++this->number_loads;
+                    this->entries.push_front({map_file_key, write_time, load_id, grid_promise.get_future().share()});
+                    this->entry_indices[map_file_key] = this->entries.begin();
+                    while(static_cast<int>(this->entries.size()) > this->capacity)
+                    {
+                        this->entry_indices.erase(this->entries.back().map_file_key);
+                        this->entries.pop_back();
+                    }
+                }
+            }
+
+            // a cached grid may still be loading, it is waited for outside the lock
+            if(cached_grid.valid())
+            {
+                return cached_grid.get();
+            }
+
+            shared_ptr<const Grid> grid;
+            try
+            {
+                auto loaded_grid = make_shared<Grid>(map_file_path, this->load_mode);
+                if(loaded_grid->isInitialized())
+                {
+                    grid = loaded_grid;
+                }
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+            }
+            grid_promise.set_value(grid);
+
+            // a map that can not be loaded is not kept, so it is tried again
+            if(!grid)
+            {
+                lock_guard<mutex> lock(this->cache_mutex);
+                auto entry_index = this->entry_indices.find(map_file_key);
+                if(entry_index != this->entry_indices.end() && entry_index->second->load_id == load_id)
+                {
+                    this->entries.erase(entry_index->second);
+                    this->entry_indices.erase(entry_index);
+                }
+            }
+
+            return grid;
+        }
+
+        int GridCache::getNumberGrids() const
+        {
+            lock_guard<mutex> lock(this->cache_mutex);
+            return this->entries.size();
+        }
+
+        int64_t GridCache::getNumberHits() const
+        {
+            lock_guard<mutex> lock(this->cache_mutex);
+            return this->number_hits;
+        }
+
+        int64_t GridCache::getNumberLoads() const
+        {
+            lock_guard<mutex> lock(this->cache_mutex);
+            return this->number_loads;
+        }
+
+        SolverServer::SolverServer(ServerOptions const& options) : options(options), grid_cache(options.cache_capacity, options.load_mode), is_stopping(false), listen_fd(-1)
+        {
+            // a request is answered on the thread that serves its connection
+            this->options.solve_options.number_threads = 1;
+        }
+
+        SolverServer::~SolverServer()
+        {
+        }
+
+        void SolverServer::run()
+        {
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            if(this->options.socket_path.empty() || this->options.socket_path.size() >= sizeof(address.sun_path))
+            {
+                throw invalid_argument("Invalid socket path.");
+            }
+            strncpy(address.sun_path, this->options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+            int socket_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if(socket_fd < 0)
+            {
+                throw system_error(errno, generic_category(), "Could not create socket.");
+            }
+
+            // a socket file left by an earlier server is replaced
+            unlink(this->options.socket_path.c_str());
+            if(bind(socket_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(socket_fd, SOMAXCONN) < 0)
+            {
+                int socket_error = errno;
+                close(socket_fd);
+                throw system_error(socket_error, generic_category(), "Could not listen on socket.");
+            }
+
+            {
+                lock_guard<mutex> lock(this->connection_mutex);
+                this->listen_fd = socket_fd;
+                if(this->is_stopping)
+                {
+                    shutdown(socket_fd, SHUT_RDWR);
+                }
+            }
+
+            // every thread accepts and serves connections until the socket is
+            // shut down by stop
+            WorkStealingPool pool(this->options.number_threads);
+            pool.run(pool.getNumberThreads(), [&](const int&, const int&)
+            {
+                while(!this->is_stopping)
+                {
+                    int connection_fd = accept4(socket_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                    if(connection_fd < 0)
+                    {
+                        int accept_error = errno;
+                        if(this->is_stopping)
+                        {
+                            break;
+                        }
+                        else if(accept_error != EINTR && accept_error != ECONNABORTED)
+                        {
+                            // errors like running out of file descriptors are
+                            // retried after a pause instead of spinning
+                            cerr << "Could not accept connection : " << strerror(accept_error) << endl;
+                            this_thread::sleep_for(chrono::milliseconds(100));
+                        }
+                        continue;
+                    }
+
+                    {
+                        lock_guard<mutex> lock(this->connection_mutex);
+                        if(this->is_stopping)
+                        {
+                            close(connection_fd);
+                            break;
+                        }
+                        this->connection_fds.push_back(connection_fd);
+                    }
+
+                    serveConnection(connection_fd);
+
+                    {
+                        lock_guard<mutex> lock(this->connection_mutex);
+                        this->connection_fds.erase(find(this->connection_fds.begin(), this->connection_fds.end(), connection_fd));
+                        close(connection_fd);
+                    }
+                }
+            });
+
+            {
+                lock_guard<mutex> lock(this->connection_mutex);
+                this->listen_fd = -1;
+                close(socket_fd);
+            }
+            unlink(this->options.socket_path.c_str());
+        }
+
+        void SolverServer::stop()
+        {
+            lock_guard<mutex> lock(this->connection_mutex);
+            this->is_stopping = true;
+            if(this->listen_fd >= 0)
+            {
+                shutdown(this->listen_fd, SHUT_RDWR);
+            }
+
+            for(auto const& connection_fd : this->connection_fds)
+            {
+                shutdown(connection_fd, SHUT_RDWR);
+            }
+        }
+
+        void SolverServer::serveConnection(const int& connection_fd)
+        {
+            string request_buffer;
+            char receive_buffer[65536];
+            bool is_closed = false;
+            while(!is_closed)
+            {
+                ssize_t received_size = recv(connection_fd, receive_buffer, sizeof(receive_buffer), 0);
+                if(received_size < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if(received_size <= 0)
+                {
+                    // a last request without a line break is still answered
+                    is_closed = true;
+                    if(request_buffer.empty())
+                    {
+                        break;
+                    }
+                    request_buffer.push_back('\n');
+                }
+                else
+                {
+                    request_buffer.append(receive_buffer, received_size);
+                }
+
+                // the responses to all complete requests are sent at once
+                ostringstream response_stream;
+                size_t line_start = 0;
+                for(size_t line_end = request_buffer.find('\n'); line_end != string::npos; line_end = request_buffer.find('\n', line_start))
+                {
+                    string request = request_buffer.substr(line_start, line_end - line_start);
+                    line_start = line_end + 1;
+                    if(!request.empty() && request.back() == '\r')
+                    {
+                        request.pop_back();
+                    }
+
+                    if(request.find_first_not_of(" \t") != string::npos)
+                    {
+                        answerRequest(request, response_stream);
+                    }
+                }
+                request_buffer.erase(0, line_start);
+
+                if(!sendAll(connection_fd, response_stream.str()))
+                {
+                    break;
+                }
+            }
+        }
+
+        void SolverServer::answerRequest(string const& request, ostream& response_stream)
+        {
+            vector<string> fields;
+            istringstream request_stream(request);
+            for(string field; request_stream >> field;)
+            {
+                fields.push_back(field);
+            }
+
+            vector<int> numbers;
+            try
+            {
+                for(size_t field_index = 1; field_index < fields.size(); field_index++)
+                {
+                    size_t number_size = 0;
+                    numbers.push_back(stoi(fields[field_index], &number_size));
+                    if(number_size != fields[field_index].size())
+                    {
+                        throw invalid_argument("Invalid number.");
+                    }
+                }
+            }
+            catch(const exception&)
+            {
+                numbers.clear();
+            }
+
+            if(numbers.size() != 1 && numbers.size() != 4)
+            {
+                response_stream << "error Invalid request.\n";
+                return;
+            }
+            else if(numbers.size() == 1 && (numbers[0] < 1 || numbers[0] > 5))
+            {
+                response_stream << "error Invalid user story.\n";
+                return;
+            }
+
+            auto grid = this->grid_cache.getGrid(fields[0]);
+            if(!grid)
+            {
+                response_stream << "error Could not load map.\n";
+                return;
+            }
+
+            // paths of side steps are found and written as packed moves,
+            // paths with diagonal steps as cells
+            bool is_packed = this->options.solve_options.connectivity == Connectivity::FOUR;
+            PackedPath packed_path;
+            vector<pair<int, int>> path;
+            if(numbers.size() == 4)
+            {
+                if(is_packed)
+                {
+                    packed_path = grid->findPathPacked(make_pair(numbers[0], numbers[1]), make_pair(numbers[2], numbers[3]), this->options.solve_options);
+                }
+                else
+                {
+                    path = grid->findPath(make_pair(numbers[0], numbers[1]), make_pair(numbers[2], numbers[3]), this->options.solve_options);
+                }
+            }
+            else
+            {
+                switch(numbers[0])
+                {
+                    case 1:
+                        {
+                            if(int col_index = grid->searchARowForEmptySpace(0); col_index != Constants::INDEX_NOT_FOUND)
+                            {
+                                packed_path = PackedPath(0, col_index);
+                            }
+                            is_packed = true;
+                            break;
+                        }
+                    case 2:
+                        packed_path = grid->walkThroughHallwayPacked();
+                        is_packed = true;
+                        break;
+                    case 3:
+                        packed_path = grid->findPathToAndOutOfRoomPacked();
+                        is_packed = true;
+                        break;
+                    case 4:
+                        packed_path = grid->findWindingPathPacked();
+                        is_packed = true;
+                        break;
+                    default:
+                        if(is_packed)
+                        {
+                            packed_path = grid->solveMazePacked(this->options.solve_options);
+                        }
+                        else
+                        {
+                            path = grid->solveMaze(this->options.solve_options);
+                        }
+                        break;
+                }
+            }
+
+            try
+            {
+                if(is_packed)
+                {
+                    writePath(response_stream, packed_path, this->options.path_format);
+                }
+                else
+                {
+                    writePath(response_stream, path, this->options.path_format);
+                }
+            }
+            catch(const invalid_argument& e)
+            {
+                response_stream << "error " << e.what() << "\n";
+            }
+        }
+    }
+}
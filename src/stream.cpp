@@ -0,0 +1,342 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        MapRowStream::MapRowStream(istream& map_stream, const int& window_size) : map_stream(map_stream)
+        {
+            if(window_size < 2)
+            {
+                throw invalid_argument("Streaming window must hold at least two rows.");
+            }
+
+            this->window_size = window_size;
+            this->number_cols = 0;
+            this->number_rows_read = 0;
+            this->is_exhausted = false;
+        }
+
+        MapRowStream::~MapRowStream()
+        {
+        }
+
+        bool MapRowStream::readRow()
+        {
+            if(this->is_exhausted || !getline(this->map_stream, this->map_row))
+            {
+                this->is_exhausted = true;
+                return false;
+            }
+
+            int map_row_size = this->map_row.size();
+
+            // size of the first row is considered as the size of the rows
+            if(this->number_rows_read == 0)
+            {
+                this->number_cols = map_row_size;
+                this->window.assign(static_cast<size_t>(this->window_size) * this->number_cols, Constants::WALL_CELL);
+            }
+            else if(map_row_size != this->number_cols)
+            {
+                cerr << "Invalid map stream." << endl;
+                throw invalid_argument("Invalid map file.");
+            }
+
+            // the window is a ring buffer, the new row replaces the oldest one
+            uint8_t* row = this->window.data() + static_cast<size_t>(this->number_rows_read % this->window_size) * this->number_cols;
+            if(!convertAsciiRow(this->map_row.data(), row, this->number_cols))
+            {
+                cerr << "Invalid map stream." << endl;
+                throw invalid_argument("Invalid map file.");
+            }
+
+            this->number_rows_read++;
+            return true;
+        }
+
+        bool MapRowStream::ensureRow(const int& row_index)
+        {
+            while(row_index >= this->number_rows_read && readRow())
+            {
+            }
+
+            return row_index >= 0 && row_index < this->number_rows_read;
+        }
+
+        bool MapRowStream::isFree(const int& row_index, const int& col_index)
+        {
+            if(row_index < 0 || col_index < 0 || !ensureRow(row_index) || col_index >= this->number_cols)
+            {
+                return false;
+            }
+
+            return getRow(row_index)[col_index] == Constants::FREE_CELL;
+        }
+
+        const uint8_t* MapRowStream::getRow(const int& row_index) const
+        {
+            if(row_index < 0 || row_index >= this->number_rows_read)
+            {
+                throw out_of_range("Row has not been read.");
+            }
+            else if(row_index < this->number_rows_read - this->window_size)
+            {
+                throw out_of_range("Row has left the streaming window.");
+            }
+
+            return this->window.data() + static_cast<size_t>(row_index % this->window_size) * this->number_cols;
+        }
+
+        namespace
+        {
+            // findFirstFreeInStreamRow function that returns the first free
+            // column of a row in the window, or Constants::INDEX_NOT_FOUND
+            int findFirstFreeInStreamRow(MapRowStream const& map_stream, const int& row_index)
+            {
+                const uint8_t* row = map_stream.getRow(row_index);
+                const uint8_t* row_end = row + map_stream.getNumberCols();
+
+                if(auto row_itr = find(row, row_end, Constants::FREE_CELL); row_itr != row_end)
+                {
+                    return row_itr - row;
+                }
+
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            // followStreamBranch function that follows a one cell wide path from
+            // a neighbor of the start cell until it ends or returns to the start.
+            // Returns true if the path closed a loop back to the start cell.
+            bool followStreamBranch(MapRowStream& map_stream, pair<int, int> const& start_cell, pair<int, int> current_cell, vector<pair<int, int>>& path)
+            {
+                pair<int, int> previous_cell = start_cell;
+
+                while(true)
+                {
+                    path.push_back(current_cell);
+
+                    // neighbors in the order left, right, top and bottom
+                    pair<int, int> neighbors[4] = {
+                        make_pair(current_cell.first, current_cell.second - 1),
+                        make_pair(current_cell.first, current_cell.second + 1),
+                        make_pair(current_cell.first - 1, current_cell.second),
+                        make_pair(current_cell.first + 1, current_cell.second)
+                    };
+
+                    int number_neighbors = 0;
+                    pair<int, int> next_cell = previous_cell;
+                    bool has_next_cell = false;
+
+                    for(auto const& neighbor : neighbors)
+                    {
+                        if(map_stream.isFree(neighbor.first, neighbor.second))
+                        {
+                            number_neighbors++;
+                            if(neighbor != previous_cell)
+                            {
+                                next_cell = neighbor;
+                                has_next_cell = true;
+                            }
+                        }
+                    }
+
+                    if(number_neighbors > 2)
+                    {
+                        throw invalid_argument("Invalid map.");
+                    }
+                    else if(!has_next_cell)
+                    {
+                        return false;
+                    }
+                    else if(next_cell == start_cell)
+                    {
+                        return true;
+                    }
+
+                    previous_cell = current_cell;
+                    current_cell = next_cell;
+                }
+            }
+        }
+
+        int streamSearchARowForEmptySpace(MapRowStream& map_stream, const int& row_index)
+        {
+            if(!map_stream.ensureRow(row_index))
+            {
+                cerr << "Row index is out of bounds." << endl;
+                return Constants::INDEX_NOT_FOUND;
+            }
+            else if(map_stream.getNumberCols() == 0)
+            {
+                cerr << "Given row of the map is empty." << endl;
+                return Constants::INDEX_NOT_FOUND;
+            }
+
+            return findFirstFreeInStreamRow(map_stream, row_index);
+        }
+
+        vector<pair<int, int>> streamWalkThroughHallway(MapRowStream& map_stream)
+        {
+            vector<pair<int, int>> hallway_cells;
+
+            try
+            {
+                for(int row_index = 0; map_stream.ensureRow(row_index); row_index++)
+                {
+                    int col_index = findFirstFreeInStreamRow(map_stream, row_index);
+                    if(col_index == Constants::INDEX_NOT_FOUND)
+                    {
+                        continue;
+                    }
+
+                    hallway_cells.push_back(make_pair(row_index, col_index));
+
+                    if(map_stream.isFree(row_index + 1, col_index))
+                    {
+                        // column hallway found, rows are read while walking
+                        for(int row_ctr = row_index + 1; map_stream.isFree(row_ctr, col_index); row_ctr++)
+                        {
+                            hallway_cells.push_back(make_pair(row_ctr, col_index));
+                        }
+                    }
+                    else
+                    {
+                        // row hallway or just one cell
+                        for(int col_ctr = col_index + 1; map_stream.isFree(row_index, col_ctr); col_ctr++)
+                        {
+                            hallway_cells.push_back(make_pair(row_index, col_ctr));
+                        }
+                    }
+
+                    return hallway_cells;
+                }
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << '\n';
+                return {};
+            }
+
+            return hallway_cells;
+        }
+
+        vector<pair<int, int>> streamFindWindingPath(MapRowStream& map_stream)
+        {
+            vector<pair<int, int>> path;
+
+            try
+            {
+                // the grid searches row 0, column 0, row 1, column 1 and so on.
+                // The rows are read one at a time, keeping the first free row
+                // of every column and the first row with a free cell. Row 0 or
+                // column 0 decide the start at once, any other start is only
+                // known once the whole map has been read.
+                vector<int> first_free_rows;
+                pair<int, int> first_free_row_cell = make_pair(Constants::INDEX_NOT_FOUND, Constants::INDEX_NOT_FOUND);
+                for(int row_index = 0; map_stream.ensureRow(row_index); row_index++)
+                {
+                    if(row_index == 0)
+                    {
+                        first_free_rows.assign(map_stream.getNumberCols(), Constants::INDEX_NOT_FOUND);
+                    }
+
+                    const uint8_t* row = map_stream.getRow(row_index);
+                    for(int col_index = 0; col_index < map_stream.getNumberCols(); col_index++)
+                    {
+                        if(row[col_index] == Constants::FREE_CELL && first_free_rows[col_index] == Constants::INDEX_NOT_FOUND)
+                        {
+                            first_free_rows[col_index] = row_index;
+                        }
+                    }
+
+                    if(first_free_row_cell.first == Constants::INDEX_NOT_FOUND)
+                    {
+                        if(int col_index = findFirstFreeInStreamRow(map_stream, row_index); col_index != Constants::INDEX_NOT_FOUND)
+                        {
+                            first_free_row_cell = make_pair(row_index, col_index);
+                        }
+                    }
+
+                    if(first_free_row_cell.first == 0 || (!first_free_rows.empty() && first_free_rows[0] != Constants::INDEX_NOT_FOUND))
+                    {
+                        break;
+                    }
+                }
+
+                // row i comes before column j in the search if i <= j
+                int first_free_col_index = find_if(first_free_rows.begin(), first_free_rows.end(), [](const int& row_index) { return row_index != Constants::INDEX_NOT_FOUND; }) - first_free_rows.begin();
+                pair<int, int> start_cell = first_free_row_cell;
+                if(first_free_row_cell.first != Constants::INDEX_NOT_FOUND && first_free_col_index < first_free_row_cell.first)
+                {
+                    start_cell = make_pair(first_free_rows[first_free_col_index], first_free_col_index);
+                }
+
+                if(start_cell.first == Constants::INDEX_NOT_FOUND)
+                {
+                    cerr << "Could not find start cell." << endl;
+                    return {};
+                }
+                else if(start_cell.first < map_stream.getNumberRowsRead() - map_stream.getWindowSize())
+                {
+                    cerr << "The start cell has left the streaming window." << endl;
+                    return {};
+                }
+
+                // collect the neighbors of the start cell in the order left,
+                // right, top and bottom. The last one is followed first, like
+                // the depth first search does.
+                vector<pair<int, int>> start_neighbors;
+                for(auto const& neighbor : {make_pair(start_cell.first, start_cell.second - 1), make_pair(start_cell.first, start_cell.second + 1), make_pair(start_cell.first - 1, start_cell.second), make_pair(start_cell.first + 1, start_cell.second)})
+                {
+                    if(map_stream.isFree(neighbor.first, neighbor.second))
+                    {
+                        start_neighbors.push_back(neighbor);
+                    }
+                }
+
+                if(start_neighbors.size() > 2)
+                {
+                    throw invalid_argument("Invalid map.");
+                }
+
+                path.push_back(start_cell);
+                if(!start_neighbors.empty() && !followStreamBranch(map_stream, start_cell, start_neighbors.back(), path) && start_neighbors.size() == 2)
+                {
+                    followStreamBranch(map_stream, start_cell, start_neighbors.front(), path);
+                }
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << '\n';
+                return {};
+            }
+
+            return path;
+        }
+    }
+}
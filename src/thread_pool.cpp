@@ -0,0 +1,142 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <exception>
+#include <thread>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace grid
+    {
+        using namespace std;
+
+        WorkStealingPool::WorkStealingPool(const int& number_threads)
+        {
+            if(number_threads < 0)
+            {
+                throw invalid_argument("Invalid number of threads.");
+            }
+
+            this->number_threads = number_threads > 0 ? number_threads : max(1, static_cast<int>(thread::hardware_concurrency()));
+        }
+
+        WorkStealingPool::~WorkStealingPool()
+        {
+        }
+
+        bool WorkStealingPool::popTask(vector<unique_ptr<TaskQueue>>& task_queues, const int& thread_index, int& task_index) const
+        {
+            // own tasks are taken from the front, in the order of the input
+            {
+                TaskQueue& own_queue = *task_queues[thread_index];
+                lock_guard<mutex> queue_lock(own_queue.queue_mutex);
+                if(!own_queue.task_indices.empty())
+                {
+                    task_index = own_queue.task_indices.front();
+                    own_queue.task_indices.pop_front();
+                    return true;
+                }
+            }
+
+            // stolen tasks are taken from the back, away from their owner
+            for(int offset = 1; offset < this->number_threads; offset++)
+            {
+                TaskQueue& other_queue = *task_queues[(thread_index + offset) % this->number_threads];
+                lock_guard<mutex> queue_lock(other_queue.queue_mutex);
+                if(!other_queue.task_indices.empty())
+                {
+                    task_index = other_queue.task_indices.back();
+                    other_queue.task_indices.pop_back();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void WorkStealingPool::run(const int& number_tasks, function<void(const int&, const int&)> const& task)
+        {
+            if(number_tasks <= 0)
+            {
+                return;
+            }
+
+            // every thread starts with a contiguous share of the tasks. No
+            // task is added while running, so a thread that finds all queues
+            // empty is done.
+            int number_workers = min(this->number_threads, number_tasks);
+            vector<unique_ptr<TaskQueue>> task_queues;
+            for(int thread_index = 0; thread_index < this->number_threads; thread_index++)
+            {
+                task_queues.push_back(make_unique<TaskQueue>());
+                if(thread_index < number_workers)
+                {
+                    int first_task = static_cast<long long>(number_tasks) * thread_index / number_workers;
+                    int last_task = static_cast<long long>(number_tasks) * (thread_index + 1) / number_workers;
+                    for(int task_index = first_task; task_index < last_task; task_index++)
+                    {
+                        task_queues.back()->task_indices.push_back(task_index);
+                    }
+                }
+            }
+
+            mutex exception_mutex;
+            exception_ptr first_exception;
+
+            auto work = [&](const int& thread_index)
+            {
+                int task_index = 0;
+                while(popTask(task_queues, thread_index, task_index))
+                {
+                    try
+                    {
+                        task(task_index, thread_index);
+                    }
+                    catch(...)
+                    {
+                        lock_guard<mutex> exception_lock(exception_mutex);
+                        if(!first_exception)
+                        {
+                            first_exception = current_exception();
+                        }
+                    }
+                }
+            };
+
+            vector<thread> threads;
+            for(int thread_index = 1; thread_index < number_workers; thread_index++)
+            {
+                threads.emplace_back(work, thread_index);
+            }
+
+            work(0);
+            for(auto& worker_thread : threads)
+            {
+                worker_thread.join();
+            }
+
+            if(first_exception)
+            {
+                rethrow_exception(first_exception);
+            }
+        }
+    }
+}
@@ -18,6 +18,17 @@
 #include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <string>
+
+// system includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // project includes
 #include "maze.hpp"
@@ -28,68 +39,359 @@ namespace maze
     {
         using namespace std;
 
-        vector<vector<int>> readMap(filesystem::path const& map_file_path)
+        namespace
+        {
+            constexpr uint64_t CHARACTER_MASK = 0xFEFEFEFEFEFEFEFEULL;
+            constexpr uint64_t ZERO_CHARACTERS = 0x3030303030303030ULL;
+        }
+
+        MappedRegion::MappedRegion(filesystem::path const& file_path, const size_t& leading_bytes, const size_t& trailing_bytes)
+        {
+            int file_descriptor = open(file_path.c_str(), O_RDONLY);
+            if(file_descriptor < 0)
+            {
+                cerr << "Could not open file : " << file_path << endl;
+                throw filesystem::filesystem_error("Could not open file..", error_code(errno, generic_category()));
+            }
+
+            struct stat file_status;
+            if(fstat(file_descriptor, &file_status) != 0)
+            {
+                close(file_descriptor);
+                throw filesystem::filesystem_error("Could not read file size.", error_code(errno, generic_category()));
+            }
+
+            // the file is placed at a page boundary between the leading
+            // and trailing bytes of one anonymous, zeroed reservation
+            size_t page_size = sysconf(_SC_PAGESIZE);
+            size_t leading_size = (leading_bytes + page_size - 1) / page_size * page_size;
+            size_t file_size = (static_cast<size_t>(file_status.st_size) + page_size - 1) / page_size * page_size;
+            size_t trailing_size = (trailing_bytes + page_size - 1) / page_size * page_size;
+
+            this->size = file_status.st_size;
+            this->region_size = max(leading_size + file_size + trailing_size, page_size);
+            this->region = mmap(nullptr, this->region_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if(this->region == MAP_FAILED)
+            {
+                close(file_descriptor);
+                throw filesystem::filesystem_error("Could not map file.", error_code(errno, generic_category()));
+            }
+
+            this->data = static_cast<uint8_t*>(this->region) + leading_size;
+
+            if(this->size > 0 && mmap(this->data, this->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file_descriptor, 0) == MAP_FAILED)
+            {
+                int map_error = errno;
+                munmap(this->region, this->region_size);
+                close(file_descriptor);
+                throw filesystem::filesystem_error("Could not map file.", error_code(map_error, generic_category()));
+            }
+
+            close(file_descriptor);
+        }
+
+        MappedRegion::MappedRegion(const int& scratch_file_descriptor, const size_t& size)
+        {
+            this->size = size;
+            this->region_size = max<size_t>(size, 1);
+            this->region = mmap(nullptr, this->region_size, PROT_READ | PROT_WRITE, MAP_SHARED, scratch_file_descriptor, 0);
+
+            if(this->region == MAP_FAILED)
+            {
+                throw filesystem::filesystem_error("Could not map scratch file.", error_code(errno, generic_category()));
+            }
+
+            this->data = static_cast<uint8_t*>(this->region);
+        }
+
+        MappedRegion::~MappedRegion()
+        {
+            munmap(this->region, this->region_size);
+        }
+
+        int createScratchFile()
+        {
+            string scratch_file_path = (filesystem::temp_directory_path() / "maze_scratch_XXXXXX").string();
+            int file_descriptor = mkstemp(scratch_file_path.data());
+
+            if(file_descriptor < 0)
+            {
+                throw filesystem::filesystem_error("Could not create scratch file.", error_code(errno, generic_category()));
+            }
+
+            // the file disappears with its last descriptor or mapping
+            unlink(scratch_file_path.c_str());
+            return file_descriptor;
+        }
+
+        shared_ptr<MappedRegion> createScratchRegion(const size_t& size)
+        {
+            int file_descriptor = createScratchFile();
+
+            if(ftruncate(file_descriptor, max<size_t>(size, 1)) != 0)
+            {
+                int truncate_error = errno;
+                close(file_descriptor);
+                throw filesystem::filesystem_error("Could not resize scratch file.", error_code(truncate_error, generic_category()));
+            }
+
+            try
+            {
+                auto mapping = make_shared<MappedRegion>(file_descriptor, size);
+                close(file_descriptor);
+                return mapping;
+            }
+            catch(...)
+            {
+                close(file_descriptor);
+                throw;
+            }
+        }
+
+        bool isValidAsciiRow(const char* ascii_row, const int& number_cols)
         {
-            vector<vector<int>> grid_map;
+            // a byte is valid if it is '0' or '1' once the lowest bit is dropped,
+            // invalid bits of eight characters are collected per word
+            uint64_t invalid_bits = 0;
+            int col_index = 0;
+
+            for(; col_index + 8 <= number_cols; col_index += 8)
+            {
+                uint64_t word;
+                memcpy(&word, ascii_row + col_index, sizeof(word));
+                invalid_bits |= (word & CHARACTER_MASK) ^ ZERO_CHARACTERS;
+            }
 
+            for(; col_index < number_cols; col_index++)
+            {
+                invalid_bits |= (static_cast<uint8_t>(ascii_row[col_index]) & 0xFE) ^ '0';
+            }
+
+            return invalid_bits == 0;
+        }
+
+        bool convertAsciiRow(const char* ascii_row, uint8_t* row, const int& number_cols)
+        {
+            uint64_t invalid_bits = 0;
+            int col_index = 0;
+
+            for(; col_index + 8 <= number_cols; col_index += 8)
+            {
+                uint64_t word;
+                memcpy(&word, ascii_row + col_index, sizeof(word));
+                invalid_bits |= (word & CHARACTER_MASK) ^ ZERO_CHARACTERS;
+
+                // '0' and '1' become FREE_CELL and WALL_CELL without a borrow
+                word -= ZERO_CHARACTERS;
+                memcpy(row + col_index, &word, sizeof(word));
+            }
+
+            for(; col_index < number_cols; col_index++)
+            {
+                invalid_bits |= (static_cast<uint8_t>(ascii_row[col_index]) & 0xFE) ^ '0';
+                row[col_index] = ascii_row[col_index] - '0';
+            }
+
+            return invalid_bits == 0;
+        }
+
+        GridMap readMap(filesystem::path const& map_file_path, const MapLoadMode& load_mode)
+        {
             // check if the file exists
             if (!filesystem::is_regular_file(map_file_path))    
             {
                 cerr << "File does not exist : " << map_file_path << endl;
                 throw filesystem::filesystem_error("File does not exist.", error_code());
             }
-            else 
+
+            // binary maps carry their own bitmap and do not need parsing
+            if(isBinaryMap(map_file_path))
+            {
+                BinaryMapHeader header;
+                return readBinaryMap(map_file_path, header);
+            }
+
+            auto mapping = make_shared<MappedRegion>(map_file_path);
+            const char* map_text = reinterpret_cast<const char*>(mapping->getData());
+            size_t map_size = mapping->getSize();
+
+            if(map_size == 0)
+            {
+                return GridMap(0, 0);
+            }
+
+            // size of the first row is considered as the size of the rows,
+            // the last row may or may not end with a line break
+            const char* first_line_break = static_cast<const char*>(memchr(map_text, '\n', map_size));
+            size_t number_cols = first_line_break ? first_line_break - map_text : map_size;
+            size_t line_size = number_cols + 1;
+            size_t number_rows = 0;
+
+            if(map_size % line_size == 0)
             {
-                ifstream map_file_handler;
-                string map_row;
-                int first_row_size = -1;
-                int row_counter = -1;
+                number_rows = map_size / line_size;
+            }
+            else if((map_size + 1) % line_size == 0)
+            {
+                number_rows = (map_size + 1) / line_size;
+            }
+
+            if(number_rows == 0 || (number_rows + 2) * (number_cols + 2) > static_cast<size_t>(numeric_limits<int>::max()))
+            {
+                cerr << "Invalid map file : " << map_file_path << endl;
+                throw invalid_argument("Invalid map file.");
+            }
+
+            if(load_mode == MapLoadMode::ZERO_COPY)
+            {
+                // remap with room for the top and bottom border rows
+                mapping = make_shared<MappedRegion>(map_file_path, line_size + 1, line_size + 1);
+                map_text = reinterpret_cast<const char*>(mapping->getData());
+            }
 
-                map_file_handler.open(map_file_path);
+            GridMap grid_map = load_mode == MapLoadMode::ZERO_COPY
+                ? GridMap::fromMappedAscii(mapping, number_rows, number_cols)
+                : GridMap(number_rows, number_cols);
 
-                // check if the file is open
-                if(!map_file_handler.is_open())
+            // check if the map is valid, map is invalid if a row contains
+            // anything but '0' and '1' or if the line breaks are misplaced
+            for(size_t row_index = 0; row_index < number_rows; row_index++)
+            {
+                const char* map_row = map_text + row_index * line_size;
+                bool is_valid_row = row_index * line_size + number_cols == map_size || map_row[number_cols] == '\n';
+
+                if(is_valid_row && load_mode == MapLoadMode::ZERO_COPY)
                 {
-                    cerr << "Could not open file : " << map_file_path << endl;
-                    throw filesystem::filesystem_error("Could not open file..", error_code());
+                    is_valid_row = isValidAsciiRow(map_row, number_cols);
                 }
-            
-                // read lines from the file and add them to the grid map
-                while(getline(map_file_handler, map_row))
+                else if(is_valid_row)
+                {
+                    is_valid_row = convertAsciiRow(map_row, grid_map.getRow(row_index), number_cols);
+                }
+
+                if(!is_valid_row)
+                {
+                    cerr << "Invalid map file : " << map_file_path << endl;
+                    throw invalid_argument("Invalid map file.");
+                }
+            }
+
+            return grid_map;
+        }
+
+        void writeMap(filesystem::path const& map_file_path, GridMap const& grid_map)
+        {
+            ofstream map_file_handler(map_file_path, ios::trunc);
+            if(!map_file_handler.is_open())
+            {
+                cerr << "Could not open file : " << map_file_path << endl;
+                throw filesystem::filesystem_error("Could not open file.", error_code());
+            }
+
+            string map_row(grid_map.getNumberCols() + 1, '\n');
+            for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+            {
+                for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++)
+                {
+                    map_row[col_index] = grid_map.isFree(row_index, col_index) ? '0' : '1';
+                }
+                map_file_handler.write(map_row.data(), map_row.size());
+            }
+
+            if(!map_file_handler)
+            {
+                cerr << "Could not write file : " << map_file_path << endl;
+                throw filesystem::filesystem_error("Could not write file.", error_code());
+            }
+        }
+
+        GridMap readMapToDisk(istream& map_stream)
+        {
+            int file_descriptor = createScratchFile();
+            vector<uint8_t> write_buffer;
+            string map_row;
+            int first_row_size = -1;
+            int row_counter = 0;
+
+            // write_rows function that appends the buffered rows to the scratch file
+            auto write_rows = [&]()
+            {
+                size_t bytes_written = 0;
+                while(bytes_written < write_buffer.size())
+                {
+                    ssize_t result = write(file_descriptor, write_buffer.data() + bytes_written, write_buffer.size() - bytes_written);
+                    if(result < 0)
+                    {
+                        throw filesystem::filesystem_error("Could not write scratch file.", error_code(errno, generic_category()));
+                    }
+                    bytes_written += result;
+                }
+                write_buffer.clear();
+            };
+
+            try
+            {
+                // read lines from the stream and write them, with their wall
+                // border, in the layout of a grid map
+                while(getline(map_stream, map_row))
                 {
                     int map_row_size = map_row.size();
 
-                    // check if the map is valid
-                    // map is invalid if the size of the rows are not equal
-                    // size of the first row is considered as the size of the rows
                     if(first_row_size == -1)
                     {
                         first_row_size = map_row_size;
+
+                        // top border row
+                        write_buffer.assign(first_row_size + 2, Constants::WALL_CELL);
                     }
                     else if(first_row_size != map_row_size)
                     {
-                        cerr << "Invalid map file : " << map_file_path << endl;
+                        cerr << "Invalid map stream." << endl;
                         throw invalid_argument("Invalid map file.");
                     }
 
-                    grid_map.push_back(vector<int>(first_row_size));
-                    ++row_counter;
+                    size_t row_begin = write_buffer.size();
+                    write_buffer.resize(row_begin + first_row_size + 2, Constants::WALL_CELL);
+
+                    if(!convertAsciiRow(map_row.data(), write_buffer.data() + row_begin + 1, first_row_size))
+                    {
+                        cerr << "Invalid map stream." << endl;
+                        throw invalid_argument("Invalid map file.");
+                    }
 
-                    for(int i = 0; i < first_row_size; i++)
+                    if((static_cast<size_t>(++row_counter) + 2) * (first_row_size + 2) > static_cast<size_t>(numeric_limits<int>::max()))
                     {
-                        if(map_row[i] != '0' && map_row[i] != '1')
-                        {
-                            cerr << "Invalid map file : " << map_file_path << endl;
-                            throw invalid_argument("Invalid map file.");
-                        }
-                        grid_map[row_counter][i] = map_row[i] - '0';
+                        cerr << "Invalid map stream." << endl;
+                        throw invalid_argument("Map is too large.");
+                    }
+
+                    if(write_buffer.size() >= (1 << 20))
+                    {
+                        write_rows();
                     }
                 }
 
-                map_file_handler.close();
-            }
+                if(row_counter == 0)
+                {
+                    close(file_descriptor);
+                    return GridMap(0, 0);
+                }
 
-            return grid_map;
+                // bottom border row
+                write_buffer.resize(write_buffer.size() + first_row_size + 2, Constants::WALL_CELL);
+                write_rows();
+
+                auto mapping = make_shared<MappedRegion>(file_descriptor, (static_cast<size_t>(row_counter) + 2) * (first_row_size + 2));
+                close(file_descriptor);
+
+                return GridMap::fromMappedCells(mapping, row_counter, first_row_size);
+            }
+            catch(...)
+            {
+                close(file_descriptor);
+                throw;
+            }
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+#include <algorithm>
+
+// project includes
+#include "maze.hpp"
+
+namespace maze
+{
+    namespace graph
+    {
+        using namespace std;
+
+        uint8_t getCellMove(grid::GridMap const& grid_map, const int& cell, const int& next_cell)
+        {
+            int offset = next_cell - cell;
+            if(offset == -1 || offset == 1)
+            {
+                return offset < 0 ? grid::PackedPath::LEFT : grid::PackedPath::RIGHT;
+            }
+            else if(offset == -grid_map.getRowStride() || offset == grid_map.getRowStride())
+            {
+                return offset < 0 ? grid::PackedPath::UP : grid::PackedPath::DOWN;
+            }
+
+            throw invalid_argument("Only steps between side neighbors can be packed.");
+        }
+
+        SearchWorkspace::SearchWorkspace()
+        {
+            this->generation = 0;
+        }
+
+        SearchWorkspace::~SearchWorkspace()
+        {
+        }
+
+        size_t SearchWorkspace::prepare(const int& number_cells, const bool& use_disk)
+        {
+            if(number_cells < 0)
+            {
+                throw invalid_argument("Invalid number of cells.");
+            }
+
+            // a larger workspace serves smaller grid maps as well, the cells
+            // beyond the grid map are never reached
+            size_t number_bytes = 0;
+            if(static_cast<size_t>(number_cells) > this->visit_stamps.size() || use_disk != this->visit_stamps.isOnDisk())
+            {
+                this->visit_stamps.assign(number_cells, 0, use_disk);
+                this->g_scores.assign(number_cells, 0, use_disk);
+                this->parent_cells.assign(number_cells, -1, use_disk);
+                this->generation = 0;
+
+                // the open list resizes its position index to match below
+                number_bytes = static_cast<size_t>(number_cells) * (sizeof(uint32_t) + 3 * sizeof(int));
+            }
+
+            // the stamps of old queries could match again once the
+            // generation wraps around, so they are cleared then
+            if(++this->generation == 0)
+            {
+                fill(this->visit_stamps.data(), this->visit_stamps.data() + this->visit_stamps.size(), 0);
+                this->generation = 1;
+            }
+
+            this->open_list.reset(this->visit_stamps.size(), use_disk);
+            this->cell_stack.clear();
+
+            return number_bytes;
+        }
+
+        void SearchWorkspace::buildPath(grid::GridMap const& grid_map, const int& start_cell, const int& end_cell, vector<pair<int, int>>& path) const
+        {
+            for(int cell = end_cell; cell != start_cell; cell = this->parent_cells[cell])
+            {
+                path.push_back(make_pair(grid_map.getRowIndex(cell), grid_map.getColIndex(cell)));
+            }
+
+            path.push_back(make_pair(grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell)));
+            reverse(path.begin(), path.end());
+        }
+
+        void SearchWorkspace::buildPath(grid::GridMap const& grid_map, const int& start_cell, const int& end_cell, grid::PackedPath& path) const
+        {
+            // the parent chain is walked twice, once to count the moves and
+            // once to write them from the last one to the first
+            int64_t number_moves = 0;
+            for(int cell = end_cell; cell != start_cell; cell = this->parent_cells[cell])
+            {
+                number_moves++;
+            }
+
+            path = grid::PackedPath(make_pair(grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell)), make_pair(grid_map.getRowIndex(end_cell), grid_map.getColIndex(end_cell)), number_moves);
+            int64_t step_index = number_moves;
+            for(int cell = end_cell; cell != start_cell; cell = this->parent_cells[cell])
+            {
+                path.setMove(--step_index, getCellMove(grid_map, this->parent_cells[cell], cell));
+            }
+        }
+
+        SearchWorkspace& SearchWorkspace::getThreadWorkspace()
+        {
+            thread_local SearchWorkspace workspace;
+            return workspace;
+        }
+    }
+}
@@ -0,0 +1,780 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text.
+// If not, see <http://www.gnu.org/licenses/>.
+
+// stl includes
+#include <stdexcept>
+
+// external includes
+#include <gtest/gtest.h>
+
+// project includes
+#include "maze.hpp"
+#include "test_utils.hpp"
+
+using namespace std;
+
+// Test priority queue ordering by priority and tie breaker
+TEST(GraphTest, PriorityQueue1)
+{
+    maze::graph::IndexedPriorityQueue open_list(5);
+    open_list.push(0, 4, 0);
+    open_list.push(1, 2, 1);
+    open_list.push(2, 2, 0);
+    open_list.push(3, 7, 0);
+    ASSERT_EQ(open_list.size(), 4);
+    ASSERT_EQ(open_list.pop(), 2);
+    ASSERT_EQ(open_list.pop(), 1);
+    ASSERT_EQ(open_list.pop(), 0);
+    ASSERT_EQ(open_list.pop(), 3);
+    ASSERT_TRUE(open_list.empty());
+}
+
+// Test priority queue decrease key and membership
+TEST(GraphTest, PriorityQueue2)
+{
+    maze::graph::IndexedPriorityQueue open_list(4);
+    open_list.push(0, 5, 0);
+    open_list.push(1, 6, 0);
+    open_list.push(3, 9, 0);
+    ASSERT_TRUE(open_list.contains(3));
+    ASSERT_FALSE(open_list.contains(2));
+    open_list.decreaseKey(3, 1, 0);
+    ASSERT_EQ(open_list.top(), 3);
+    ASSERT_EQ(open_list.pop(), 3);
+    ASSERT_FALSE(open_list.contains(3));
+    ASSERT_THROW(open_list.decreaseKey(0, 8, 0), invalid_argument);
+    ASSERT_THROW(open_list.push(1, 1, 0), invalid_argument);
+    ASSERT_THROW(open_list.push(4, 1, 0), out_of_range);
+}
+
+// Test priority queue key updates in both directions and removal
+TEST(GraphTest, PriorityQueue3)
+{
+    maze::graph::IndexedPriorityQueue open_list(6);
+    for(int key = 0; key < 6; key++)
+    {
+        open_list.push(key, 10 + key, 0);
+    }
+    open_list.updateKey(0, 20, 0);
+    open_list.updateKey(5, 1, 0);
+    open_list.remove(2);
+    open_list.remove(5);
+    ASSERT_FALSE(open_list.contains(2));
+    ASSERT_EQ(open_list.top(), 1);
+    ASSERT_EQ(open_list.topPriority(), 11);
+    ASSERT_EQ(open_list.pop(), 1);
+    ASSERT_EQ(open_list.pop(), 3);
+    ASSERT_EQ(open_list.pop(), 4);
+    ASSERT_EQ(open_list.pop(), 0);
+    ASSERT_TRUE(open_list.empty());
+    ASSERT_THROW(open_list.remove(0), invalid_argument);
+}
+
+// Test that following a corridor matches the depth first search and reports
+// forks and cycles
+TEST(GraphTest, FollowCorridor1)
+{
+    for(int size : {5, 64, 301})
+    {
+        auto grid_map = maze::grid::generateMaze(maze::grid::MazeKind::WINDING, size, size + 3, size);
+        vector<pair<int, int>> dfs_path;
+        vector<pair<int, int>> corridor_path;
+        maze::graph::performSimpleDFS(grid_map, 1, 0, dfs_path);
+        ASSERT_EQ(maze::graph::followCorridor(grid_map, 1, 0, corridor_path), maze::graph::CorridorStatus::COMPLETE);
+        ASSERT_EQ(corridor_path, dfs_path);
+
+        // from the middle of the corridor both branches are followed
+        auto middle_cell = dfs_path[dfs_path.size() / 2];
+        dfs_path.clear();
+        corridor_path.clear();
+        maze::graph::performSimpleDFS(grid_map, middle_cell.first, middle_cell.second, dfs_path);
+        ASSERT_EQ(maze::graph::followCorridor(grid_map, middle_cell.first, middle_cell.second, corridor_path), maze::graph::CorridorStatus::COMPLETE);
+        ASSERT_EQ(corridor_path, dfs_path);
+    }
+
+    vector<vector<int>> ring_map = {{0, 0, 0, 0}, {0, 1, 1, 0}, {0, 1, 1, 0}, {0, 0, 0, 0}};
+    vector<pair<int, int>> dfs_path;
+    vector<pair<int, int>> corridor_path;
+    maze::graph::performSimpleDFS(ring_map, 0, 0, dfs_path);
+    ASSERT_EQ(maze::graph::followCorridor(ring_map, 0, 0, corridor_path), maze::graph::CorridorStatus::CYCLE);
+    ASSERT_EQ(corridor_path.size(), 12);
+    ASSERT_EQ(corridor_path, dfs_path);
+
+    // a fork leaves the path as it was
+    corridor_path = {make_pair(7, 7)};
+    ring_map[1][1] = 0;
+    ASSERT_EQ(maze::graph::followCorridor(ring_map, 0, 0, corridor_path), maze::graph::CorridorStatus::FORK);
+    ASSERT_EQ(corridor_path.size(), 1);
+    ASSERT_EQ(maze::graph::followCorridor(ring_map, 4, 0, corridor_path), maze::graph::CorridorStatus::INVALID_START);
+    ASSERT_EQ(corridor_path.size(), 1);
+}
+
+// Test A* on an open grid where the path must be the manhattan distance
+TEST(GraphTest, AStar1)
+{
+    vector<vector<int>> grid_map(50, vector<int>(40, 0));
+    vector<pair<int, int>> path;
+    maze::graph::performAStar(grid_map, 0, 0, 49, 39, path);
+    ASSERT_EQ(path.size(), 49 + 39 + 1);
+    ASSERT_EQ(path.front(), make_pair(0, 0));
+    ASSERT_EQ(path.back(), make_pair(49, 39));
+}
+
+// Test A* on a grid where the goal is walled off
+TEST(GraphTest, AStar2)
+{
+    vector<vector<int>> grid_map(5, vector<int>(5, 0));
+    grid_map[3] = vector<int>(5, 1);
+    vector<pair<int, int>> path;
+    maze::graph::performAStar(grid_map, 0, 0, 4, 4, path);
+    ASSERT_TRUE(path.empty());
+}
+
+// Test the search core with diagonal moves and without a heuristic
+TEST(GraphTest, GridSearch1)
+{
+    // getPathCost function that checks the steps of a path against the
+    // neighbor policy and returns the sum of their costs
+    auto getPathCost = [](maze::grid::GridMap const& grid_map, vector<pair<int, int>> const& path, const bool& cut_corners)
+    {
+        int path_cost = 0;
+        for(size_t path_index = 0; path_index < path.size(); path_index++)
+        {
+            EXPECT_TRUE(grid_map.isFree(path[path_index].first, path[path_index].second));
+            if(path_index == 0)
+            {
+                continue;
+            }
+
+            int row_step = path[path_index].first - path[path_index - 1].first;
+            int col_step = path[path_index].second - path[path_index - 1].second;
+            EXPECT_TRUE(abs(row_step) <= 1 && abs(col_step) <= 1 && (row_step != 0 || col_step != 0));
+            if(row_step != 0 && col_step != 0)
+            {
+                int number_free_sides = grid_map.isFree(path[path_index - 1].first + row_step, path[path_index - 1].second) + grid_map.isFree(path[path_index - 1].first, path[path_index - 1].second + col_step);
+                EXPECT_GE(number_free_sides, cut_corners ? 1 : 2);
+                path_cost += 7;
+            }
+            else
+            {
+                path_cost += 5;
+            }
+        }
+        return path_cost;
+    };
+
+    for(auto maze_kind : {maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 61, 47, 2);
+
+        for(auto const& query : samplePathQueries(grid_map, 10))
+        {
+            auto start_cell = query.start_cell;
+            auto end_cell = query.end_cell;
+
+            // Dijkstra finds paths as short as A*, expanding at least as many cells
+            vector<pair<int, int>> astar_path;
+            vector<pair<int, int>> dijkstra_path;
+            maze::graph::SearchStats astar_stats;
+            maze::graph::SearchStats dijkstra_stats;
+            maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path, &astar_stats);
+            maze::graph::performGridSearch(grid_map, maze::graph::FourConnected(), maze::graph::ZeroHeuristic(), start_cell.first, start_cell.second, end_cell.first, end_cell.second, dijkstra_path, &dijkstra_stats);
+            ASSERT_EQ(dijkstra_path.size(), astar_path.size());
+            ASSERT_GE(dijkstra_stats.nodes_expanded, astar_stats.nodes_expanded);
+
+            // the octile heuristic keeps the diagonal paths optimal
+            for(bool cut_corners : {false, true})
+            {
+                vector<pair<int, int>> octile_path;
+                vector<pair<int, int>> zero_path;
+                if(cut_corners)
+                {
+                    maze::graph::performGridSearch(grid_map, maze::graph::EightConnected<true>(), maze::graph::OctileHeuristic<maze::graph::EightConnected<true>>(), start_cell.first, start_cell.second, end_cell.first, end_cell.second, octile_path);
+                    maze::graph::performGridSearch(grid_map, maze::graph::EightConnected<true>(), maze::graph::ZeroHeuristic(), start_cell.first, start_cell.second, end_cell.first, end_cell.second, zero_path);
+                }
+                else
+                {
+                    maze::graph::performGridSearch(grid_map, maze::graph::EightConnected<false>(), maze::graph::OctileHeuristic<maze::graph::EightConnected<false>>(), start_cell.first, start_cell.second, end_cell.first, end_cell.second, octile_path);
+                    maze::graph::performGridSearch(grid_map, maze::graph::EightConnected<false>(), maze::graph::ZeroHeuristic(), start_cell.first, start_cell.second, end_cell.first, end_cell.second, zero_path);
+                }
+
+                // diagonal steps keep the connected components of the grid
+                ASSERT_EQ(octile_path.empty(), astar_path.empty());
+                ASSERT_EQ(getPathCost(grid_map, octile_path, cut_corners), getPathCost(grid_map, zero_path, cut_corners));
+                if(!octile_path.empty())
+                {
+                    ASSERT_LE(getPathCost(grid_map, octile_path, cut_corners), 5 * static_cast<int>(astar_path.size() - 1));
+                    ASSERT_EQ(octile_path.front(), start_cell);
+                    ASSERT_EQ(octile_path.back(), end_cell);
+                }
+            }
+        }
+    }
+}
+
+// Test that jump point search finds paths as short as A* between random cells
+TEST(GraphTest, JumpPointSearch1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        for(uint64_t seed = 0; seed < 4; seed++)
+        {
+            auto grid_map = maze::grid::generateMaze(maze_kind, 24 + seed, 31, seed);
+
+            for(auto const& query : samplePathQueries(grid_map, 40))
+            {
+                auto start_cell = query.start_cell;
+                auto end_cell = query.end_cell;
+
+                vector<pair<int, int>> astar_path;
+                vector<pair<int, int>> jps_path;
+                maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path);
+                maze::graph::performJumpPointSearch(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, jps_path);
+
+                ASSERT_EQ(jps_path.size(), astar_path.size());
+                ASSERT_TRUE(isValidPath(grid_map, jps_path));
+                if(!jps_path.empty())
+                {
+                    ASSERT_EQ(jps_path.front(), start_cell);
+                    ASSERT_EQ(jps_path.back(), end_cell);
+                }
+            }
+        }
+    }
+}
+
+// Test that jump point search expands fewer nodes than A* in an open room
+TEST(GraphTest, JumpPointSearch2)
+{
+    auto grid_map = maze::grid::generateMaze(maze::grid::MazeKind::OBSTACLES, 64, 64, 3);
+    vector<pair<int, int>> astar_path;
+    vector<pair<int, int>> jps_path;
+    maze::graph::SearchStats astar_stats;
+    maze::graph::SearchStats jps_stats;
+    maze::graph::performAStar(grid_map, 1, 1, 62, 62, astar_path, &astar_stats);
+    maze::graph::performJumpPointSearch(grid_map, 1, 1, 62, 62, jps_path, &jps_stats);
+    ASSERT_EQ(jps_path.size(), astar_path.size());
+    ASSERT_LT(jps_stats.nodes_expanded, astar_stats.nodes_expanded);
+
+    vector<vector<int>> open_grid_map(200, vector<int>(200, 0));
+    open_grid_map[100] = vector<int>(200, 1);
+    open_grid_map[100][150] = 0;
+    astar_path.clear();
+    jps_path.clear();
+    astar_stats = {};
+    jps_stats = {};
+    maze::graph::performAStar(open_grid_map, 0, 0, 199, 0, astar_path, &astar_stats);
+    maze::graph::performJumpPointSearch(open_grid_map, 0, 0, 199, 0, jps_path, &jps_stats);
+    ASSERT_EQ(jps_path.size(), astar_path.size());
+    ASSERT_LT(jps_stats.nodes_expanded * 10, astar_stats.nodes_expanded);
+}
+
+// Test that every engine fills the counters of its search
+TEST(GraphTest, SearchStats1)
+{
+    auto grid_map = maze::grid::generateMaze(maze::grid::MazeKind::ROOM, 96, 96, 5);
+    auto free_cells = getFreeCells(grid_map);
+
+    auto start_cell = free_cells.front();
+    auto end_cell = free_cells.back();
+    auto checkStats = [](maze::graph::SearchStats const& stats)
+    {
+        ASSERT_GT(stats.nodes_expanded, 0);
+        ASSERT_GE(stats.nodes_pushed, stats.nodes_expanded);
+        ASSERT_GT(stats.peak_frontier_size, 0);
+        ASSERT_LE(stats.peak_frontier_size, stats.nodes_pushed);
+    };
+
+    vector<pair<int, int>> path;
+    maze::graph::SearchStats stats;
+    maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &stats);
+    ASSERT_FALSE(path.empty());
+    checkStats(stats);
+    ASSERT_GT(stats.decrease_keys + stats.nodes_pushed, stats.nodes_expanded);
+
+    // the second search reuses the workspace of the first
+    maze::graph::SearchStats reused_stats;
+    path.clear();
+    maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &reused_stats);
+    ASSERT_EQ(reused_stats.bytes_allocated, 0);
+    ASSERT_EQ(reused_stats.nodes_expanded, stats.nodes_expanded);
+
+    stats = {};
+    path.clear();
+    maze::graph::performJumpPointSearch(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &stats);
+    checkStats(stats);
+
+    stats = {};
+    path.clear();
+    maze::graph::performBidirectionalBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &stats);
+    checkStats(stats);
+    ASSERT_GT(stats.bytes_allocated, 0);
+
+    stats = {};
+    path.clear();
+    maze::graph::performBidirectionalAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &stats);
+    checkStats(stats);
+
+    stats = {};
+    path.clear();
+    maze::graph::HierarchicalMap hierarchical_map(grid_map);
+    hierarchical_map.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, &stats);
+    checkStats(stats);
+
+    stats = {};
+    path.clear();
+    maze::graph::DStarLite planner(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second);
+    planner.findPath(path, &stats);
+    ASSERT_FALSE(path.empty());
+
+    // the goal is queued by the constructor and a cell can be expanded twice
+    ASSERT_GT(stats.nodes_expanded, 0);
+    ASSERT_GT(stats.peak_frontier_size, 0);
+}
+
+// Test that both bidirectional searches find paths as short as A* between random cells
+TEST(GraphTest, BidirectionalSearch1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        for(uint64_t seed = 0; seed < 4; seed++)
+        {
+            auto grid_map = maze::grid::generateMaze(maze_kind, 24 + seed, 31, seed);
+
+            for(auto const& query : samplePathQueries(grid_map, 40))
+            {
+                auto start_cell = query.start_cell;
+                auto end_cell = query.end_cell;
+
+                vector<pair<int, int>> astar_path;
+                maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path);
+
+                vector<pair<int, int>> bidirectional_paths[3];
+                maze::graph::performBidirectionalBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, bidirectional_paths[0]);
+                maze::graph::performBidirectionalBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, bidirectional_paths[1], nullptr, true);
+                maze::graph::performBidirectionalAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, bidirectional_paths[2]);
+
+                for(auto const& bidirectional_path : bidirectional_paths)
+                {
+                    ASSERT_EQ(bidirectional_path.size(), astar_path.size());
+                    ASSERT_TRUE(isValidPath(grid_map, bidirectional_path));
+                    if(!bidirectional_path.empty())
+                    {
+                        ASSERT_EQ(bidirectional_path.front(), start_cell);
+                        ASSERT_EQ(bidirectional_path.back(), end_cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Test that both bidirectional searches return an empty path if the end cell can not be reached
+TEST(GraphTest, BidirectionalSearch2)
+{
+    vector<vector<int>> grid_map(20, vector<int>(20, 0));
+    grid_map[10] = vector<int>(20, 1);
+
+    vector<pair<int, int>> path;
+    maze::graph::performBidirectionalBFS(grid_map, 0, 0, 19, 19, path);
+    ASSERT_TRUE(path.empty());
+    maze::graph::performBidirectionalBFS(grid_map, 0, 0, 19, 19, path, nullptr, true);
+    ASSERT_TRUE(path.empty());
+    maze::graph::performBidirectionalAStar(grid_map, 0, 0, 19, 19, path);
+    ASSERT_TRUE(path.empty());
+
+    maze::graph::performBidirectionalAStar(grid_map, 3, 4, 3, 4, path);
+    ASSERT_EQ(path.size(), 1);
+    ASSERT_THROW(maze::graph::performBidirectionalBFS(grid_map, 0, 0, 20, 0, path), invalid_argument);
+}
+
+// Test that a search workspace forgets the cells of earlier queries and serves grid maps of any size
+TEST(GraphTest, SearchWorkspace1)
+{
+    maze::graph::SearchWorkspace workspace;
+    workspace.prepare(16);
+    workspace.reach(5, 3, 4);
+    ASSERT_TRUE(workspace.isReached(5));
+    ASSERT_EQ(workspace.getGScore(5), 3);
+    ASSERT_EQ(workspace.getParentCell(5), 4);
+    ASSERT_FALSE(workspace.isReached(6));
+
+    workspace.prepare(8);
+    ASSERT_FALSE(workspace.isReached(5));
+    workspace.prepare(32);
+    ASSERT_FALSE(workspace.isReached(5));
+    ASSERT_FALSE(workspace.isReached(31));
+
+    // the workspace of the thread is reused by every search below
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL})
+    {
+        for(int size : {48, 12, 31})
+        {
+            // perfect mazes connect the first and the last free cell
+            auto grid_map = maze::grid::generateMaze(maze_kind, size, size, size);
+            int start_cell = grid_map.getCellIndex(0, 0);
+            int end_cell = grid_map.getCellIndex(size - 1, size - 1);
+            while(!grid_map.isFreeCell(start_cell))
+            {
+                start_cell++;
+            }
+            while(!grid_map.isFreeCell(end_cell))
+            {
+                end_cell--;
+            }
+
+            vector<pair<int, int>> astar_path;
+            vector<pair<int, int>> bfs_path;
+            maze::graph::performAStar(grid_map, grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell), grid_map.getRowIndex(end_cell), grid_map.getColIndex(end_cell), astar_path);
+            maze::graph::performBidirectionalBFS(grid_map, grid_map.getRowIndex(start_cell), grid_map.getColIndex(start_cell), grid_map.getRowIndex(end_cell), grid_map.getColIndex(end_cell), bfs_path);
+            ASSERT_EQ(astar_path.size(), bfs_path.size());
+            ASSERT_FALSE(astar_path.empty());
+            ASSERT_TRUE(isValidPath(grid_map, astar_path));
+        }
+    }
+}
+
+// Test that the hierarchical map finds valid paths that are shortest in perfect mazes
+TEST(GraphTest, HierarchicalMap1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        for(int sector_size : {2, 5, 16})
+        {
+            auto grid_map = maze::grid::generateMaze(maze_kind, 41, 37, sector_size);
+            maze::graph::HierarchicalMap hierarchical_map(grid_map, sector_size);
+
+            for(auto const& query : samplePathQueries(grid_map, 40))
+            {
+                auto start_cell = query.start_cell;
+                auto end_cell = query.end_cell;
+
+                vector<pair<int, int>> astar_path;
+                vector<pair<int, int>> hierarchical_path;
+                maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path);
+                hierarchical_map.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, hierarchical_path);
+
+                ASSERT_EQ(hierarchical_path.empty(), astar_path.empty());
+                ASSERT_GE(hierarchical_path.size(), astar_path.size());
+                ASSERT_TRUE(isValidPath(grid_map, hierarchical_path));
+                if(maze_kind == maze::grid::MazeKind::BACKTRACKER || maze_kind == maze::grid::MazeKind::KRUSKAL)
+                {
+                    ASSERT_EQ(hierarchical_path.size(), astar_path.size());
+                }
+
+                if(!hierarchical_path.empty())
+                {
+                    ASSERT_EQ(hierarchical_path.front(), start_cell);
+                    ASSERT_EQ(hierarchical_path.back(), end_cell);
+                }
+            }
+        }
+    }
+}
+
+// Test that the corridor graph finds paths as short as A*, from and to
+// junctions, dead ends and cells inside corridors
+TEST(GraphTest, CorridorGraph1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 41, 37, 5);
+        maze::grid::NeighborMask neighbor_mask(grid_map);
+        maze::graph::CorridorGraph corridor_graph(grid_map, neighbor_mask);
+
+        maze::graph::SearchStats astar_stats;
+        maze::graph::SearchStats corridor_stats;
+        for(auto const& query : samplePathQueries(grid_map, 40))
+        {
+            auto start_cell = query.start_cell;
+            auto end_cell = query.end_cell;
+
+            vector<pair<int, int>> astar_path;
+            vector<pair<int, int>> corridor_path;
+            maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path, &astar_stats);
+            corridor_graph.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, corridor_path, &corridor_stats);
+
+            ASSERT_EQ(corridor_path.size(), astar_path.size());
+            ASSERT_TRUE(isValidPath(grid_map, corridor_path));
+            if(!corridor_path.empty())
+            {
+                ASSERT_EQ(corridor_path.front(), start_cell);
+                ASSERT_EQ(corridor_path.back(), end_cell);
+            }
+        }
+
+        // corridors are crossed in one step instead of one per cell
+        if(maze_kind == maze::grid::MazeKind::BACKTRACKER || maze_kind == maze::grid::MazeKind::WINDING)
+        {
+            ASSERT_LT(corridor_stats.nodes_expanded * 2, astar_stats.nodes_expanded);
+        }
+    }
+
+    // a loop without junctions has no nodes, both cells are on its corridor
+    maze::grid::GridMap grid_map({{0, 0, 0, 0}, {0, 1, 1, 0}, {0, 1, 1, 0}, {0, 0, 0, 0}});
+    maze::grid::NeighborMask neighbor_mask(grid_map);
+    maze::graph::CorridorGraph corridor_graph(grid_map, neighbor_mask);
+    ASSERT_EQ(corridor_graph.getNumberNodes(), 0);
+
+    vector<pair<int, int>> path;
+    corridor_graph.findPath(0, 0, 2, 3, path);
+    ASSERT_EQ(path.size(), 6);
+    ASSERT_TRUE(isValidPath(grid_map, path));
+    ASSERT_THROW(corridor_graph.findPath(0, 0, 4, 2, path), invalid_argument);
+}
+
+// Test that distance fields hold the A* path lengths to the goal, on narrow
+// maps whose levels are dense and on a large open map split over threads
+TEST(GraphTest, DistanceField1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        for(int number_cols : {5, 37, 130})
+        {
+            auto grid_map = maze::grid::generateMaze(maze_kind, 61, number_cols, number_cols);
+            auto free_cells = getFreeCells(grid_map);
+
+            auto goal_cell = free_cells[free_cells.size() / 2];
+            maze::graph::DistanceField distance_field(grid_map, goal_cell.first, goal_cell.second, 2);
+            ASSERT_EQ(distance_field.getDistance(goal_cell.first, goal_cell.second), 0u);
+
+            for(auto const& query : samplePathQueries(grid_map, 40))
+            {
+                auto start_cell = query.start_cell;
+                vector<pair<int, int>> astar_path;
+                vector<pair<int, int>> field_path;
+                maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, goal_cell.first, goal_cell.second, astar_path);
+                distance_field.getPath(start_cell.first, start_cell.second, field_path);
+
+                ASSERT_EQ(field_path.size(), astar_path.size());
+                ASSERT_TRUE(isValidPath(grid_map, field_path));
+                if(astar_path.empty())
+                {
+                    ASSERT_EQ(distance_field.getDistance(start_cell.first, start_cell.second), maze::graph::DistanceField::UNREACHABLE);
+                }
+                else
+                {
+                    ASSERT_EQ(distance_field.getDistance(start_cell.first, start_cell.second), astar_path.size() - 1);
+                    ASSERT_EQ(field_path.back(), goal_cell);
+                }
+            }
+        }
+    }
+
+    vector<vector<int>> open_map(2100, vector<int>(2100, 0));
+    open_map[1050][1049] = 1;
+    open_map[1049][1050] = 1;
+    maze::grid::GridMap grid_map(open_map);
+    maze::graph::DistanceField one_thread_field(grid_map, 1050, 1050, 1);
+    maze::graph::DistanceField four_thread_field(grid_map, 1050, 1050, 4);
+    ASSERT_EQ(one_thread_field.toRowMajor(), four_thread_field.toRowMajor());
+    ASSERT_EQ(four_thread_field.getDistance(1050, 1049), maze::graph::DistanceField::UNREACHABLE);
+    ASSERT_EQ(four_thread_field.getDistance(1049, 1049), 6u);
+    ASSERT_EQ(four_thread_field.getDistance(0, 0), 2102u);
+    ASSERT_EQ(four_thread_field.getNumberLevels(), 2102);
+}
+
+// Test that the parallel breadth first search finds paths as short as A*
+// on one and on several threads, and stops at the start cell
+TEST(GraphTest, ParallelBFS1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 53, 47, 7);
+
+        for(auto const& query : samplePathQueries(grid_map, 20))
+        {
+            auto start_cell = query.start_cell;
+            auto end_cell = query.end_cell;
+
+            vector<pair<int, int>> astar_path;
+            maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, astar_path);
+            for(int number_threads : {1, 4})
+            {
+                vector<pair<int, int>> parallel_path;
+                maze::graph::performParallelBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, parallel_path, nullptr, number_threads);
+                ASSERT_EQ(parallel_path.size(), astar_path.size());
+                ASSERT_TRUE(isValidPath(grid_map, parallel_path));
+                if(!parallel_path.empty())
+                {
+                    ASSERT_EQ(parallel_path.front(), start_cell);
+                    ASSERT_EQ(parallel_path.back(), end_cell);
+                }
+            }
+        }
+    }
+
+    // the levels are wide enough to be split over the threads, and the
+    // search stops long before the far corner
+    maze::grid::GridMap grid_map(vector<vector<int>>(2100, vector<int>(2100, 0)));
+    vector<pair<int, int>> path;
+    maze::graph::SearchStats stats;
+    maze::graph::performParallelBFS(grid_map, 1000, 1000, 1050, 1050, path, &stats, 4);
+    ASSERT_EQ(path.size(), 101);
+    ASSERT_TRUE(isValidPath(grid_map, path));
+    ASSERT_LT(stats.nodes_expanded, 2100 * 2100 / 4);
+
+    maze::graph::DistanceField distance_field(grid_map, 1050, 1050, 4, 1000, 1000);
+    ASSERT_EQ(distance_field.getDistance(1000, 1000), 100u);
+    ASSERT_EQ(distance_field.getDistance(0, 0), maze::graph::DistanceField::UNREACHABLE);
+    ASSERT_EQ(distance_field.getNumberLevels(), 100);
+}
+
+// Test that the engines write the same paths packed as in cells
+TEST(GraphTest, PackedPath1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 61, 47, 3);
+        maze::grid::NeighborMask neighbor_mask(grid_map);
+        maze::graph::HierarchicalMap hierarchical_map(grid_map, 8);
+        maze::graph::CorridorGraph corridor_graph(grid_map, neighbor_mask);
+
+        auto queries = samplePathQueries(grid_map, 20);
+        queries.push_back({queries[0].start_cell, queries[0].start_cell});
+        for(auto const& query : queries)
+        {
+            auto start_cell = query.start_cell;
+            auto end_cell = query.end_cell;
+
+            // checkPacked function that compares the packed path of a search
+            // with its path of cells
+            auto checkPacked = [](vector<pair<int, int>> const& path, maze::grid::PackedPath const& packed_path)
+            {
+                ASSERT_EQ(packed_path.getNumberCells(), static_cast<int64_t>(path.size()));
+                ASSERT_EQ(packed_path.unpack(), path);
+            };
+
+            for(bool use_two_threads : {false, true})
+            {
+                vector<pair<int, int>> path;
+                maze::grid::PackedPath packed_path;
+                maze::graph::performBidirectionalBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path, nullptr, use_two_threads);
+                maze::graph::performBidirectionalBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, packed_path, nullptr, use_two_threads);
+                checkPacked(path, packed_path);
+            }
+
+            vector<pair<int, int>> bidirectional_astar_path;
+            maze::grid::PackedPath packed_bidirectional_astar_path;
+            maze::graph::performBidirectionalAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, bidirectional_astar_path);
+            maze::graph::performBidirectionalAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, packed_bidirectional_astar_path);
+            checkPacked(bidirectional_astar_path, packed_bidirectional_astar_path);
+
+            vector<pair<int, int>> hierarchical_path;
+            maze::grid::PackedPath packed_hierarchical_path;
+            hierarchical_map.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, hierarchical_path);
+            hierarchical_map.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, packed_hierarchical_path);
+            checkPacked(hierarchical_path, packed_hierarchical_path);
+
+            vector<pair<int, int>> corridor_path;
+            maze::grid::PackedPath packed_corridor_path;
+            corridor_graph.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, corridor_path);
+            corridor_graph.findPath(start_cell.first, start_cell.second, end_cell.first, end_cell.second, packed_corridor_path);
+            checkPacked(corridor_path, packed_corridor_path);
+
+            vector<pair<int, int>> parallel_path;
+            maze::grid::PackedPath packed_parallel_path;
+            maze::graph::performParallelBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, parallel_path, nullptr, 2);
+            maze::graph::performParallelBFS(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, packed_parallel_path, nullptr, 2);
+            checkPacked(parallel_path, packed_parallel_path);
+        }
+    }
+}
+
+// Test that D* Lite repairs paths as short as a new A* search while cells
+// toggle and the start moves along the path
+TEST(GraphTest, DStarLite1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 45, 52, 11);
+        auto free_cells = getFreeCells(grid_map);
+
+        auto start_cell = free_cells.front();
+        auto goal_cell = free_cells.back();
+        maze::graph::DStarLite planner(grid_map, start_cell.first, start_cell.second, goal_cell.first, goal_cell.second);
+        maze::graph::SearchStats first_stats;
+        vector<pair<int, int>> path;
+        planner.findPath(path, &first_stats);
+
+        for(int step = 0; step < 60; step++)
+        {
+            // step along the last path, then toggle a few cells, never the
+            // goal or the new start
+            if(path.size() > 2)
+            {
+                start_cell = path[1];
+                planner.moveStart(start_cell.first, start_cell.second);
+            }
+
+            vector<maze::grid::CellUpdate> cell_updates;
+            for(int update_index = 0; update_index < 3; update_index++)
+            {
+                int row_index = (step * 7919 + update_index * 104729) % grid_map.getNumberRows();
+                int col_index = (step * 6151 + update_index * 3571) % grid_map.getNumberCols();
+                if(make_pair(row_index, col_index) != goal_cell && make_pair(row_index, col_index) != start_cell)
+                {
+                    cell_updates.push_back({row_index, col_index, grid_map.isFree(row_index, col_index)});
+                    grid_map.setCell(row_index, col_index, cell_updates.back().is_wall ? maze::grid::Constants::WALL_CELL : maze::grid::Constants::FREE_CELL);
+                }
+            }
+            planner.updateCells(cell_updates);
+
+            vector<pair<int, int>> astar_path;
+            maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, goal_cell.first, goal_cell.second, astar_path);
+            path.clear();
+            maze::graph::SearchStats stats;
+            planner.findPath(path, &stats);
+
+            ASSERT_EQ(path.size(), astar_path.size());
+            ASSERT_TRUE(isValidPath(grid_map, path));
+            if(!path.empty())
+            {
+                ASSERT_EQ(path.front(), start_cell);
+                ASSERT_EQ(path.back(), goal_cell);
+            }
+        }
+    }
+
+    // closing one cell of a long corridor only repairs the cells around it
+    vector<vector<int>> corridor_map(3, vector<int>(400, 0));
+    corridor_map[1] = vector<int>(400, 1);
+    maze::grid::GridMap grid_map(corridor_map);
+    maze::graph::DStarLite planner(grid_map, 0, 0, 0, 399);
+    maze::graph::SearchStats first_stats;
+    vector<pair<int, int>> path;
+    planner.findPath(path, &first_stats);
+    ASSERT_EQ(path.size(), 400);
+
+    grid_map.setCell(1, 5, maze::grid::Constants::FREE_CELL);
+    planner.updateCells({{1, 5, false}});
+    maze::graph::SearchStats repair_stats;
+    path.clear();
+    planner.findPath(path, &repair_stats);
+    ASSERT_EQ(path.size(), 400);
+    ASSERT_LT(repair_stats.nodes_expanded * 10, first_stats.nodes_expanded);
+
+    grid_map.setCell(0, 200, maze::grid::Constants::WALL_CELL);
+    planner.updateCells({{0, 200, true}});
+    path.clear();
+    planner.findPath(path);
+    ASSERT_TRUE(path.empty());
+}
+
+int main(int ac, char* av[]) {
+    testing::InitGoogleTest(&ac, av);
+    return RUN_ALL_TESTS();
+}
@@ -16,12 +16,23 @@
 
 // stl includes
 #include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
 
 // external includes
 #include <gtest/gtest.h>
 
+// system includes
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 // project includes
 #include "maze.hpp"
+#include "test_utils.hpp"
 
 using namespace std;
 
@@ -69,6 +80,408 @@ TEST(GridTest, Constructor5)
     ASSERT_EQ(grid_map[9].size(), 10);
 }
 
+// Test flat grid map storage of a map file with multiple rows
+TEST(GridTest, Constructor6)
+{
+    string map_file_path = "maps/multiple_rows.txt";
+    maze::grid::Grid grid(map_file_path);
+    auto const& flat_grid_map = grid.getFlatGridMap();
+    auto grid_map = grid.getGridMap();
+    ASSERT_EQ(flat_grid_map.getNumberRows(), 10);
+    ASSERT_EQ(flat_grid_map.getNumberCols(), 10);
+    for(int row_index = 0; row_index < 10; row_index++)
+    {
+        for(int col_index = 0; col_index < 10; col_index++)
+        {
+            ASSERT_EQ(flat_grid_map.getCell(row_index, col_index), grid_map[row_index][col_index]);
+        }
+    }
+}
+
+// Test wall border and row padding of the flat grid map
+TEST(GridTest, GridMap1)
+{
+    maze::grid::GridMap grid_map(3, 5, 16);
+    ASSERT_EQ(grid_map.getRowStride(), 16);
+    ASSERT_TRUE(grid_map.isFree(0, 0));
+    ASSERT_FALSE(grid_map.isFree(-1, 0));
+    ASSERT_FALSE(grid_map.isFree(0, -1));
+    ASSERT_FALSE(grid_map.isFree(3, 4));
+    ASSERT_FALSE(grid_map.isFree(2, 5));
+    grid_map.setCell(1, 2, maze::grid::Constants::WALL_CELL);
+    ASSERT_FALSE(grid_map.isFree(1, 2));
+    int cell_index = grid_map.getCellIndex(2, 4);
+    ASSERT_EQ(grid_map.getRowIndex(cell_index), 2);
+    ASSERT_EQ(grid_map.getColIndex(cell_index), 4);
+    ASSERT_THROW(grid_map.setCell(3, 0, 0), out_of_range);
+}
+
+// Test row and column scans of the wall bitmap against a linear scan
+TEST(GridTest, WallBitmap1)
+{
+    maze::grid::GridMap grid_map(150, 300);
+    for(int row_index = 0; row_index < 150; row_index++)
+    {
+        for(int col_index = 0; col_index < 300; col_index++)
+        {
+            // walls everywhere except a few scattered cells
+            if((row_index * 7 + col_index * 13) % 97 != 0)
+            {
+                grid_map.setCell(row_index, col_index, maze::grid::Constants::WALL_CELL);
+            }
+        }
+    }
+
+    maze::grid::WallBitmap wall_bitmap(grid_map);
+    for(int row_index = 0; row_index < 150; row_index++)
+    {
+        int expected_col_index = maze::grid::Constants::INDEX_NOT_FOUND;
+        for(int col_index = 0; col_index < 300 && expected_col_index == maze::grid::Constants::INDEX_NOT_FOUND; col_index++)
+        {
+            if(grid_map.isFree(row_index, col_index))
+            {
+                expected_col_index = col_index;
+            }
+        }
+        ASSERT_EQ(wall_bitmap.findFirstFreeInRow(row_index), expected_col_index);
+    }
+
+    for(int col_index = 0; col_index < 300; col_index++)
+    {
+        int expected_row_index = maze::grid::Constants::INDEX_NOT_FOUND;
+        for(int row_index = 0; row_index < 150 && expected_row_index == maze::grid::Constants::INDEX_NOT_FOUND; row_index++)
+        {
+            if(grid_map.isFree(row_index, col_index))
+            {
+                expected_row_index = row_index;
+            }
+        }
+        ASSERT_EQ(wall_bitmap.findFirstFreeInCol(col_index), expected_row_index);
+    }
+}
+
+// Test wall walks and updates of the wall bitmap
+TEST(GridTest, WallBitmap2)
+{
+    maze::grid::GridMap grid_map(70, 260);
+    maze::grid::WallBitmap wall_bitmap(grid_map);
+    ASSERT_EQ(wall_bitmap.findFirstWallInRow(3, 10), 260);
+    ASSERT_EQ(wall_bitmap.findFirstWallInCol(3, 10), 70);
+    wall_bitmap.setWall(3, 200, true);
+    ASSERT_TRUE(wall_bitmap.isWall(3, 200));
+    ASSERT_EQ(wall_bitmap.findFirstWallInRow(3, 10), 200);
+    ASSERT_EQ(wall_bitmap.findFirstWallInCol(200, 0), 3);
+    ASSERT_EQ(wall_bitmap.findFirstFreeInRow(3, 200), 201);
+    wall_bitmap.setWall(3, 200, false);
+    ASSERT_EQ(wall_bitmap.findFirstWallInRow(3, 10), 260);
+}
+
+// Test that the zero copy loader gives the same results as the copying loader
+TEST(GridTest, ZeroCopy1)
+{
+    for(string map_file_path : {"maps/multiple_rows.txt", "maps/hallway_maze_4.txt", "maps/room_maze_4.txt", "maps/winding_path_maze_2.txt", "maps/start_end_maze_2.txt"})
+    {
+        maze::grid::Grid grid(map_file_path);
+        maze::grid::Grid mapped_grid(map_file_path, maze::grid::MapLoadMode::ZERO_COPY);
+        ASSERT_TRUE(mapped_grid.isInitialized());
+        ASSERT_TRUE(mapped_grid.getFlatGridMap().isMappedAscii());
+        ASSERT_EQ(mapped_grid.getGridMap(), grid.getGridMap());
+        ASSERT_EQ(mapped_grid.searchARowForEmptySpace(0), grid.searchARowForEmptySpace(0));
+        ASSERT_EQ(mapped_grid.walkThrouhHallway(), grid.walkThrouhHallway());
+        ASSERT_EQ(mapped_grid.findWindingPath(), grid.findWindingPath());
+        ASSERT_EQ(mapped_grid.solveMaze(), grid.solveMaze());
+    }
+}
+
+// Test that the zero copy loader rejects invalid map files
+TEST(GridTest, ZeroCopy2)
+{
+    string map_file_path = "maps/multiple_rows_2.txt";
+    maze::grid::Grid grid(map_file_path, maze::grid::MapLoadMode::ZERO_COPY);
+    ASSERT_FALSE(grid.isInitialized());
+}
+
+// Test that a map converted into the binary format loads the same grid and endpoints
+TEST(GridTest, BinaryMap1)
+{
+    // the generated map has rows of more than one word
+    auto generated_map_file_path = filesystem::temp_directory_path() / "maze_test_wide_map.txt";
+    maze::grid::writeMap(generated_map_file_path, maze::grid::generateMaze(maze::grid::MazeKind::OBSTACLES, 67, 141, 11));
+
+    for(string map_file_path : {string("maps/single_row_1.txt"), string("maps/room_maze_4.txt"), string("maps/winding_path_maze_2.txt"), string("maps/start_end_maze_2.txt"), generated_map_file_path.string()})
+    {
+        auto binary_map_file_path = filesystem::temp_directory_path() / "maze_test_binary_map.mzb";
+        maze::grid::Grid grid(map_file_path);
+        grid.saveBinaryMap(binary_map_file_path);
+        ASSERT_TRUE(maze::grid::isBinaryMap(binary_map_file_path));
+
+        maze::grid::Grid binary_grid(binary_map_file_path);
+        ASSERT_TRUE(binary_grid.isInitialized());
+        ASSERT_EQ(binary_grid.getGridMap(), grid.getGridMap());
+        ASSERT_EQ(binary_grid.solveMaze(), grid.solveMaze());
+
+        // the bitmap read with the map matches the one built from its cells
+        maze::grid::BinaryMapHeader header;
+        maze::grid::WallBitmap wall_bitmap;
+        maze::grid::WallBitmap expected_wall_bitmap(maze::grid::readBinaryMap(binary_map_file_path, header, &wall_bitmap));
+        for(int row_index = 0; row_index < expected_wall_bitmap.getNumberRows(); row_index++)
+        {
+            for(int word_index = 0; word_index < expected_wall_bitmap.getWordsPerRow(); word_index++)
+            {
+                ASSERT_EQ(wall_bitmap.getRowWords(row_index)[word_index], expected_wall_bitmap.getRowWords(row_index)[word_index]);
+            }
+        }
+        for(int col_index = 0; col_index < expected_wall_bitmap.getNumberCols(); col_index++)
+        {
+            for(int word_index = 0; word_index < expected_wall_bitmap.getWordsPerCol(); word_index++)
+            {
+                ASSERT_EQ(wall_bitmap.getColWords(col_index)[word_index], expected_wall_bitmap.getColWords(col_index)[word_index]);
+            }
+        }
+        filesystem::remove(binary_map_file_path);
+    }
+    filesystem::remove(generated_map_file_path);
+}
+
+// Test that a binary map with a corrupted payload or endpoint is rejected
+TEST(GridTest, BinaryMap2)
+{
+    auto binary_map_file_path = filesystem::temp_directory_path() / "maze_test_corrupted_map.mzb";
+    maze::grid::Grid grid("maps/start_end_maze_2.txt");
+    for(size_t corrupted_offset : {sizeof(maze::grid::BinaryMapHeader) + 3, offsetof(maze::grid::BinaryMapHeader, start_row_index), offsetof(maze::grid::BinaryMapHeader, end_col_index)})
+    {
+        grid.saveBinaryMap(binary_map_file_path);
+        {
+            fstream binary_map_file(binary_map_file_path, ios::in | ios::out | ios::binary);
+            binary_map_file.seekp(corrupted_offset);
+            binary_map_file.put('\x7f');
+        }
+
+        maze::grid::Grid binary_grid(binary_map_file_path);
+        ASSERT_FALSE(binary_grid.isInitialized());
+    }
+    filesystem::remove(binary_map_file_path);
+}
+
+// Test that the streaming functions give the same results as the grid
+TEST(GridTest, Stream1)
+{
+    for(string map_file_path : {"maps/single_row_1.txt", "maps/multiple_rows.txt", "maps/hallway_maze_4.txt", "maps/winding_path_maze_1.txt", "maps/winding_path_maze_2.txt"})
+    {
+        maze::grid::Grid grid(map_file_path);
+
+        ifstream row_file(map_file_path);
+        maze::grid::MapRowStream row_stream(row_file, 2);
+        ASSERT_EQ(maze::grid::streamSearchARowForEmptySpace(row_stream, 0), grid.searchARowForEmptySpace(0));
+
+        ifstream hallway_file(map_file_path);
+        maze::grid::MapRowStream hallway_stream(hallway_file, 2);
+        ASSERT_EQ(maze::grid::streamWalkThroughHallway(hallway_stream), grid.walkThrouhHallway());
+
+        ifstream winding_file(map_file_path);
+        maze::grid::MapRowStream winding_stream(winding_file);
+        ASSERT_EQ(maze::grid::streamFindWindingPath(winding_stream), grid.findWindingPath());
+    }
+
+    ifstream invalid_file("maps/invalid_winding_path_maze_1.txt");
+    maze::grid::MapRowStream invalid_stream(invalid_file);
+    ASSERT_TRUE(maze::grid::streamFindWindingPath(invalid_stream).empty());
+
+    // winding paths away from the first row and column start where the grid
+    // starts them, on a row or on a column
+    for(string map_text : {"11111\n11111\n11001\n11011\n11011\n", "1111\n1111\n1101\n0111\n0111\n", "111111\n101111\n101001\n100011\n", "11111\n11111\n11101\n11101\n10001\n"})
+    {
+        istringstream grid_stream(map_text);
+        maze::grid::Grid grid(grid_stream);
+        istringstream winding_text_stream(map_text);
+        maze::grid::MapRowStream winding_stream(winding_text_stream, 4);
+        auto path = grid.findWindingPath();
+        ASSERT_FALSE(path.empty());
+        ASSERT_EQ(maze::grid::streamFindWindingPath(winding_stream), path);
+    }
+
+    // column 1 is searched before row 2
+    istringstream column_grid_stream("11111\n11111\n11101\n11101\n10001\n");
+    maze::grid::Grid column_grid(column_grid_stream);
+    ASSERT_EQ(column_grid.findWindingPath().front(), make_pair(4, 1));
+
+    // a map without free cells has no winding path
+    istringstream wall_grid_stream("111\n111\n");
+    maze::grid::Grid wall_grid(wall_grid_stream);
+    ASSERT_TRUE(wall_grid.findWindingPath().empty());
+
+    // a start that has left the window can not be followed
+    istringstream tall_grid_stream("111\n110\n110\n111\n111\n111\n");
+    maze::grid::Grid tall_grid(tall_grid_stream);
+    ASSERT_FALSE(tall_grid.findWindingPath().empty());
+    istringstream tall_text_stream("111\n110\n110\n111\n111\n111\n");
+    maze::grid::MapRowStream tall_stream(tall_text_stream, 2);
+    ASSERT_TRUE(maze::grid::streamFindWindingPath(tall_stream).empty());
+}
+
+// Test that rows which have left the streaming window can not be read
+TEST(GridTest, Stream2)
+{
+    ifstream map_file("maps/hallway_maze_4.txt");
+    maze::grid::MapRowStream row_stream(map_file, 2);
+    ASSERT_TRUE(row_stream.ensureRow(3));
+    ASSERT_NO_THROW(row_stream.getRow(2));
+    ASSERT_THROW(row_stream.getRow(1), out_of_range);
+    ASSERT_FALSE(row_stream.isFree(-1, 0));
+}
+
+// Test that a grid read from a stream is stored on disk and solves like the grid
+TEST(GridTest, Stream3)
+{
+    for(string map_file_path : {"maps/room_maze_4.txt", "maps/start_end_maze_1.txt", "maps/start_end_maze_2.txt"})
+    {
+        maze::grid::Grid grid(map_file_path);
+
+        ifstream map_file(map_file_path);
+        maze::grid::Grid disk_grid(map_file);
+        ASSERT_TRUE(disk_grid.isInitialized());
+        ASSERT_TRUE(disk_grid.getFlatGridMap().isDiskBacked());
+        ASSERT_EQ(disk_grid.getGridMap(), grid.getGridMap());
+        ASSERT_EQ(disk_grid.findPathToAndOutOfRoom(), grid.findPathToAndOutOfRoom());
+        ASSERT_EQ(disk_grid.solveMaze(), grid.solveMaze());
+    }
+
+    maze::grid::ScratchArray<int> scratch_array;
+    scratch_array.assign(100000, 7, true);
+    ASSERT_TRUE(scratch_array.isOnDisk());
+    ASSERT_EQ(scratch_array[99999], 7);
+}
+
+// Test that generated mazes are deterministic and can be solved
+TEST(GridTest, Generator1)
+{
+    for(auto maze_kind : {maze::grid::MazeKind::BACKTRACKER, maze::grid::MazeKind::KRUSKAL, maze::grid::MazeKind::ROOM, maze::grid::MazeKind::OBSTACLES, maze::grid::MazeKind::WINDING})
+    {
+        auto grid_map = maze::grid::generateMaze(maze_kind, 33, 40, 7);
+        ASSERT_EQ(grid_map.toVectorOfVectors(), maze::grid::generateMaze(maze_kind, 33, 40, 7).toVectorOfVectors());
+
+        auto map_file_path = filesystem::temp_directory_path() / "maze_test_generated_map.txt";
+        maze::grid::writeMap(map_file_path, grid_map);
+        maze::grid::Grid grid(map_file_path);
+        ASSERT_EQ(grid.getGridMap(), grid_map.toVectorOfVectors());
+        filesystem::remove(map_file_path);
+
+        // perfect mazes connect every cell, so only the obstacles may be blocked
+        if(maze_kind != maze::grid::MazeKind::OBSTACLES)
+        {
+            ASSERT_FALSE(grid.solveMaze().empty());
+        }
+    }
+
+    ASSERT_NE(maze::grid::generateMaze(maze::grid::MazeKind::BACKTRACKER, 33, 40, 7).toVectorOfVectors(), maze::grid::generateMaze(maze::grid::MazeKind::BACKTRACKER, 33, 40, 8).toVectorOfVectors());
+    ASSERT_THROW(maze::grid::generateMaze(maze::grid::MazeKind::ROOM, 3, 40, 7), invalid_argument);
+}
+
+// Test that generated rooms and winding paths satisfy the user story assumptions
+TEST(GridTest, Generator2)
+{
+    for(auto size : {4, 5, 16, 17})
+    {
+        auto map_file_path = filesystem::temp_directory_path() / "maze_test_generated_map.txt";
+        maze::grid::writeMap(map_file_path, maze::grid::generateMaze(maze::grid::MazeKind::WINDING, size, size + 3, 1));
+        maze::grid::Grid winding_grid(map_file_path);
+
+        int number_free_cells = 0;
+        for(auto const& row : winding_grid.getGridMap())
+        {
+            number_free_cells += count(row.begin(), row.end(), 0);
+        }
+        ASSERT_EQ(static_cast<int>(winding_grid.findWindingPath().size()), number_free_cells);
+        ASSERT_EQ(winding_grid.solveMaze().size(), winding_grid.findWindingPath().size());
+
+        maze::grid::writeMap(map_file_path, maze::grid::generateMaze(maze::grid::MazeKind::ROOM, size, size + 3, 1));
+        maze::grid::Grid room_grid(map_file_path);
+        auto path = room_grid.findPathToAndOutOfRoom();
+        ASSERT_FALSE(path.empty());
+        ASSERT_EQ(path.back(), make_pair(size - 1, size + 1));
+        filesystem::remove(map_file_path);
+    }
+}
+
+// Test that the work stealing pool runs every task exactly once
+TEST(GridTest, WorkStealingPool1)
+{
+    maze::grid::WorkStealingPool pool(4);
+    vector<int> task_counts(1000, 0);
+    pool.run(task_counts.size(), [&](const int& task_index, const int& thread_index)
+    {
+        ASSERT_LT(thread_index, 4);
+        task_counts[task_index]++;
+    });
+    ASSERT_EQ(count(task_counts.begin(), task_counts.end(), 1), 1000);
+
+    ASSERT_THROW(pool.run(10, [](const int& task_index, const int&) { if(task_index == 7) throw runtime_error("Task failed."); }), runtime_error);
+}
+
+// Test that map files are collected from a directory, a glob and a manifest
+TEST(GridTest, Batch1)
+{
+    auto directory_map_files = maze::grid::collectMapFiles("maps");
+    ASSERT_EQ(directory_map_files.size(), 28);
+    ASSERT_TRUE(is_sorted(directory_map_files.begin(), directory_map_files.end()));
+
+    auto glob_map_files = maze::grid::collectMapFiles("maps/room_maze_*.txt");
+    ASSERT_EQ(glob_map_files.size(), 7);
+    ASSERT_EQ(glob_map_files[0], filesystem::path("maps/room_maze_1.txt"));
+
+    auto manifest_file_path = filesystem::temp_directory_path() / "maze_test_manifest.txt";
+    {
+        ofstream manifest_file(manifest_file_path);
+        manifest_file << "# maps of the batch" << endl << filesystem::absolute("maps/empty.txt").string() << endl << endl << "relative.txt" << endl;
+    }
+    auto manifest_map_files = maze::grid::collectMapFiles(manifest_file_path.string());
+    ASSERT_EQ(manifest_map_files.size(), 2);
+    ASSERT_EQ(manifest_map_files[1], filesystem::temp_directory_path() / "relative.txt");
+    filesystem::remove(manifest_file_path);
+
+    ASSERT_THROW(maze::grid::collectMapFiles("maps/does_not_exist"), filesystem::filesystem_error);
+}
+
+// Test that a batch gives the same results as solving the maps one by one
+TEST(GridTest, Batch2)
+{
+    auto map_files = maze::grid::collectMapFiles("maps/start_end_maze_*.txt");
+    map_files.push_back("maps/multiple_rows_2.txt");
+
+    maze::grid::BatchOptions options;
+    options.number_threads = 3;
+    auto results = maze::grid::solveMaps(map_files, options);
+    ASSERT_EQ(results.size(), map_files.size());
+
+    for(size_t map_index = 0; map_index + 1 < map_files.size(); map_index++)
+    {
+        maze::grid::Grid grid(map_files[map_index].string());
+        ASSERT_EQ(results[map_index].map_file, map_files[map_index].string());
+        ASSERT_EQ(results[map_index].status, "solved");
+        ASSERT_EQ(results[map_index].path_length, static_cast<int>(grid.solveMaze().size()));
+    }
+    ASSERT_EQ(results.back().status, "invalid_map");
+
+    ostringstream jsonl_stream;
+    maze::grid::writeBatchResults(jsonl_stream, {results.back()}, maze::grid::BatchFormat::JSONL);
+    ASSERT_EQ(jsonl_stream.str().rfind("{\"map_file\":\"maps/multiple_rows_2.txt\",\"status\":\"invalid_map\",\"path_length\":0,", 0), 0);
+
+    ostringstream csv_stream;
+    maze::grid::writeBatchResults(csv_stream, {results.back()}, maze::grid::BatchFormat::CSV);
+    ASSERT_EQ(csv_stream.str().rfind("map_file,status,path_length,milliseconds\nmaps/multiple_rows_2.txt,invalid_map,0,", 0), 0);
+
+    // the solve options reach every map of the batch
+    options.solve_options.search_algorithm = maze::grid::SearchAlgorithm::DIJKSTRA;
+    options.solve_options.connectivity = maze::grid::Connectivity::EIGHT;
+    results = maze::grid::solveMaps(map_files, options);
+    for(size_t map_index = 0; map_index + 1 < map_files.size(); map_index++)
+    {
+        maze::grid::Grid grid(map_files[map_index].string());
+        ASSERT_EQ(results[map_index].status, "solved");
+        ASSERT_EQ(results[map_index].path_length, static_cast<int>(grid.solveMaze(options.solve_options).size()));
+    }
+}
+
 // Test search on map file with single row
 TEST(GridTest, SearchARowForEmptySpace1)
 {
@@ -285,6 +698,21 @@ TEST(GridTest, RoomPath9)
     ASSERT_EQ(path.size(), 0);
 }
 
+// Test that the path into and out of a room uses the doors of its corners
+TEST(GridTest, RoomPath10)
+{
+    // a door above the top left corner is taken before one to its left
+    istringstream map_stream("11101111\n11101111\n11000011\n11100000\n11111111\n");
+    maze::grid::Grid grid(map_stream);
+    vector<pair<int, int>> expected_path = {{1, 3}, {2, 3}, {3, 3}, {3, 4}, {3, 5}, {3, 6}};
+    ASSERT_EQ(grid.findPathToAndOutOfRoom(), expected_path);
+
+    istringstream left_door_map_stream("11111111\n11111111\n11000011\n11100000\n11111111\n");
+    maze::grid::Grid left_door_grid(left_door_map_stream);
+    expected_path = {{2, 2}, {2, 3}, {2, 4}, {2, 5}, {3, 5}, {3, 6}};
+    ASSERT_EQ(left_door_grid.findPathToAndOutOfRoom(), expected_path);
+}
+
 // Test winding path following on map file with multiple rows and invalid winding path
 TEST(GridTest, WindingPath1)
 {
@@ -373,6 +801,515 @@ TEST(GridTest, SolveMaze5)
     ASSERT_EQ(path[16].second, 9);
 }
 
+// Test finding paths between arbitrary cells of a maze
+TEST(GridTest, FindPath1)
+{
+    string map_file_path = "maps/start_end_maze_2.txt";
+    maze::grid::Grid grid(map_file_path);
+
+    auto path = grid.findPath(make_pair(1, 9), make_pair(4, 1));
+    ASSERT_EQ(path.size(), 12);
+    ASSERT_EQ(path[0], make_pair(1, 9));
+    ASSERT_EQ(path[11], make_pair(4, 1));
+
+    ASSERT_EQ(grid.findPath(make_pair(1, 1), make_pair(1, 1)).size(), 1);
+    ASSERT_EQ(grid.findPath(make_pair(1, 1), make_pair(0, 0)).size(), 0);
+    ASSERT_EQ(grid.findPath(make_pair(1, 1), make_pair(9, 0)).size(), 0);
+
+    maze::grid::SolveOptions options;
+    for(auto search_algorithm : {maze::grid::SearchAlgorithm::JPS, maze::grid::SearchAlgorithm::BIDIRECTIONAL_BFS, maze::grid::SearchAlgorithm::BIDIRECTIONAL_ASTAR, maze::grid::SearchAlgorithm::HIERARCHICAL})
+    {
+        options.search_algorithm = search_algorithm;
+        ASSERT_EQ(grid.findPath(make_pair(1, 9), make_pair(4, 1), options).size(), 12);
+        ASSERT_EQ(grid.findPath(make_pair(0, 1), make_pair(8, 9), options), grid.solveMaze(search_algorithm));
+    }
+}
+
+// Test answering a query file on several threads
+TEST(GridTest, FindPath2)
+{
+    istringstream query_stream("# start and end cells\n0 1 8 9\n\n 1 9 4 1\r\n1 1 0 0\n");
+    auto queries = maze::grid::readPathQueries(query_stream);
+    ASSERT_EQ(queries.size(), 3);
+    ASSERT_EQ(queries[1].start_cell, make_pair(1, 9));
+    ASSERT_EQ(queries[1].end_cell, make_pair(4, 1));
+
+    istringstream invalid_query_stream("0 1 8 11\n0 1 8\n");
+    ASSERT_THROW(maze::grid::readPathQueries(invalid_query_stream), invalid_argument);
+
+    maze::grid::Grid grid("maps/start_end_maze_2.txt");
+    maze::grid::SolveOptions options;
+    options.number_threads = 2;
+    options.search_algorithm = maze::grid::SearchAlgorithm::HIERARCHICAL;
+    auto paths = grid.findPaths(queries, options);
+    ASSERT_EQ(paths.size(), 3);
+    ASSERT_EQ(paths[0].size(), 17);
+    ASSERT_EQ(paths[1].size(), 12);
+    ASSERT_EQ(paths[2].size(), 0);
+}
+
+// Test labeling the connected components of a grid map
+TEST(GridTest, Components1)
+{
+    maze::grid::GridMap grid_map(vector<vector<int>>{
+        {0, 1, 0, 1, 0},
+        {0, 1, 0, 1, 0},
+        {0, 0, 0, 1, 0},
+        {1, 1, 1, 1, 0},
+        {0, 0, 1, 0, 0}
+    });
+    maze::grid::ComponentIndex component_index(grid_map);
+
+    ASSERT_EQ(component_index.getNumberComponents(), 3);
+    ASSERT_EQ(component_index.getComponentSizes(), vector<int64_t>({7, 6, 2}));
+    ASSERT_TRUE(component_index.isConnected(grid_map.getCellIndex(0, 0), grid_map.getCellIndex(0, 2)));
+    ASSERT_TRUE(component_index.isConnected(grid_map.getCellIndex(0, 4), grid_map.getCellIndex(4, 3)));
+    ASSERT_FALSE(component_index.isConnected(grid_map.getCellIndex(0, 0), grid_map.getCellIndex(4, 0)));
+    ASSERT_FALSE(component_index.isConnected(grid_map.getCellIndex(0, 1), grid_map.getCellIndex(0, 1)));
+    ASSERT_EQ(component_index.getComponent(grid_map.getCellIndex(3, 0)), maze::grid::Constants::INDEX_NOT_FOUND);
+}
+
+// Test that the components agree with the paths found by A*
+TEST(GridTest, Components2)
+{
+    auto grid_map = maze::grid::generateMaze(maze::grid::MazeKind::OBSTACLES, 40, 40, 7);
+    maze::grid::ComponentIndex component_index(grid_map);
+
+    for(auto const& query : samplePathQueries(grid_map, 200))
+    {
+        auto start_cell = query.start_cell;
+        auto end_cell = query.end_cell;
+        vector<pair<int, int>> path;
+        maze::graph::performAStar(grid_map, start_cell.first, start_cell.second, end_cell.first, end_cell.second, path);
+        ASSERT_EQ(component_index.isConnected(grid_map.getCellIndex(start_cell.first, start_cell.second), grid_map.getCellIndex(end_cell.first, end_cell.second)), !path.empty());
+    }
+}
+
+// Test that the search options select the heuristic and the moves
+TEST(GridTest, SolveOptions1)
+{
+    string map_file_path = "maps/room_maze_4.txt";
+    maze::grid::Grid grid(map_file_path);
+    auto astar_path = grid.solveMaze();
+    ASSERT_GT(astar_path.size(), 0);
+
+    maze::grid::SolveOptions options;
+    options.search_algorithm = maze::grid::SearchAlgorithm::DIJKSTRA;
+    ASSERT_EQ(grid.solveMaze(options).size(), astar_path.size());
+
+    // diagonal steps cross the room in fewer cells
+    options.connectivity = maze::grid::Connectivity::EIGHT;
+    auto diagonal_path = grid.solveMaze(options);
+    ASSERT_GT(diagonal_path.size(), 0);
+    ASSERT_LE(diagonal_path.size(), astar_path.size());
+    options.search_algorithm = maze::grid::SearchAlgorithm::ASTAR;
+    ASSERT_EQ(grid.solveMaze(options).size(), diagonal_path.size());
+
+    // the zero heuristic keeps the paths shortest, the Manhattan one still
+    // finds a path
+    options.heuristic = maze::grid::SearchHeuristic::ZERO;
+    ASSERT_EQ(grid.solveMaze(options).size(), diagonal_path.size());
+    options.heuristic = maze::grid::SearchHeuristic::MANHATTAN;
+    auto manhattan_path = grid.solveMaze(options);
+    ASSERT_GT(manhattan_path.size(), 0);
+    ASSERT_EQ(manhattan_path.front(), diagonal_path.front());
+    ASSERT_EQ(manhattan_path.back(), diagonal_path.back());
+    options.heuristic = maze::grid::SearchHeuristic::OCTILE;
+
+    options.search_algorithm = maze::grid::SearchAlgorithm::JPS;
+    ASSERT_TRUE(grid.solveMaze(options).empty());
+
+    options.search_algorithm = maze::grid::SearchAlgorithm::CORRIDOR_GRAPH;
+    options.connectivity = maze::grid::Connectivity::FOUR;
+    ASSERT_EQ(grid.solveMaze(options).size(), astar_path.size());
+
+    options.search_algorithm = maze::grid::SearchAlgorithm::PARALLEL_BFS;
+    options.number_threads = 2;
+    ASSERT_EQ(grid.solveMaze(options).size(), astar_path.size());
+}
+
+// Test that the neighbor masks match the free neighbors of every cell
+TEST(GridTest, NeighborMask1)
+{
+    auto checkMasks = [](maze::grid::GridMap const& grid_map, maze::grid::NeighborMask const& neighbor_mask)
+    {
+        for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+        {
+            for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++)
+            {
+                int expected_mask = (col_index > 0 && grid_map.isFree(row_index, col_index - 1)) * maze::grid::NeighborMask::LEFT
+                    | (col_index + 1 < grid_map.getNumberCols() && grid_map.isFree(row_index, col_index + 1)) * maze::grid::NeighborMask::RIGHT
+                    | (row_index > 0 && grid_map.isFree(row_index - 1, col_index)) * maze::grid::NeighborMask::TOP
+                    | (row_index + 1 < grid_map.getNumberRows() && grid_map.isFree(row_index + 1, col_index)) * maze::grid::NeighborMask::BOTTOM;
+                ASSERT_EQ(neighbor_mask.getMask(grid_map.getCellIndex(row_index, col_index)), expected_mask);
+            }
+        }
+    };
+
+    for(string map_file_path : {"maps/room_maze_4.txt", "maps/winding_path_maze_2.txt"})
+    {
+        maze::grid::Grid mapped_grid(map_file_path, maze::grid::MapLoadMode::ZERO_COPY);
+        checkMasks(mapped_grid.getFlatGridMap(), mapped_grid.getNeighborMask());
+    }
+
+    auto grid_map = maze::grid::generateMaze(maze::grid::MazeKind::OBSTACLES, 37, 70, 3);
+    maze::grid::NeighborMask neighbor_mask(grid_map);
+    checkMasks(grid_map, neighbor_mask);
+
+    vector<pair<int, int>> path;
+    vector<pair<int, int>> mask_path;
+    maze::graph::performAStar(grid_map, 0, 1, 36, 68, path);
+    maze::graph::performAStar(grid_map, neighbor_mask, 0, 1, 36, 68, mask_path);
+    ASSERT_EQ(mask_path, path);
+
+    for(auto const& cell : {make_pair(0, 0), make_pair(36, 69), make_pair(18, 35), make_pair(18, 36)})
+    {
+        grid_map.setCell(cell.first, cell.second, grid_map.isFree(cell.first, cell.second) ? maze::grid::Constants::WALL_CELL : maze::grid::Constants::FREE_CELL);
+        neighbor_mask.updateCell(grid_map, cell.first, cell.second);
+    }
+    checkMasks(grid_map, neighbor_mask);
+    ASSERT_EQ(neighbor_mask.getDegree(grid_map.getCellIndex(18, 35)), __builtin_popcount(neighbor_mask.getMask(grid_map.getCellIndex(18, 35))));
+}
+
+// Test that cell updates reach the searches and the connected components
+TEST(GridTest, SetCells1)
+{
+    string map_file_path = "maps/start_end_maze_2.txt";
+    maze::grid::Grid grid(map_file_path);
+    auto path = grid.findPath(make_pair(0, 1), make_pair(8, 9));
+    ASSERT_EQ(path.size(), 17);
+    int number_components = grid.getComponentIndex().getNumberComponents();
+
+    // the maze has a single path, so closing one of its cells cuts it
+    ASSERT_TRUE(grid.setCell(path[8].first, path[8].second, true));
+    ASSERT_TRUE(grid.findPath(make_pair(0, 1), make_pair(8, 9)).empty());
+    ASSERT_GT(grid.getComponentIndex().getNumberComponents(), number_components);
+
+    maze::grid::SolveOptions options;
+    options.search_algorithm = maze::grid::SearchAlgorithm::HIERARCHICAL;
+    ASSERT_TRUE(grid.findPath(make_pair(0, 1), make_pair(8, 9), options).empty());
+
+    ASSERT_FALSE(grid.setCells({{path[8].first, path[8].second, false}, {10, 0, false}}));
+    ASSERT_TRUE(grid.findPath(make_pair(0, 1), make_pair(8, 9)).empty());
+
+    ASSERT_TRUE(grid.setCells({{path[8].first, path[8].second, false}}));
+    ASSERT_EQ(grid.findPath(make_pair(0, 1), make_pair(8, 9)), path);
+    ASSERT_EQ(grid.findPath(make_pair(0, 1), make_pair(8, 9), options).size(), 17);
+    ASSERT_EQ(grid.getComponentIndex().getNumberComponents(), number_components);
+}
+
+// Test that solving a maze reports its phases and search counters
+TEST(GridTest, SolveStats1)
+{
+    string map_file_path = "maps/start_end_maze_2.txt";
+    maze::grid::Grid grid(map_file_path);
+    maze::grid::SolveStats stats;
+    auto path = grid.solveMaze(maze::grid::SearchAlgorithm::ASTAR, &stats);
+    ASSERT_EQ(path.size(), 17);
+    ASSERT_GT(stats.load_milliseconds, 0.0);
+    ASSERT_GE(stats.search_milliseconds, 0.0);
+    ASSERT_GE(stats.search_stats.nodes_expanded, 17);
+    ASSERT_GE(stats.search_stats.nodes_pushed, stats.search_stats.nodes_expanded);
+
+    // a second solve starts from fresh counters
+    auto nodes_expanded = stats.search_stats.nodes_expanded;
+    grid.solveMaze(maze::grid::SearchAlgorithm::ASTAR, &stats);
+    ASSERT_EQ(stats.search_stats.nodes_expanded, nodes_expanded);
+
+    ostringstream output_stream;
+    maze::grid::writeSolveStats(output_stream, stats);
+    ASSERT_NE(output_stream.str().find("Nodes expanded : " + to_string(nodes_expanded)), string::npos);
+}
+
+// Test that the rooms, corridors and doors of a map are found and routed
+TEST(GridTest, RegionIndex1)
+{
+    // two rooms joined by a corridor and a third room below the first one
+    istringstream map_stream("11111111111\n10011111001\n10000000001\n10011111001\n10111111111\n10011111111\n10011111111\n11111111111\n");
+    maze::grid::Grid grid(map_stream);
+    auto const& regions = grid.getRegionIndex();
+    ASSERT_EQ(regions.getNumberRegions(), 5);
+    ASSERT_EQ(regions.getDoors().size(), 4);
+
+    auto const& grid_map = grid.getFlatGridMap();
+    ASSERT_EQ(regions.getRegion(grid_map.getCellIndex(0, 0)), maze::grid::Constants::INDEX_NOT_FOUND);
+    int room = regions.getRegion(grid_map.getCellIndex(1, 1));
+    ASSERT_EQ(regions.getRegionInfo(room).kind, maze::grid::RegionKind::ROOM);
+    ASSERT_TRUE(regions.getRegionInfo(room).isRectangle());
+    ASSERT_EQ(regions.getRegionInfo(room).number_cells, 6);
+    ASSERT_EQ(regions.getRegionInfo(room).bottom_row_index, 3);
+    ASSERT_EQ(regions.getRegionInfo(room).right_col_index, 2);
+    ASSERT_EQ(regions.getRegionDoors(room).size(), 2);
+
+    int corridor = regions.getRegion(grid_map.getCellIndex(2, 5));
+    ASSERT_EQ(regions.getRegionInfo(corridor).kind, maze::grid::RegionKind::CORRIDOR);
+    ASSERT_EQ(regions.getRegionInfo(corridor).number_cells, 5);
+
+    auto route = grid.findRoomRoute(make_pair(6, 2), make_pair(1, 9));
+    ASSERT_EQ(route.size(), 4);
+    ASSERT_EQ(route[0].cell_a, make_pair(5, 1));
+    ASSERT_EQ(route[0].cell_b, make_pair(4, 1));
+    ASSERT_EQ(route[1].cell_b, make_pair(3, 1));
+    ASSERT_EQ(route[2].cell_a, make_pair(2, 2));
+    ASSERT_EQ(route[3].cell_a, make_pair(2, 7));
+    ASSERT_EQ(route[3].cell_b, make_pair(2, 8));
+    for(size_t door_index = 1; door_index < route.size(); door_index++)
+    {
+        ASSERT_EQ(route[door_index].region_a, route[door_index - 1].region_b);
+    }
+
+    ASSERT_TRUE(grid.findRoomRoute(make_pair(1, 1), make_pair(3, 2)).empty());
+    ASSERT_TRUE(grid.findRoomRoute(make_pair(0, 0), make_pair(3, 2)).empty());
+    ASSERT_TRUE(grid.findRoomRoute(make_pair(1, 1), make_pair(8, 2)).empty());
+
+    // closing the corridor cuts the second room off
+    ASSERT_TRUE(grid.setCell(2, 5, true));
+    ASSERT_EQ(grid.getRegionIndex().getNumberRegions(), 6);
+    ASSERT_TRUE(grid.findRoomRoute(make_pair(6, 2), make_pair(1, 9)).empty());
+    ASSERT_EQ(grid.findRoomRoute(make_pair(6, 2), make_pair(2, 4)).size(), 3);
+}
+
+// Test that a packed path keeps its cells and is written in every format
+TEST(GridTest, PackedPath1)
+{
+    string map_file_path = "maps/room_maze_4.txt";
+    maze::grid::Grid grid(map_file_path);
+    auto path = grid.solveMaze();
+    ASSERT_GT(path.size(), 0);
+
+    auto packed_path = grid.solveMazePacked();
+    ASSERT_EQ(packed_path.getNumberCells(), static_cast<int64_t>(path.size()));
+    ASSERT_EQ(packed_path.getStartCell(), path.front());
+    ASSERT_EQ(packed_path.getEndCell(), path.back());
+    ASSERT_EQ(packed_path.unpack(), path);
+
+    // the text format is the one the solver always printed
+    ostringstream expected_stream;
+    expected_stream << "Path Start -> ";
+    for(auto const& cell : path)
+    {
+        expected_stream << "(" << cell.first << ", " << cell.second << ")" << " -> ";
+    }
+    expected_stream << "End" << endl;
+
+    ostringstream text_stream;
+    maze::grid::writePath(text_stream, packed_path, maze::grid::PathFormat::TEXT);
+    ASSERT_EQ(text_stream.str(), expected_stream.str());
+
+    maze::grid::PackedPath short_path({{1, 1}, {1, 2}, {1, 3}, {1, 4}, {2, 4}, {3, 4}, {3, 3}});
+    ostringstream rle_stream;
+    maze::grid::writePath(rle_stream, short_path, maze::grid::PathFormat::RLE);
+    ASSERT_EQ(rle_stream.str(), "1 1 R3D2L\n");
+
+    ostringstream json_stream;
+    maze::grid::writePath(json_stream, short_path, maze::grid::PathFormat::JSON);
+    ASSERT_EQ(json_stream.str(), "{\"start\":[1,1],\"end\":[3,3],\"length\":7,\"moves\":\"R3D2L\"}\n");
+
+    ostringstream empty_stream;
+    maze::grid::writePath(empty_stream, maze::grid::PackedPath(), maze::grid::PathFormat::JSON);
+    ASSERT_EQ(empty_stream.str(), "null\n");
+
+    // the binary format keeps paths longer than one word
+    stringstream binary_stream;
+    maze::grid::writePath(binary_stream, packed_path, maze::grid::PathFormat::BINARY);
+    ASSERT_EQ(maze::grid::readPath(binary_stream).unpack(), path);
+
+    stringstream invalid_stream("MZP0");
+    ASSERT_THROW(maze::grid::readPath(invalid_stream), invalid_argument);
+    ASSERT_THROW(maze::grid::PackedPath({{1, 1}, {2, 2}}), invalid_argument);
+}
+
+// Test that the packed variants find the same paths as the cell vectors
+TEST(GridTest, PackedPath2)
+{
+    maze::grid::Grid grid("maps/start_end_maze_2.txt");
+    maze::grid::SolveOptions options;
+    for(auto search_algorithm : {maze::grid::SearchAlgorithm::ASTAR, maze::grid::SearchAlgorithm::DIJKSTRA, maze::grid::SearchAlgorithm::JPS, maze::grid::SearchAlgorithm::BIDIRECTIONAL_BFS, maze::grid::SearchAlgorithm::BIDIRECTIONAL_ASTAR, maze::grid::SearchAlgorithm::HIERARCHICAL, maze::grid::SearchAlgorithm::CORRIDOR_GRAPH, maze::grid::SearchAlgorithm::PARALLEL_BFS})
+    {
+        options.search_algorithm = search_algorithm;
+        ASSERT_EQ(grid.findPathPacked(make_pair(1, 9), make_pair(4, 1), options).unpack(), grid.findPath(make_pair(1, 9), make_pair(4, 1), options));
+        ASSERT_EQ(grid.findPathPacked(make_pair(1, 1), make_pair(1, 1), options).unpack(), grid.findPath(make_pair(1, 1), make_pair(1, 1), options));
+        ASSERT_EQ(grid.findPathPacked(make_pair(1, 1), make_pair(0, 0), options).getNumberCells(), 0);
+        ASSERT_EQ(grid.solveMazePacked(options).unpack(), grid.solveMaze(options));
+
+        auto queries = samplePathQueries(maze::grid::readMap("maps/start_end_maze_2.txt"), 20);
+        auto paths = grid.findPaths(queries, options);
+        auto packed_paths = grid.findPathsPacked(queries, options);
+        ASSERT_EQ(packed_paths.size(), paths.size());
+        for(size_t path_index = 0; path_index < paths.size(); path_index++)
+        {
+            ASSERT_EQ(packed_paths[path_index].unpack(), paths[path_index]);
+        }
+    }
+
+    // paths with diagonal steps can not be packed
+    options.connectivity = maze::grid::Connectivity::EIGHT;
+    ASSERT_EQ(grid.findPathPacked(make_pair(1, 9), make_pair(4, 1), options).getNumberCells(), 0);
+
+    for(string map_file_path : {"maps/hallway_maze_1.txt", "maps/hallway_maze_2.txt", "maps/hallway_maze_3.txt"})
+    {
+        maze::grid::Grid hallway_grid(map_file_path);
+        ASSERT_EQ(hallway_grid.walkThroughHallwayPacked().unpack(), hallway_grid.walkThrouhHallway());
+    }
+
+    for(string map_file_path : {"maps/room_maze_1.txt", "maps/room_maze_4.txt", "maps/invalid_room_1.txt"})
+    {
+        maze::grid::Grid room_grid(map_file_path);
+        ASSERT_EQ(room_grid.findPathToAndOutOfRoomPacked().unpack(), room_grid.findPathToAndOutOfRoom());
+    }
+
+    for(string map_file_path : {"maps/winding_path_maze_1.txt", "maps/winding_path_maze_2.txt"})
+    {
+        maze::grid::Grid winding_grid(map_file_path);
+        ASSERT_EQ(winding_grid.findWindingPathPacked().unpack(), winding_grid.findWindingPath());
+    }
+
+    // a start with two branches is packed from the end of the second one
+    istringstream fork_grid_stream("11111\n11111\n10011\n10111\n11111\n");
+    maze::grid::Grid fork_grid(fork_grid_stream);
+    auto winding_path = fork_grid.findWindingPath();
+    auto packed_winding_path = fork_grid.findWindingPathPacked().unpack();
+    ASSERT_EQ(winding_path.size(), 3);
+    ASSERT_EQ(packed_winding_path.size(), winding_path.size());
+    ASSERT_TRUE(is_permutation(packed_winding_path.begin(), packed_winding_path.end(), winding_path.begin()));
+}
+
+// Test writing and joining the moves of packed paths
+TEST(GridTest, PackedPath3)
+{
+    // paths longer than one word are joined across the word boundary
+    vector<pair<int, int>> cells;
+    for(int col_index = 0; col_index <= 40; col_index++)
+    {
+        cells.push_back(make_pair(0, col_index));
+    }
+    for(int row_index = 1; row_index <= 30; row_index++)
+    {
+        cells.push_back(make_pair(row_index, 40));
+    }
+
+    maze::grid::PackedPath path(vector<pair<int, int>>(cells.begin(), cells.begin() + 41));
+    path.append(maze::grid::PackedPath(vector<pair<int, int>>(cells.begin() + 40, cells.end())));
+    ASSERT_EQ(path.unpack(), cells);
+    ASSERT_THROW(path.append(maze::grid::PackedPath(5, 5)), invalid_argument);
+
+    path.reverse();
+    vector<pair<int, int>> reversed_cells(cells.rbegin(), cells.rend());
+    ASSERT_EQ(path.unpack(), reversed_cells);
+    path.reverse();
+    ASSERT_EQ(path.unpack(), cells);
+
+    maze::grid::PackedPath set_path(make_pair(2, 2), make_pair(1, 3), 2);
+    set_path.setMove(0, maze::grid::PackedPath::getMoveBetween(make_pair(2, 2), make_pair(1, 2)));
+    set_path.setMove(1, maze::grid::PackedPath::getMoveBetween(make_pair(1, 2), make_pair(1, 3)));
+    vector<pair<int, int>> expected_cells = {{2, 2}, {1, 2}, {1, 3}};
+    ASSERT_EQ(set_path.unpack(), expected_cells);
+    ASSERT_THROW(set_path.setMove(2, 0), invalid_argument);
+}
+
+// Test that the grid cache keeps the recently used grids and reloads changed maps
+TEST(GridTest, GridCache1)
+{
+    auto map_file_path = filesystem::temp_directory_path() / "maze_test_cached_map.txt";
+    filesystem::copy_file("maps/room_maze_4.txt", map_file_path, filesystem::copy_options::overwrite_existing);
+
+    maze::grid::GridCache grid_cache(2);
+    auto grid = grid_cache.getGrid(map_file_path.string());
+    ASSERT_NE(grid, nullptr);
+    ASSERT_EQ(grid_cache.getGrid(map_file_path.string()), grid);
+    ASSERT_EQ(grid_cache.getNumberHits(), 1);
+    ASSERT_EQ(grid_cache.getNumberLoads(), 1);
+
+    // a map written after it was cached is loaded again
+    filesystem::last_write_time(map_file_path, filesystem::last_write_time(map_file_path) + chrono::seconds(1));
+    auto changed_grid = grid_cache.getGrid(map_file_path.string());
+    ASSERT_NE(changed_grid, grid);
+    ASSERT_EQ(changed_grid->solveMaze(), grid->solveMaze());
+    ASSERT_EQ(grid_cache.getNumberGrids(), 1);
+
+    // the least recently used grid is evicted
+    ASSERT_NE(grid_cache.getGrid("maps/room_maze_1.txt"), nullptr);
+    ASSERT_EQ(grid_cache.getGrid(map_file_path.string()), changed_grid);
+    ASSERT_NE(grid_cache.getGrid("maps/room_maze_2.txt"), nullptr);
+    ASSERT_EQ(grid_cache.getNumberGrids(), 2);
+    ASSERT_EQ(grid_cache.getGrid(map_file_path.string()), changed_grid);
+    ASSERT_EQ(grid_cache.getNumberLoads(), 4);
+    grid_cache.getGrid("maps/room_maze_1.txt");
+    ASSERT_EQ(grid_cache.getNumberLoads(), 5);
+
+    // maps that can not be loaded are not kept
+    ofstream invalid_map_file_handler(map_file_path);
+    invalid_map_file_handler << "10x\n011\n";
+    invalid_map_file_handler.close();
+    maze::grid::GridCache invalid_grid_cache;
+    ASSERT_EQ(invalid_grid_cache.getGrid(map_file_path.string()), nullptr);
+    ASSERT_EQ(invalid_grid_cache.getGrid("maps/no_such_map.txt"), nullptr);
+    ASSERT_EQ(invalid_grid_cache.getNumberGrids(), 0);
+    filesystem::remove(map_file_path);
+}
+
+// Test that the solver server answers requests directly and over its socket
+TEST(GridTest, SolverServer1)
+{
+    maze::grid::ServerOptions options;
+    options.socket_path = (filesystem::temp_directory_path() / ("maze_test_" + to_string(getpid()) + ".sock")).string();
+    options.number_threads = 2;
+    options.path_format = maze::grid::PathFormat::RLE;
+    maze::grid::SolverServer server(options);
+
+    ostringstream response_stream;
+    server.answerRequest("maps/room_maze_4.txt 5", response_stream);
+    server.answerRequest("maps/room_maze_4.txt 1 0 5 4", response_stream);
+    server.answerRequest("maps/multiple_rows.txt 1", response_stream);
+    server.answerRequest("maps/room_maze_4.txt 1 0 0 0", response_stream);
+    server.answerRequest("maps/room_maze_4.txt 6", response_stream);
+    server.answerRequest("maps/room_maze_4.txt 1 x", response_stream);
+    server.answerRequest("maps/no_such_map.txt 5", response_stream);
+    ASSERT_EQ(response_stream.str(), "1 0 R4D4\n1 0 R4D4\n0 0 \nNo path found or an error occured.\nerror Invalid user story.\nerror Invalid request.\nerror Could not load map.\n");
+    ASSERT_EQ(server.getGridCache().getNumberLoads(), 2);
+
+    thread server_thread([&]()
+    {
+        server.run();
+    });
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(socket_fd, 0);
+    bool is_connected = false;
+    for(int attempt = 0; attempt < 200 && !is_connected; attempt++)
+    {
+        is_connected = connect(socket_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if(!is_connected)
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    }
+    ASSERT_TRUE(is_connected);
+
+    // the last request has no line break and is answered when the client
+    // stops writing
+    string requests = "maps/room_maze_4.txt 5\n\nmaps/room_maze_4.txt 1 0 5 4";
+    ASSERT_EQ(send(socket_fd, requests.data(), requests.size(), 0), static_cast<ssize_t>(requests.size()));
+    shutdown(socket_fd, SHUT_WR);
+
+    string responses;
+    char buffer[256];
+    for(ssize_t received_size; (received_size = recv(socket_fd, buffer, sizeof(buffer), 0)) > 0;)
+    {
+        responses.append(buffer, received_size);
+    }
+    close(socket_fd);
+    ASSERT_EQ(responses, "1 0 R4D4\n1 0 R4D4\n");
+    ASSERT_EQ(server.getGridCache().getNumberHits(), 4);
+
+    server.stop();
+    server_thread.join();
+    ASSERT_FALSE(filesystem::exists(options.socket_path));
+}
+
 int main(int ac, char* av[]) {
     testing::InitGoogleTest(&ac, av);    
     return RUN_ALL_TESTS();
@@ -0,0 +1,81 @@
+// Copyright (C) 2023 Ashish Kumar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program in the file: gpl-3.0.text. 
+// If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef MAZE_TEST_UTILS_H
+#define MAZE_TEST_UTILS_H
+
+// stl includes
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// project includes
+#include "maze.hpp"
+
+// isValidPath function that checks that a path only moves between adjacent free cells
+inline bool isValidPath(maze::grid::GridMap const& grid_map, std::vector<std::pair<int, int>> const& path)
+{
+    for(std::size_t path_index = 0; path_index < path.size(); path_index++)
+    {
+        if(!grid_map.isFree(path[path_index].first, path[path_index].second))
+        {
+            return false;
+        }
+        else if(path_index > 0 && std::abs(path[path_index].first - path[path_index - 1].first) + std::abs(path[path_index].second - path[path_index - 1].second) != 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// getFreeCells function that returns the free cells of a grid map in row major order
+inline std::vector<std::pair<int, int>> getFreeCells(maze::grid::GridMap const& grid_map)
+{
+    std::vector<std::pair<int, int>> free_cells;
+    for(int row_index = 0; row_index < grid_map.getNumberRows(); row_index++)
+    {
+        for(int col_index = 0; col_index < grid_map.getNumberCols(); col_index++)
+        {
+            if(grid_map.isFree(row_index, col_index))
+            {
+                free_cells.push_back(std::make_pair(row_index, col_index));
+            }
+        }
+    }
+
+    return free_cells;
+}
+
+// samplePathQueries function that returns a fixed spread of start and end
+// cells among the free cells of a grid map, the same on every run
+inline std::vector<maze::grid::PathQuery> samplePathQueries(maze::grid::GridMap const& grid_map, const int& number_queries)
+{
+    auto free_cells = getFreeCells(grid_map);
+    std::vector<maze::grid::PathQuery> queries;
+    for(std::size_t query_index = 0; query_index < static_cast<std::size_t>(number_queries) && !free_cells.empty(); query_index++)
+    {
+        maze::grid::PathQuery query;
+        query.start_cell = free_cells[(query_index * 7919) % free_cells.size()];
+        query.end_cell = free_cells[(query_index * 104729 + 13) % free_cells.size()];
+        queries.push_back(query);
+    }
+
+    return queries;
+}
+
+#endif /* MAZE_TEST_UTILS_H */